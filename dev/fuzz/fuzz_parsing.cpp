@@ -0,0 +1,247 @@
+/*
+ * Fuzz target for the Python-free C++ parsing core.
+ *
+ * Every input is run through the same sequence of kernels that
+ * CharacterParser uses to classify and convert a string, so both
+ * crashes (under a sanitizer) and pathological running times in the
+ * core are exposed. The input is always copied into an exactly-sized
+ * heap buffer with no trailing nul, so reading past the end is caught.
+ *
+ * libFuzzer (clang):
+ *
+ *   clang++ -std=c++17 -O1 -g -fsanitize=fuzzer,address,undefined -Iinclude \
+ *       dev/fuzz/fuzz_parsing.cpp src/cpp/c_str_parsing.cpp -o fuzz_parsing
+ *   ./fuzz_parsing dev/fuzz/corpus
+ *
+ * Standalone latency mode (any compiler, no libFuzzer needed):
+ *
+ *   g++ -std=c++17 -O2 -DFN_FUZZ_STANDALONE -Iinclude \
+ *       dev/fuzz/fuzz_parsing.cpp src/cpp/c_str_parsing.cpp -o fuzz_parsing
+ *   ./fuzz_parsing dev/fuzz/corpus
+ *
+ * In standalone mode each input is timed, then grown by repeating its
+ * longest periodic run so it is 2x, 4x, ... 16x longer, and the growth of
+ * the time per call is compared to the growth of the input. Inputs whose
+ * time grows faster than linearly are reported and the exit status is 1.
+ */
+
+#include "fastnumbers/c_str_parsing.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/// Run the parsing kernels on the string between str and end
+static void exercise(const char* str, const char* end)
+{
+    // Trim whitespace and a sign, as CharacterParser does.
+    consume_whitespace(str, end);
+    while (str != end && is_whitespace(*(end - 1))) {
+        end -= 1;
+    }
+    if (str != end && is_sign(*str)) {
+        str += 1;
+    }
+    const std::size_t len = static_cast<std::size_t>(end - str);
+
+    // Classification, for each way a base can be given.
+    for (const int base : { 10, 0, 2, 16, 36 }) {
+        const StringChecker checker(str, end, base);
+        static_cast<void>(checker.get_type());
+        static_cast<void>(checker.digit_length());
+    }
+    static_cast<void>(detect_base(str, end));
+    static_cast<void>(has_base_prefix(str, len));
+    static_cast<void>(quick_detect_infinity(str, len));
+    static_cast<void>(quick_detect_nan(str, len));
+    static_cast<void>(is_likely_int(str, len));
+
+    // Conversion.
+    bool error = false;
+    bool overflow = false;
+    static_cast<void>(parse_int<int64_t>(str, end, 10, error, overflow));
+    static_cast<void>(parse_int<int64_t>(str, end, 0, error, overflow, true));
+    static_cast<void>(parse_int<uint8_t>(str, end, 10, error, overflow));
+    static_cast<void>(parse_int<uint64_t>(str, end, 16, error, overflow));
+    static_cast<void>(parse_float<double>(str, end, error));
+    static_cast<void>(parse_float<float>(str, end, error));
+    static_cast<void>(parse_hex_float<double>(str, end, error, overflow));
+    static_cast<void>(parse_hex_float<float>(str, end, error, overflow));
+    RationalParts parts;
+    if (read_rational(str, end, parts)) {
+        double dvalue;
+        float fvalue;
+        static_cast<void>(rational_to_float(parts, dvalue, error));
+        static_cast<void>(rational_to_float(parts, fvalue, error));
+    }
+
+    // Underscore removal modifies the string, so operate on a copy.
+    if (len > 0) {
+        const std::unique_ptr<char[]> copy(new char[len]);
+        std::memcpy(copy.get(), str, len);
+        for (const bool based : { false, true }) {
+            const char* new_end = copy.get() + len;
+            remove_valid_underscores(copy.get(), new_end, based);
+            const StringChecker checker(copy.get(), new_end, based ? 0 : 10);
+            static_cast<void>(checker.get_type());
+        }
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size)
+{
+    // Copy so that the buffer ends exactly where the input ends.
+    const std::unique_ptr<char[]> buffer(new char[size]);
+    if (size > 0) {
+        std::memcpy(buffer.get(), data, size);
+    }
+    exercise(buffer.get(), buffer.get() + size);
+    return 0;
+}
+
+#ifdef FN_FUZZ_STANDALONE
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Largest input growth factor in the scaling check
+constexpr std::size_t MAX_SCALE = 16;
+
+/// Time growth (relative to input growth) above which input is flagged
+constexpr double SUPERLINEAR_EXPONENT = 1.5;
+
+/// Minimum wall time per measurement, in seconds
+constexpr double MIN_MEASURE_TIME = 0.02;
+
+/// Longest repeating unit considered when growing an input
+constexpr std::size_t MAX_PERIOD = 32;
+
+/**
+ * \brief Make a copy of the input with its longest periodic run extended
+ *        so that the whole input is about "factor" times longer
+ *
+ * A periodic run is a stretch like "0000", "_1_1_1" or a sequence of
+ * multi-byte digits, and it is extended by repeating its unit, so that
+ * the grown input is still the "same kind" of input, just longer.
+ * Inputs with no run repeat their last character.
+ */
+std::string grow(const std::string& input, const std::size_t factor)
+{
+    if (input.empty()) {
+        return input;
+    }
+
+    // Find the longest stretch where every character matches the one
+    // "period" characters before it. Shorter periods win ties.
+    std::size_t best_end = input.size(), best_period = 1, best_len = 0;
+    for (std::size_t period = 1; period <= MAX_PERIOD && period < input.size(); ++period) {
+        std::size_t run = 0;
+        for (std::size_t i = period; i < input.size(); ++i) {
+            run = input[i] == input[i - period] ? run + 1 : 0;
+            if (run > best_len) {
+                best_len = run;
+                best_end = i + 1;
+                best_period = period;
+            }
+        }
+    }
+
+    // Insert whole units at the end of the run.
+    const std::string unit = input.substr(best_end - best_period, best_period);
+    const std::size_t copies = (factor - 1) * input.size() / best_period;
+    std::string grown = input.substr(0, best_end);
+    for (std::size_t i = 0; i < copies; ++i) {
+        grown += unit;
+    }
+    return grown + input.substr(best_end);
+}
+
+/// Return the time of one call of the fuzz target on the input, in seconds
+double time_per_call(const std::string& input)
+{
+    using clock = std::chrono::steady_clock;
+    const auto* data = reinterpret_cast<const uint8_t*>(input.data());
+    std::size_t calls = 1;
+    while (true) {
+        const auto start = clock::now();
+        for (std::size_t i = 0; i < calls; ++i) {
+            LLVMFuzzerTestOneInput(data, input.size());
+        }
+        const std::chrono::duration<double> elapsed = clock::now() - start;
+        if (elapsed.count() >= MIN_MEASURE_TIME) {
+            return elapsed.count() / static_cast<double>(calls);
+        }
+        calls *= 2;
+    }
+}
+
+/// Time an input at increasing sizes, returning true if it scales superlinearly
+bool check_scaling(const std::string& name, const std::string& input)
+{
+    const double base_time = time_per_call(input);
+    double worst_exponent = 0.0;
+    for (std::size_t factor = 2; factor <= MAX_SCALE; factor *= 2) {
+        const std::string grown = grow(input, factor);
+        const double ratio = time_per_call(grown) / base_time;
+        const double size_ratio = static_cast<double>(grown.size())
+            / static_cast<double>(std::max(input.size(), std::size_t(1)));
+        if (size_ratio > 1.0) {
+            worst_exponent = std::max(worst_exponent, std::log(ratio) / std::log(size_ratio));
+        }
+    }
+    const bool flagged = worst_exponent > SUPERLINEAR_EXPONENT;
+    std::printf(
+        "%-40s %8zu bytes %12.1f ns/call  growth exponent %5.2f%s\n",
+        name.c_str(),
+        input.size(),
+        base_time * 1e9,
+        worst_exponent,
+        flagged ? "  <-- SUPERLINEAR" : ""
+    );
+    return flagged;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::filesystem::path> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::filesystem::path arg(argv[i]);
+        if (std::filesystem::is_directory(arg)) {
+            for (const auto& entry : std::filesystem::directory_iterator(arg)) {
+                paths.push_back(entry.path());
+            }
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    if (paths.empty()) {
+        std::fprintf(stderr, "usage: %s <file-or-directory>...\n", argv[0]);
+        return 2;
+    }
+
+    int status = 0;
+    for (const auto& path : paths) {
+        std::ifstream stream(path, std::ios::binary);
+        const std::string input(
+            (std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>()
+        );
+        if (check_scaling(path.filename().string(), input)) {
+            status = 1;
+        }
+    }
+    return status;
+}
+
+#endif
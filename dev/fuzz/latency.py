@@ -0,0 +1,237 @@
+#! /usr/bin/env python3
+"""
+Latency fuzzing for the full fastnumbers conversion pipeline.
+
+Each input in the corpus (and optionally random mutations of them) is run
+through every public conversion function, including the slower paths like
+denoise=True and array population. Each input is timed, then grown by
+repeating its longest periodic run so it is 2x, 4x, ... 16x longer, and the
+growth of the time per call is compared to the growth of the input.
+
+An input is reported if
+  - its time grows faster than linearly with its length,
+  - a single call takes longer than --max-call-time, or
+  - the measurement does not finish within --timeout (i.e. it hangs).
+
+Every measurement runs in a subprocess so that a hang cannot stall the run.
+The exit status is 1 if anything was reported.
+
+    python dev/fuzz/latency.py                     # the seed corpus
+    python dev/fuzz/latency.py --mutations 200     # plus random mutations
+    python dev/fuzz/latency.py my_input.txt        # specific inputs
+"""
+
+from __future__ import annotations
+
+import argparse
+import array
+import json
+import math
+import pathlib
+import random
+import subprocess
+import sys
+import time
+from typing import Callable
+
+import fastnumbers as fn
+
+HERE = pathlib.Path(__file__).resolve().parent
+
+# Largest input growth factor in the scaling check.
+MAX_SCALE = 16
+
+# Time growth (relative to input growth) above which input is flagged.
+SUPERLINEAR_EXPONENT = 1.5
+
+# Minimum wall time per measurement, in seconds.
+MIN_MEASURE_TIME = 0.02
+
+# Longest repeating unit considered when growing an input.
+MAX_PERIOD = 32
+
+
+def _to_array(value: str, typecode: str) -> array.array:
+    """Convert a single value into an array, tolerating all errors."""
+    output = array.array(typecode, [0])
+    fn.try_array([value], output, on_fail=0, on_overflow=0, on_type_error=0)
+    return output
+
+
+# The conversions to time, by name.
+FUNCTIONS: dict[str, Callable[[str], object]] = {
+    "try_real": fn.try_real,
+    "try_real(denoise)": lambda x: fn.try_real(x, denoise=True),
+    "try_float": fn.try_float,
+    "try_float(hex)": lambda x: fn.try_float(x, allow_hex_float=True),
+    "try_float(fraction)": lambda x: fn.try_float(x, allow_fraction=True),
+    "try_fraction": fn.try_fraction,
+    "try_decimal": fn.try_decimal,
+    "try_int": fn.try_int,
+    "try_int(base=0)": lambda x: fn.try_int(x, base=0),
+    "try_forceint": fn.try_forceint,
+    "try_forceint(denoise)": lambda x: fn.try_forceint(x, denoise=True),
+    "check_intlike": fn.check_intlike,
+    "query_type": fn.query_type,
+    "try_array(d)": lambda x: _to_array(x, "d"),
+    "try_array(q)": lambda x: _to_array(x, "q"),
+}
+
+
+def grow(text: str, factor: int) -> str:
+    """
+    Make a copy of the input with its longest periodic run extended
+    so that the whole input is about "factor" times longer.
+
+    This is the same algorithm as used in fuzz_parsing.cpp.
+    """
+    if not text:
+        return text
+    best_end, best_period, best_len = len(text), 1, 0
+    for period in range(1, min(MAX_PERIOD, len(text) - 1) + 1):
+        run = 0
+        for i in range(period, len(text)):
+            run = run + 1 if text[i] == text[i - period] else 0
+            if run > best_len:
+                best_end, best_period, best_len = i + 1, period, run
+    unit = text[best_end - best_period : best_end]
+    copies = (factor - 1) * len(text) // best_period
+    return text[:best_end] + unit * copies + text[best_end:]
+
+
+def time_per_call(func: Callable[[str], object], text: str) -> float:
+    """Return the time of one call of the function on the input, in seconds."""
+    calls = 1
+    while True:
+        start = time.perf_counter()
+        for _ in range(calls):
+            func(text)
+        elapsed = time.perf_counter() - start
+        if elapsed >= MIN_MEASURE_TIME:
+            return elapsed / calls
+        calls *= 2
+
+
+def measure(name: str, text: str) -> dict[str, float]:
+    """Time the named function on the input at increasing sizes."""
+    func = FUNCTIONS[name]
+    base_time = time_per_call(func, text)
+    worst_exponent = 0.0
+    factor = 2
+    while factor <= MAX_SCALE:
+        grown = grow(text, factor)
+        ratio = time_per_call(func, grown) / base_time
+        size_ratio = len(grown) / max(len(text), 1)
+        if size_ratio > 1:
+            worst_exponent = max(worst_exponent, math.log(ratio) / math.log(size_ratio))
+        factor *= 2
+    return {"time": base_time, "exponent": worst_exponent}
+
+
+def mutate(rng: random.Random, text: str) -> str:
+    """Randomly mutate the input in ways likely to reach new parser states."""
+    pieces = "0123456789_.eE+-xXoObBjJ/ \t٠١٢"
+    chars = list(text) or ["0"]
+    for _ in range(rng.randint(1, 4)):
+        i = rng.randrange(len(chars))
+        choice = rng.random()
+        if choice < 0.3:
+            chars.insert(i, rng.choice(pieces))
+        elif choice < 0.5 and len(chars) > 1:
+            del chars[i]
+        elif choice < 0.8:
+            chars[i] = rng.choice(pieces)
+        else:
+            j = rng.randrange(i, len(chars)) + 1
+            chars[i:i] = chars[i:j] * rng.randint(2, 64)
+    return "".join(chars)
+
+
+def run_one(name: str, label: str, text: str, args: argparse.Namespace) -> bool:
+    """Measure one function on one input in a subprocess, and report it."""
+    command = [sys.executable, __file__, "--worker", name]
+    try:
+        result = subprocess.run(
+            command,
+            input=text.encode("utf-8", "surrogatepass"),
+            capture_output=True,
+            timeout=args.timeout,
+            check=True,
+        )
+    except subprocess.TimeoutExpired:
+        print(f"{label:40} {name:24} TIMED OUT after {args.timeout} s  <-- HANG")
+        return True
+    except subprocess.CalledProcessError as e:
+        print(f"{label:40} {name:24} CRASHED\n{e.stderr.decode()}")
+        return True
+
+    data = json.loads(result.stdout)
+    flags = []
+    if data["exponent"] > SUPERLINEAR_EXPONENT:
+        flags.append("SUPERLINEAR")
+    if data["time"] > args.max_call_time:
+        flags.append("SLOW")
+    if flags or args.verbose:
+        print(
+            f"{label:40} {name:24} {data['time'] * 1e9:12.1f} ns/call  "
+            f"growth exponent {data['exponent']:5.2f}"
+            + (f"  <-- {', '.join(flags)}" if flags else "")
+        )
+    return bool(flags)
+
+
+def main() -> int:
+    """Run the latency fuzzer."""
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument(
+        "inputs",
+        nargs="*",
+        type=pathlib.Path,
+        default=[HERE / "corpus"],
+        help="Files or directories of inputs (default: the seed corpus)",
+    )
+    parser.add_argument(
+        "--mutations", type=int, default=0, help="Random mutations to also test"
+    )
+    parser.add_argument("--seed", type=int, default=0, help="Random seed")
+    parser.add_argument(
+        "--timeout", type=float, default=10.0, help="Seconds before a hang is declared"
+    )
+    parser.add_argument(
+        "--max-call-time",
+        type=float,
+        default=1e-3,
+        help="Seconds above which a single call is reported",
+    )
+    parser.add_argument(
+        "-f", "--function", action="append", choices=FUNCTIONS, help="Only these"
+    )
+    parser.add_argument("-v", "--verbose", action="store_true", help="Report all")
+    parser.add_argument("--worker", help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    # In a worker, measure the input from stdin and report as JSON.
+    if args.worker:
+        text = sys.stdin.buffer.read().decode("utf-8", "surrogatepass")
+        print(json.dumps(measure(args.worker, text)))
+        return 0
+
+    paths: list[pathlib.Path] = []
+    for path in args.inputs:
+        paths.extend(sorted(path.iterdir()) if path.is_dir() else [path])
+    cases = [(p.name, p.read_bytes().decode("utf-8", "surrogatepass")) for p in paths]
+
+    rng = random.Random(args.seed)
+    seeds = [text for _, text in cases]
+    for i in range(args.mutations):
+        cases.append((f"mutation-{i}", mutate(rng, rng.choice(seeds))))
+
+    flagged = False
+    for label, text in cases:
+        for name in args.function or FUNCTIONS:
+            flagged |= run_one(name, label, text, args)
+    return int(flagged)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,90 @@
+#! /usr/bin/env python3
+"""
+Training workload for a profile-guided optimization (PGO) build.
+
+This is run by setup.py against the instrumented extension module when
+FN_PGO is set. It loads the extension directly from the path given on
+the command line (so neither the package nor numpy need be importable)
+and exercises the same inputs that are timed in profiling/profile.py.
+"""
+
+from __future__ import annotations
+
+import array
+import contextlib
+import importlib.util
+import sys
+from types import ModuleType
+
+# The same corpus as Timer.THINGS_TO_TIME in profiling/profile.py,
+# plus a few inputs that exercise the less common branches.
+CORPUS = (
+    "not_a_number",
+    "-4",
+    "-41053",
+    "358924829458",
+    "35892482945872302493947939485729",
+    "-4.1",
+    "-41053.543034e34",
+    "-41053.543028758302e256",
+    -41053,
+    -41053.543028758302e100,
+    "  +12  ",
+    "1_000_000",
+    "inf",
+    "nan",
+    "4.0",
+    "٤",
+    b"-42",
+    None,
+)
+
+# How many times to run each input through each function.
+REPEAT = 2000
+
+
+def load_extension(path: str) -> ModuleType:
+    """Load the extension module at the given path."""
+    spec = importlib.util.spec_from_file_location("fastnumbers", path)
+    if spec is None or spec.loader is None:
+        msg = f"Cannot load extension module from {path}"
+        raise ImportError(msg)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def train(fn: ModuleType) -> None:
+    """Run the workload against the given extension module."""
+    scalar_funcs = (
+        fn.try_real,
+        fn.try_float,
+        fn.try_int,
+        fn.try_forceint,
+        fn.check_real,
+        fn.check_float,
+        fn.check_int,
+        fn.check_intlike,
+        fn.query_type,
+    )
+    for func in scalar_funcs:
+        for value in CORPUS:
+            for _ in range(REPEAT):
+                with contextlib.suppress(TypeError):
+                    func(value)
+
+    # Iteration and array population are the bulk workloads.
+    data = [x for x in CORPUS if isinstance(x, str)] * REPEAT
+    numeric = [x for x in data if fn.check_float(x)]
+    integral = [x for x in data if fn.check_int(x)]
+    fn.try_real(data, map=list)
+    fn.try_float(data, map=list)
+    list(fn.try_int(data, map=True))
+    fn.try_forceint(data, map=list, denoise=True)
+    fn.array(numeric, array.array("d", [0.0]) * len(numeric))
+    fn.array(integral, array.array("q", [0]) * len(integral), on_overflow=0)
+    fn.array(data, array.array("d", [0.0]) * len(data), on_fail=-1.0)
+
+
+if __name__ == "__main__":
+    train(load_extension(sys.argv[1]))
@@ -18,7 +18,7 @@
  * argument clinic.
  */
 
-#define FN_MAX_KWARGS 15
+#define FN_MAX_KWARGS 20
 
 typedef struct {
     int npositional;
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * \class BinEdges
+ * \brief Locate numbers among sorted bin edges, like numpy.digitize
+ *
+ * With n edges there are n + 2 bins. Bin i (for 0 <= i <= n) holds the
+ * values between edge i - 1 and edge i, where a value equal to an edge
+ * belongs to the bin above it, or to the bin below it if "right" is true.
+ * The last bin holds NaN, i.e. the values that cannot be placed.
+ *
+ * A few edges are compared with the value all at once in a branch-free
+ * loop that the compiler can vectorize, and more are searched with a
+ * branch-free binary search, so that the time does not depend on how
+ * predictable the bins of the values are.
+ */
+class BinEdges {
+public:
+    /**
+     * \brief Construct from the edges
+     * \param edges The edges, which must be sorted in increasing order
+     * \param right Whether or not a value equal to an edge belongs below it
+     */
+    BinEdges(std::vector<double> edges, const bool right) noexcept
+        : m_edges(std::move(edges))
+        , m_right(right)
+    { }
+
+    /// The number of bins, including the bin for NaN
+    std::size_t bins() const noexcept { return m_edges.size() + 2; }
+
+    /// Return the bin of a value
+    std::size_t locate(const double value) const noexcept
+    {
+        if (std::isnan(value)) {
+            return m_edges.size() + 1;
+        }
+        return m_right ? count_below<true>(value) : count_below<false>(value);
+    }
+
+private:
+    /// The edges, in increasing order
+    std::vector<double> m_edges;
+
+    /// Whether or not a value equal to an edge belongs below it
+    bool m_right;
+
+    /// The most edges for which all are compared instead of searched
+    static constexpr std::size_t LINEAR_SEARCH_SIZE = 16;
+
+    /// Is the edge below the value, so that the value is in a higher bin?
+    template <bool RIGHT>
+    static bool below(const double edge, const double value) noexcept
+    {
+        return RIGHT ? edge < value : edge <= value;
+    }
+
+    /// Count the edges that are below the value, which is its bin
+    template <bool RIGHT>
+    std::size_t count_below(const double value) const noexcept
+    {
+        const double* edges = m_edges.data();
+        std::size_t length = m_edges.size();
+        if (length <= LINEAR_SEARCH_SIZE) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < length; ++i) {
+                count += static_cast<std::size_t>(below<RIGHT>(edges[i], value));
+            }
+            return count;
+        }
+
+        // Halve the range until one edge is left, without branching on
+        // the result of the comparison
+        const double* base = edges;
+        while (length > 1) {
+            const std::size_t half = length / 2;
+            base = below<RIGHT>(base[half], value) ? base + half : base;
+            length -= half;
+        }
+        return static_cast<std::size_t>(base - edges)
+            + static_cast<std::size_t>(below<RIGHT>(*base, value));
+    }
+};
@@ -4,6 +4,7 @@
 #include <limits>
 
 #include "fastnumbers/c_str_parsing.hpp"
+#include "fastnumbers/tracing.hpp"
 
 /**
  * \class Buffer
@@ -66,6 +67,21 @@ public:
         reserve();
     }
 
+    /// Set aside a fixed length of data, keeping the data already present
+    void extend(const std::size_t needed_length) noexcept(false)
+    {
+        if (needed_length > m_size
+            && (m_buffer != m_fixed_buffer || needed_length >= FIXED_BUFFER_SIZE)) {
+            FN_TRACE1(buffer__heap_alloc, needed_length);
+            char* data = new char[needed_length];
+            std::memcpy(data, m_buffer, m_len);
+            delete[] m_variable_buffer;
+            m_variable_buffer = m_buffer = data;
+            m_size = needed_length;
+        }
+        m_len = needed_length;
+    }
+
     /// Copy a fixed length of data into the buffer
     void copy(const char* data, const std::size_t needed_length) noexcept(false)
     {
@@ -166,6 +182,7 @@ private:
             if (m_size < FIXED_BUFFER_SIZE) {
                 m_buffer = m_fixed_buffer;
             } else {
+                FN_TRACE1(buffer__heap_alloc, m_size);
                 delete[] m_variable_buffer;
                 m_variable_buffer = new char[m_size];
                 m_buffer = m_variable_buffer;
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <charconv>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <memory>
+#include <string>
 #include <system_error>
 #include <type_traits>
 #include <vector>
 
+#include "fastnumbers/cpu_dispatch.hpp"
 #include "fastnumbers/third_party/fast_float.h"
 
 /// Table of what characters are classified as whitespace
@@ -63,6 +67,131 @@ enum class StringType {
     INTLIKE_FLOAT, ///< Contains an integer-like float
 };
 
+/**
+ * \struct Suffix
+ * \brief A unit suffix and the multiplier it stands for
+ *
+ * The multiplier is factor ** repeat * 10 ** power10, which represents
+ * the SI, IEC and percent multipliers as well as any multiplier with at
+ * most nine significant digits exactly.
+ */
+struct Suffix {
+    /// The text of the suffix, e.g. "k" or "GiB"
+    std::string text;
+
+    /// The non-decimal part of the multiplier
+    uint32_t factor = 1;
+
+    /// How many times to multiply by the factor
+    uint32_t repeat = 0;
+
+    /// The decimal exponent of the multiplier
+    int32_t power10 = 0;
+};
+
+/**
+ * \class SuffixTable
+ * \brief The unit suffixes that may follow a number in a string
+ */
+class SuffixTable {
+public:
+    /// Add a suffix, replacing any existing suffix with the same text
+    void add(const Suffix& suffix);
+
+    /// Are there any suffixes?
+    bool empty() const noexcept { return m_suffixes.empty(); }
+
+    /**
+     * \brief Find the longest suffix at the end of a string
+     *
+     * At least one character must precede the suffix.
+     *
+     * \return The suffix, or nullptr if there is none
+     */
+    const Suffix* find(const char* str, const char* end) const noexcept;
+
+    /// The most a string can grow in length when scaled by a suffix
+    std::size_t max_growth() const noexcept { return m_max_growth; }
+
+private:
+    /// The suffixes, longest first
+    std::vector<Suffix> m_suffixes {};
+
+    /// Which characters end a suffix, to quickly rule out most strings
+    bool m_last_chars[256] = {};
+
+    /// The most a string can grow in length when scaled by a suffix
+    std::size_t m_max_growth = 0;
+};
+
+/**
+ * \struct NumberFormat
+ * \brief The locale-style characters used to write a number in a string
+ *
+ * The default is the format Python itself accepts.
+ */
+struct NumberFormat {
+    /// The character separating the integer and decimal parts
+    char decimal_point = '.';
+
+    /// The character grouping integer digits by thousands, or '\0' for none
+    char thousands = '\0';
+
+    /// Whether a number in parentheses is negative, e.g. "(1,234.50)"
+    bool accounting = false;
+
+    /// The unit suffixes that may follow a number, or nullptr for none
+    std::shared_ptr<const SuffixTable> suffixes {};
+
+    /// Does this format differ from the format Python accepts?
+    bool is_custom() const noexcept
+    {
+        return decimal_point != '.' || thousands != '\0' || accounting
+            || suffixes != nullptr;
+    }
+
+    /// The most a string can grow in length when rewritten to Python's format
+    std::size_t max_growth() const noexcept
+    {
+        return suffixes == nullptr ? 0 : suffixes->max_growth();
+    }
+};
+
+/**
+ * \struct RationalParts
+ * \brief The digits of a rational number "[whole ]numerator/denominator"
+ *
+ * Each part is a span of decimal digits. If there is no whole part,
+ * whole and whole_end are equal.
+ */
+struct RationalParts {
+    /// The start of the digits of the whole part
+    const char* whole = nullptr;
+
+    /// The end of the digits of the whole part
+    const char* whole_end = nullptr;
+
+    /// The start of the digits of the numerator
+    const char* numerator = nullptr;
+
+    /// The end of the digits of the numerator
+    const char* numerator_end = nullptr;
+
+    /// The start of the digits of the denominator
+    const char* denominator = nullptr;
+
+    /// The end of the digits of the denominator
+    const char* denominator_end = nullptr;
+
+    /// Is the number zero, because the whole part and numerator are all zeros?
+    bool is_zero() const noexcept
+    {
+        const auto zero = [](const char c) { return c == '0'; };
+        return std::all_of(whole, whole_end, zero)
+            && std::all_of(numerator, numerator_end, zero);
+    }
+};
+
 /**
  * \class StringChecker
  * \brief Assess the type of number that is contained in a string
@@ -177,6 +306,9 @@ public:
     }
 
 private:
+    /// Scan the string and record the location of each number component
+    FN_MULTIVERSION void scan(const char* str, const char* end, int base) noexcept;
+
     /// Set the contained type.
     void set_type(StringType val) { m_contained_type = val; }
 
@@ -248,6 +380,94 @@ private:
  */
 void remove_valid_underscores(char* str, const char*& end, const bool based) noexcept;
 
+/**
+ * \brief Rewrite a number written in a locale-style format into Python's format
+ *
+ * Assumes the input can be modified. The rewritten number is never longer
+ * than the original, and leading and trailing whitespace is removed.
+ *
+ * Thousands separators are removed, but only if each is preceded by one to
+ * three digits (for the first) or exactly three digits (for the rest) and
+ * is followed by a group of exactly three digits, and only in the integer
+ * part of the number. The decimal point is replaced with '.', and a literal
+ * '.' is invalid if it is not the decimal point or thousands separator.
+ * For accounting formats, surrounding parentheses become a leading '-'.
+ *
+ * \param str The string to rewrite
+ * \param end Reference to the end of the string - after processing will
+ *            point to the new end of the string
+ * \param format The format in which the number is written
+ * \return false if the separators were not validly placed, otherwise true
+ */
+bool normalize_number_format(
+    char* str, const char*& end, const NumberFormat& format
+) noexcept;
+
+/**
+ * \brief Scale a number by the unit suffix that follows it
+ *
+ * Assumes the input can be modified, has been normalized with
+ * normalize_number_format(), and has room for table.max_growth()
+ * more characters past the end.
+ *
+ * If the string ends with a suffix in the table and the rest of it is
+ * a decimal number, the suffix is removed and the number is rewritten
+ * multiplied by the suffix's multiplier. The multiplication is done
+ * exactly on the decimal digits, so the result is an integer if the
+ * scaled value is integral (e.g. "1.5k" becomes "1500" and "45%" becomes
+ * "0.45"), and floats are rounded only once, when the result is parsed.
+ * If the number has an exponent, the exponent is adjusted instead of
+ * moving the decimal point. Any other string is left as-is.
+ *
+ * \param str The string to rewrite
+ * \param end Reference to the end of the string - after processing will
+ *            point to the new end of the string
+ * \param table The suffixes that are allowed
+ */
+void apply_suffix(char* str, const char*& end, const SuffixTable& table) noexcept;
+
+/**
+ * \brief Read the mantissa and binary exponent of a hexadecimal float
+ *
+ * The grammar is that of float.fromhex(), with a required prefix:
+ * "0x" or "0X", hex digits with an optional '.', and an optional
+ * exponent of 'p' or 'P', an optional sign, and decimal digits. There
+ * must be at least one hex digit, and the sign must already be removed.
+ *
+ * The value is mantissa * 2**exponent. Only the leading 60 bits of
+ * the mantissa are kept, and if any non-zero digits were dropped
+ * inexact is set, so that the caller can round correctly.
+ *
+ * \param str The string to parse, assumed to be non-NULL
+ * \param end The end of the string being checked
+ * \param mantissa The leading bits of the mantissa
+ * \param exponent The power of two by which to scale the mantissa
+ * \param inexact Whether non-zero bits were dropped from the mantissa
+ * \return false if the string is not a hexadecimal float, otherwise true
+ */
+bool read_hex_float(
+    const char* str,
+    const char* end,
+    uint64_t& mantissa,
+    int64_t& exponent,
+    bool& inexact
+) noexcept;
+
+/**
+ * \brief Find the parts of a rational number such as "3/4" or "1 1/2"
+ *
+ * The grammar is decimal digits, optionally followed by whitespace and
+ * more digits (a whole part and a numerator), then '/' and digits for
+ * the denominator. There is no whitespace around the '/', and the sign
+ * must already be removed. A zero denominator is not checked for.
+ *
+ * \param str The string to parse, assumed to be non-NULL
+ * \param end The end of the string being checked
+ * \param parts The spans of the parts of the number
+ * \return false if the string is not a rational number, otherwise true
+ */
+bool read_rational(const char* str, const char* end, RationalParts& parts) noexcept;
+
 /**
  * \brief Lowercase a character - does no error checking
  */
@@ -339,6 +559,8 @@ constexpr inline void consume_digits(const char*& str, const char* end) noexcept
  */
 inline void consume_digits(const char*& str, const std::size_t len) noexcept
 {
+    const char* end = str + len;
+
     // Attempt to read eight characters at a time to determine
     // if they are digits. Loop over the character array in steps
     // of eight. Stop processing if not all eight characters are digits.
@@ -352,7 +574,7 @@ inline void consume_digits(const char*& str, const std::size_t len) noexcept
     }
 
     // Read the remainder of digits one-at-a-time.
-    consume_digits(str, str + len);
+    consume_digits(str, end);
 }
 
 /**
@@ -390,6 +612,14 @@ constexpr inline bool has_base_prefix(const char* str, const std::size_t len) no
     return len > 2 && str[0] == '0' && is_base_prefix(str[1]);
 }
 
+/**
+ * \brief Determine if a string begins with a hexadecimal prefix
+ */
+constexpr inline bool has_hex_prefix(const char* str, const std::size_t len) noexcept
+{
+    return len > 1 && str[0] == '0' && lowercase(str[1]) == 'x';
+}
+
 /**
  * \brief Detect if a string contains infinity
  *
@@ -454,6 +684,24 @@ constexpr inline bool quick_detect_nan(const char* str, const std::size_t len) n
     return accumulator == 0 || accumulator == 32;
 }
 
+/**
+ * \brief Detect if a string contains the signaling NaN of decimal.Decimal
+ *
+ * \param str The string to check, assumed to be non-NULL
+ * \param len The length of the string
+ */
+constexpr inline bool
+quick_detect_signaling_nan(const char* str, const std::size_t len) noexcept
+{
+    if (len != 4) {
+        return false;
+    }
+    // Same case-insensitive check as quick_detect_nan, but for "snan"
+    const uint8_t accumulator
+        = (str[0] ^ 's') | (str[1] ^ 'n') | (str[2] ^ 'a') | (str[3] ^ 'n');
+    return accumulator == 0 || accumulator == 32;
+}
+
 /**
  * \brief Detect if a string probably contains an integer
  *
@@ -671,6 +919,41 @@ inline T parse_int(
     }
 }
 
+/**
+ * \brief Convert a string of decimal digits to an int type without validation
+ *
+ * This is for strings already known to be a valid base-10 integer
+ * with at most overflow_cutoff<T>() digits and an optional sign, so there
+ * is no classification and no error reporting. Other characters give an
+ * unspecified value, but nothing outside of the string is ever read.
+ *
+ * \param str The string to parse, assumed to be non-NULL
+ * \param end The end of the string being parsed
+ */
+template <typename T, typename std::enable_if_t<std::is_integral_v<T>, bool> = true>
+inline T parse_int_unchecked(const char* str, const char* end) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    const bool is_negative = str != end && *str == '-';
+    if (str != end && is_sign(*str)) {
+        str += 1;
+    }
+
+    // Unsigned arithmetic so that bad characters wrap instead of overflowing
+    U value = 0;
+    if constexpr (overflow_cutoff<T>() > 8) {
+        while (end - str >= 8) {
+            value = static_cast<U>(value * 100000000U)
+                + static_cast<U>(fast_float::parse_eight_digits_unrolled(str));
+            str += 8;
+        }
+    }
+    for (; str != end; ++str) {
+        value = static_cast<U>(value * 10U + static_cast<U>(*str - '0'));
+    }
+    return static_cast<T>(is_negative ? static_cast<U>(U(0) - value) : value);
+}
+
 /**
  * \brief Convert a string to a double type
  *
@@ -691,4 +974,260 @@ inline T parse_float(const char* str, const char* end, bool& error) noexcept
     const fast_float::from_chars_result res = fast_float::from_chars(str, end, value);
     error = !(res.ptr == end && res.ec == std::errc());
     return value;
-}
\ No newline at end of file
+}
+
+/**
+ * \brief Convert a hexadecimal string to a floating point type
+ *
+ * Follows the rules of float.fromhex() (see read_hex_float() for the
+ * grammar). The mantissa and exponent bits are assembled and rounded
+ * to nearest-even directly in the target type, so the conversion is
+ * exact and there is no double rounding for float.
+ *
+ * \param str The string to parse, assumed to be non-NULL
+ * \param end The end of the string being checked
+ * \param error Flag to indicate if there was a parsing error
+ * \param overflow Flag to indicate if the value is too large for the type
+ */
+template <
+    typename T,
+    typename std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
+inline T
+parse_hex_float(const char* str, const char* end, bool& error, bool& overflow) noexcept
+{
+    uint64_t mantissa;
+    int64_t exponent;
+    bool inexact;
+    error = !read_hex_float(str, end, mantissa, exponent, inexact);
+    overflow = false;
+    if (error || mantissa == 0) {
+        return static_cast<T>(0.0);
+    }
+
+    // Place the lowest kept bit so the result has the type's precision,
+    // or at the lowest subnormal bit for tiny values.
+    constexpr int64_t digits = std::numeric_limits<T>::digits;
+    constexpr int64_t min_lsb = std::numeric_limits<T>::min_exponent - digits;
+    constexpr int64_t max_exponent = std::numeric_limits<T>::max_exponent;
+    int64_t length = 0;
+    for (uint64_t m = mantissa; m != 0; m >>= 1) {
+        length += 1;
+    }
+    const int64_t top = exponent + length - 1;
+    if (top >= max_exponent) {
+        overflow = true;
+        return static_cast<T>(0.0);
+    }
+    const int64_t lsb = std::max(top - (digits - 1), min_lsb);
+
+    // Drop the bits below the lowest kept bit, rounding half to even.
+    const int64_t shift = lsb - exponent;
+    if (shift > length) {
+        return static_cast<T>(0.0);
+    } else if (shift > 0) {
+        const uint64_t half = uint64_t(1) << (shift - 1);
+        const uint64_t rest = shift == 64 ? mantissa : mantissa & ((half << 1) - 1);
+        uint64_t kept = shift == 64 ? 0 : mantissa >> shift;
+        if (rest > half || (rest == half && (inexact || (kept & 1)))) {
+            kept += 1;
+        }
+        mantissa = kept;
+        exponent = lsb;
+    }
+
+    // Rounding up can still carry into a value that is too large.
+    const T value = std::ldexp(static_cast<T>(mantissa), static_cast<int>(exponent));
+    if (std::isinf(value)) {
+        overflow = true;
+        return static_cast<T>(0.0);
+    }
+    return value;
+}
+
+/**
+ * \brief Check if a double is exactly halfway between two floats
+ *
+ * Such a double may have been rounded to get there, in which case
+ * narrowing it to float would round a second time.
+ */
+inline bool is_halfway_between_floats(const double value) noexcept
+{
+    constexpr int extra
+        = std::numeric_limits<double>::digits - std::numeric_limits<float>::digits;
+    constexpr uint64_t mask = (uint64_t(1) << extra) - 1;
+    constexpr uint64_t halfway = uint64_t(1) << (extra - 1);
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & mask) == halfway;
+}
+
+/**
+ * \brief Convert a rational number to a correctly rounded floating point type
+ *
+ * This is only done if the parts fit in a uint64_t and the integers
+ * whole * denominator + numerator and denominator are exact in a double,
+ * so that IEEE division rounds correctly. For float, a double quotient
+ * that is exactly halfway between two floats is moved toward the exact
+ * quotient first, so that it is not rounded twice in the same direction.
+ *
+ * \param parts The parts of the rational number, from read_rational()
+ * \param value The resulting value
+ * \param zero_division Set if the denominator is zero
+ * \return false if the integers were too large, otherwise true
+ */
+template <
+    typename T,
+    typename std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
+inline bool
+rational_to_float(const RationalParts& parts, T& value, bool& zero_division) noexcept
+{
+    constexpr uint64_t limit = uint64_t(1) << std::numeric_limits<double>::digits;
+    bool too_large = false;
+    const auto read = [&too_large](const char* start, const char* stop) -> uint64_t {
+        bool error = false;
+        bool overflow = false;
+        const uint64_t result = start == stop
+            ? 0
+            : parse_int<uint64_t>(start, stop, 10, error, overflow, true);
+        too_large |= error || overflow || result > limit;
+        return result;
+    };
+    const uint64_t whole = read(parts.whole, parts.whole_end);
+    const uint64_t numerator = read(parts.numerator, parts.numerator_end);
+    const uint64_t denominator = read(parts.denominator, parts.denominator_end);
+    zero_division = !too_large && denominator == 0;
+    if (too_large || zero_division || whole > (limit - numerator) / denominator) {
+        return false;
+    }
+
+    const double num = static_cast<double>(whole * denominator + numerator);
+    const double den = static_cast<double>(denominator);
+    double quotient = num / den;
+    if constexpr (std::is_same_v<T, float>) {
+        if (is_halfway_between_floats(quotient)) {
+            const double residual = std::fma(quotient, den, -num);
+            if (residual != 0.0) {
+                quotient = std::nextafter(
+                    quotient,
+                    residual > 0.0 ? 0.0 : std::numeric_limits<double>::infinity()
+                );
+            }
+        }
+    }
+    value = static_cast<T>(quotient);
+    return true;
+}
+
+/**
+ * \brief Convert the start of a string to a floating point type
+ *
+ * A leading '+' or '-' is allowed.
+ *
+ * \param str The string to parse, assumed to be non-NULL
+ * \param end The end of the string being checked
+ * \param value The parsed value
+ * \return The end of the parsed number, or str if there was none
+ */
+template <
+    typename T,
+    typename std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
+inline const char* parse_float_prefix(const char* str, const char* end, T& value) noexcept
+{
+    const char* start = (str != end && *str == '+') ? str + 1 : str;
+    if (start != str && start != end && *start == '-') {
+        return str;
+    }
+    const fast_float::from_chars_result res = fast_float::from_chars(start, end, value);
+
+    // Python does not accept the "nan(...)" form that fast_float does.
+    if (res.ec != std::errc() || *(res.ptr - 1) == ')') {
+        return str;
+    }
+    return res.ptr;
+}
+
+/**
+ * \brief Convert a string to a complex number with the rules of complex()
+ *
+ * The string may be surrounded by whitespace and then by parentheses.
+ * Inside, it is a real part, an imaginary part ending in 'j' or 'J', or
+ * a real part followed by a signed imaginary part, with no spaces. The
+ * digits of the imaginary part may be omitted, e.g. "1+j". Each part
+ * is parsed with the same parser as parse_float().
+ *
+ * \param str The string to parse, assumed to be non-NULL
+ * \param end The end of the string being checked
+ * \param real The real part of the parsed value
+ * \param imag The imaginary part of the parsed value
+ * \param error Flag to indicate if there was a parsing error
+ */
+template <
+    typename T,
+    typename std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
+inline void
+parse_complex(const char* str, const char* end, T& real, T& imag, bool& error) noexcept
+{
+    real = imag = static_cast<T>(0.0);
+    error = true;
+    const auto is_j = [](const char c) {
+        return c == 'j' || c == 'J';
+    };
+    const auto trim = [](const char*& first, const char*& last) {
+        consume_whitespace(first, last);
+        while (first != last && is_whitespace(*(last - 1))) {
+            last -= 1;
+        }
+    };
+
+    // Remove whitespace and matching parentheses.
+    trim(str, end);
+    if (str != end && *str == '(') {
+        if (end - str < 2 || *(end - 1) != ')') {
+            return;
+        }
+        str += 1;
+        end -= 1;
+        trim(str, end);
+    }
+
+    // With no leading number, this can only be a unit imaginary number.
+    T value = static_cast<T>(0.0);
+    const char* part_end = parse_float_prefix(str, end, value);
+    if (part_end == str) {
+        const bool negative = str != end && *str == '-';
+        if (str != end && is_sign(*str)) {
+            str += 1;
+        }
+        if (end - str == 1 && is_j(*str)) {
+            imag = static_cast<T>(negative ? -1.0 : 1.0);
+            error = false;
+        }
+        return;
+    }
+
+    // A number alone is real, and a number followed by 'j' is imaginary.
+    if (part_end == end) {
+        real = value;
+        error = false;
+        return;
+    } else if (end - part_end == 1 && is_j(*part_end)) {
+        imag = value;
+        error = false;
+        return;
+    } else if (!is_sign(*part_end)) {
+        return;
+    }
+
+    // Otherwise there is a real part followed by an imaginary part.
+    real = value;
+    str = part_end;
+    part_end = parse_float_prefix(str, end, value);
+    if (part_end == str) {
+        value = static_cast<T>(*str == '-' ? -1.0 : 1.0);
+        part_end += 1;
+    }
+    if (end - part_end == 1 && is_j(*part_end)) {
+        imag = value;
+        error = false;
+    }
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "fastnumbers/c_str_parsing.hpp"
+
+/**
+ * \class ColumnShape
+ * \brief Learn the shape of the strings in a column and parse strings
+ *        of that shape with a specialized kernel
+ *
+ * Real columns are very homogeneous, e.g. all prices written with "%.2f"
+ * or all integer IDs. The first SAMPLE_SIZE strings are only observed,
+ * and if they all are plain decimal numbers ("-123" or "-123.45") with the
+ * same number of fraction digits, that shape is locked in. Later strings
+ * are then parsed without the general grammar. The first string that does
+ * not match the shape permanently disables the kernel, and that string
+ * (and all after it) must be parsed with the general path.
+ *
+ * The kernel only accepts strings whose result it can compute exactly as
+ * the general path would, so the output is identical either way.
+ */
+class ColumnShape {
+public:
+    /// The number of strings that must agree before the kernel is used
+    static constexpr std::size_t SAMPLE_SIZE = 16;
+
+    /// Construct, optionally starting in the disabled state
+    explicit ColumnShape(const bool enabled = true) noexcept
+        : m_state(enabled ? State::SAMPLING : State::DISABLED)
+        , m_sampled(0)
+        , m_fraction_digits(0)
+    { }
+
+    /// Is there still a chance to use the kernel?
+    bool enabled() const noexcept { return m_state != State::DISABLED; }
+
+    /// Stop using the kernel, e.g. because a non-string was encountered
+    void disable() noexcept { m_state = State::DISABLED; }
+
+    /**
+     * \brief Parse a string with the kernel, or learn its shape while sampling
+     *
+     * \param str The start of the string
+     * \param end The end of the string
+     * \param value The parsed value, only set on success
+     * \return true if the value was parsed, false if the general path is needed
+     */
+    template <typename T>
+    bool parse(const char* str, const char* end, T& value) noexcept
+    {
+        if (m_state == State::ACTIVE) {
+            if (parse_shaped(str, end, value)) {
+                return true;
+            }
+            m_state = State::DISABLED;
+        } else if (m_state == State::SAMPLING) {
+            observe(str, end);
+            if (m_state == State::ACTIVE && !supports<T>()) {
+                m_state = State::DISABLED;
+            }
+        }
+        return false;
+    }
+
+private:
+    /// Where the shape detection stands
+    enum class State {
+        SAMPLING, ///< Still observing the first strings
+        ACTIVE, ///< All sampled strings agreed, the kernel is in use
+        DISABLED, ///< The general path must be used
+    };
+
+    /// Where the shape detection stands
+    State m_state;
+
+    /// The number of strings observed so far
+    std::size_t m_sampled;
+
+    /// The number of digits after the decimal point, or -1 if there is none
+    int m_fraction_digits;
+
+private:
+    /**
+     * \brief Measure the digits of a plain decimal number
+     *
+     * \param str The start of the string, advanced past the digits
+     * \param end The end of the string
+     * \return The number of digits found
+     */
+    static std::size_t skip_digits(const char*& str, const char* end) noexcept
+    {
+        const char* start = str;
+        while (end - str >= 8 && fast_float::is_made_of_eight_digits_fast(str)) {
+            str += 8;
+        }
+        while (str != end && is_valid_digit(*str)) {
+            str += 1;
+        }
+        return static_cast<std::size_t>(str - start);
+    }
+
+    /**
+     * \brief Split a string into the parts of "-123.45"
+     *
+     * \return The number of fraction digits, -1 with no decimal point,
+     *         or -2 if the string is not of this shape
+     */
+    static int fraction_digits(
+        const char* str, const char* end, std::size_t& int_digits
+    ) noexcept
+    {
+        if (str != end && *str == '-') {
+            str += 1;
+        }
+        int_digits = skip_digits(str, end);
+        if (int_digits == 0) {
+            return -2;
+        } else if (str == end) {
+            return -1;
+        } else if (*str != '.') {
+            return -2;
+        }
+        str += 1;
+        const std::size_t digits = skip_digits(str, end);
+        return digits == 0 || str != end || digits > 64 ? -2 : static_cast<int>(digits);
+    }
+
+    /// Learn from one sampled string
+    void observe(const char* str, const char* end) noexcept
+    {
+        std::size_t int_digits;
+        const int digits = fraction_digits(str, end, int_digits);
+        if (digits == -2 || (m_sampled > 0 && digits != m_fraction_digits)) {
+            m_state = State::DISABLED;
+            return;
+        }
+        m_fraction_digits = digits;
+        m_sampled += 1;
+        if (m_sampled == SAMPLE_SIZE) {
+            m_state = State::ACTIVE;
+        }
+    }
+
+    /// Can the learned shape be parsed into the given type?
+    template <typename T>
+    bool supports() const noexcept
+    {
+        if constexpr (std::is_integral_v<T>) {
+            return m_fraction_digits == -1;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return m_fraction_digits <= max_exact_power10<T>();
+        } else {
+            return false;
+        }
+    }
+
+    /// The largest power of ten exactly representable in the type
+    template <typename T>
+    static constexpr int max_exact_power10() noexcept
+    {
+        return std::numeric_limits<T>::digits >= 53 ? 22 : 10;
+    }
+
+    /// The most digits that always fit exactly in the mantissa of the type
+    template <typename T>
+    static constexpr std::size_t max_exact_digits() noexcept
+    {
+        return std::numeric_limits<T>::digits >= 53 ? 15 : 7;
+    }
+
+    /**
+     * \brief Accumulate digits known to be valid into an integer
+     *
+     * There must be few enough digits that the result cannot overflow.
+     */
+    static uint64_t accumulate(const char* str, const char* end) noexcept
+    {
+        uint64_t value = 0;
+        while (end - str >= 8) {
+            value = value * 100000000U + fast_float::parse_eight_digits_unrolled(str);
+            str += 8;
+        }
+        for (; str != end; ++str) {
+            value = value * 10U + static_cast<uint64_t>(*str - '0');
+        }
+        return value;
+    }
+
+    /// Parse a string of the learned shape, returning false if it is not
+    template <typename T>
+    bool parse_shaped(const char* str, const char* end, T& value) const noexcept
+    {
+        const bool negative = str != end && *str == '-';
+        std::size_t int_digits;
+        if (fraction_digits(str, end, int_digits) != m_fraction_digits) {
+            return false;
+        }
+        str += static_cast<std::size_t>(negative);
+
+        if constexpr (std::is_integral_v<T>) {
+            // Too many digits or a negative unsigned could overflow
+            if (int_digits > static_cast<std::size_t>(overflow_cutoff<T>())
+                || (std::is_unsigned_v<T> && negative)) {
+                return false;
+            }
+            const auto magnitude = static_cast<T>(accumulate(str, end));
+            value = negative ? static_cast<T>(-magnitude) : magnitude;
+            return true;
+
+        } else {
+            // Dividing two exactly-representable values is correctly rounded
+            const std::size_t frac_digits
+                = m_fraction_digits < 0 ? 0 : static_cast<std::size_t>(m_fraction_digits);
+            if (int_digits + frac_digits > max_exact_digits<T>()) {
+                return false;
+            }
+            uint64_t mantissa = accumulate(str, str + int_digits);
+            if (frac_digits > 0) {
+                const char* frac = str + int_digits + 1;
+                for (std::size_t i = 0; i < frac_digits; ++i) {
+                    mantissa *= 10U;
+                }
+                mantissa += accumulate(frac, end);
+            }
+            T result = static_cast<T>(mantissa);
+            if (frac_digits > 0) {
+                result /= POWERS_OF_TEN<T>[frac_digits];
+            }
+            value = negative ? -result : result;
+            return true;
+        }
+    }
+
+    /// Powers of ten exactly representable in the type
+    template <typename T>
+    static constexpr T POWERS_OF_TEN[23] = {
+        T(1e0),  T(1e1),  T(1e2),  T(1e3),  T(1e4),  T(1e5),  T(1e6),  T(1e7),
+        T(1e8),  T(1e9),  T(1e10), T(1e11), T(1e12), T(1e13), T(1e14), T(1e15),
+        T(1e16), T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22),
+    };
+};
@@ -36,3 +36,9 @@ inline PyObject* PyType_GetName(PyTypeObject* type)
     return type_name(type, nullptr);
 }
 #endif
+
+#ifndef Py_TPFLAGS_SEQUENCE
+// This flag was introduced in Python 3.10 to let pattern matching recognize
+// sequences, and before then there was nothing to set.
+#define Py_TPFLAGS_SEQUENCE 0
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * \class ContentHash
+ * \brief A fast non-cryptographic 128-bit hash of a stream of bytes
+ *
+ * Two independent 64-bit lanes each mix in the data eight bytes at a time
+ * with a multiply and rotate, and are finished with the MurmurHash3
+ * finalizer. This is for recognizing data that was seen before, so it
+ * must be fast and well distributed, but it offers no protection against
+ * inputs crafted to collide.
+ *
+ * Each call to update() is hashed as a unit, so callers must add any
+ * lengths or type tags needed to keep different streams of calls apart.
+ */
+class ContentHash {
+public:
+    /// Start a new hash
+    ContentHash() noexcept
+        : m_lane1(SEED1)
+        , m_lane2(SEED2)
+        , m_length(0)
+    { }
+
+    /// Add a block of bytes to the hash
+    void update(const void* data, const std::size_t len) noexcept
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        std::size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, 8);
+            mix(word);
+        }
+        if (i < len) {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + i, len - i);
+            mix(word);
+        }
+        m_length += len;
+    }
+
+    /// Add the bytes of a trivially-copyable value to the hash
+    template <typename T>
+    void update_value(const T value) noexcept
+    {
+        update(&value, sizeof(T));
+    }
+
+    /**
+     * \brief Finish the hash
+     *
+     * \param high Where to store the first 64 bits
+     * \param low Where to store the last 64 bits
+     */
+    void digest(uint64_t& high, uint64_t& low) const noexcept
+    {
+        const uint64_t lane1 = fmix64(m_lane1 ^ m_length);
+        const uint64_t lane2 = fmix64(m_lane2 + m_length);
+        high = lane1 + lane2;
+        low = lane2 + high;
+    }
+
+    /// The MurmurHash3 64-bit finalizer
+    static constexpr uint64_t fmix64(uint64_t x) noexcept
+    {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+private:
+    /// The state of the first lane
+    uint64_t m_lane1;
+
+    /// The state of the second lane
+    uint64_t m_lane2;
+
+    /// The number of bytes hashed so far
+    uint64_t m_length;
+
+    static constexpr uint64_t SEED1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t SEED2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+
+    static constexpr uint64_t rotl(const uint64_t x, const int r) noexcept
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    /// Mix one word into both lanes
+    void mix(const uint64_t word) noexcept
+    {
+        m_lane1 = rotl(m_lane1 + word * PRIME2, 31) * PRIME1;
+        m_lane2 = rotl(m_lane2 ^ (word * PRIME4), 27) * PRIME3 + PRIME1;
+    }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Python.h>
+
+/**
+ * \brief Limits on the size of strings that are converted to Python int
+ *
+ * Creating a Python int from a long string of digits, or from a float
+ * string with a huge exponent when denoising (e.g. "1e4294967295"),
+ * takes time that grows faster than linearly with the size of the result.
+ * Before any such big-integer work is done, the digit count and exponent
+ * that StringChecker already measured are compared to these limits,
+ * which costs O(1) and is only done on the big-integer path.
+ *
+ * A negative limit means "follow sys.get_int_max_str_digits()",
+ * and a limit of zero means no limit. The interpreter setting is read at
+ * most once per call into fastnumbers, the first time a limit is checked.
+ */
+struct ConversionLimits {
+    /// The maximum number of digits in the string
+    static Py_ssize_t MAX_DIGITS;
+
+    /// The maximum magnitude of the exponent in the string
+    static Py_ssize_t MAX_EXPONENT;
+
+    /// The interpreter setting as read during the current call, or -1 if unread
+    static Py_ssize_t INTERPRETER_MAX_STR_DIGITS;
+
+    /// Forget the interpreter setting, so that it is read again when next needed
+    static void begin_call() noexcept { INTERPRETER_MAX_STR_DIGITS = -1; }
+
+    /// The limit on digits used by the interpreter for int(), or 0 if none
+    static Py_ssize_t interpreter_max_str_digits() noexcept
+    {
+        if (INTERPRETER_MAX_STR_DIGITS < 0) {
+            INTERPRETER_MAX_STR_DIGITS = read_interpreter_max_str_digits();
+        }
+        return INTERPRETER_MAX_STR_DIGITS;
+    }
+
+    /// The effective limit on the number of digits, or 0 if none
+    static Py_ssize_t max_digits() noexcept
+    {
+        return MAX_DIGITS < 0 ? interpreter_max_str_digits() : MAX_DIGITS;
+    }
+
+    /// The effective limit on the exponent magnitude, or 0 if none
+    static Py_ssize_t max_exponent() noexcept
+    {
+        return MAX_EXPONENT < 0 ? interpreter_max_str_digits() : MAX_EXPONENT;
+    }
+
+    /**
+     * \brief Check that a number of digits is within the limit
+     *
+     * \return true if allowed, otherwise false with a ValueError set
+     */
+    static bool digits_allowed(const std::size_t ndigits) noexcept
+    {
+        const Py_ssize_t limit = max_digits();
+        if (limit > 0 && ndigits > static_cast<std::size_t>(limit)) {
+            PyErr_Format(
+                PyExc_ValueError,
+                "Exceeds the limit (%zd digits) for integer string conversion: "
+                "value has %zu digits; use fastnumbers.set_conversion_limits() "
+                "or sys.set_int_max_str_digits() to increase the limit",
+                limit,
+                ndigits
+            );
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Check that an exponent magnitude is within the limit
+     *
+     * \return true if allowed, otherwise false with a ValueError set
+     */
+    static bool exponent_allowed(const std::size_t exponent) noexcept
+    {
+        const Py_ssize_t limit = max_exponent();
+        if (limit > 0 && exponent > static_cast<std::size_t>(limit)) {
+            PyErr_Format(
+                PyExc_ValueError,
+                "Exceeds the limit (%zd) for the exponent in integer string "
+                "conversion: value has exponent %zu; use "
+                "fastnumbers.set_conversion_limits() or "
+                "sys.set_int_max_str_digits() to increase the limit",
+                limit,
+                exponent
+            );
+            return false;
+        }
+        return true;
+    }
+
+private:
+    /// The value used by Python if the interpreter setting cannot be read
+    static constexpr Py_ssize_t DEFAULT_MAX_STR_DIGITS = 4300;
+
+    /// Ask the interpreter for its limit on digits for int(), or 0 if none
+    static Py_ssize_t read_interpreter_max_str_digits() noexcept
+    {
+#if PY_VERSION_HEX >= 0x030B0000
+        PyObject* getter = PySys_GetObject("get_int_max_str_digits"); // borrowed
+        PyObject* result
+            = getter == nullptr ? nullptr : PyObject_CallNoArgs(getter);
+        if (result == nullptr) {
+            PyErr_Clear();
+            return DEFAULT_MAX_STR_DIGITS;
+        }
+        const Py_ssize_t value = PyLong_AsSsize_t(result);
+        Py_DECREF(result);
+        if (value < 0) {
+            PyErr_Clear();
+            return DEFAULT_MAX_STR_DIGITS;
+        }
+        return value;
+#else
+        return 0;
+#endif
+    }
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint> // also defines __GLIBC__ where applicable
+
+/*
+ * Runtime instruction-set dispatch for the hot parsing kernels.
+ *
+ * Wheels are built for baseline x86-64, so by default the compiler never
+ * emits instructions from later micro-architecture levels. Functions
+ * marked with FN_MULTIVERSION are compiled once per x86-64 level, and the
+ * dynamic loader picks the best variant for the running CPU on first call
+ * (using an ifunc resolver, which is why this requires glibc).
+ *
+ * Only the out-of-line scanning loops are marked; the small inline kernels
+ * they call (e.g. consume_digits) are compiled into each variant.
+ * Define FN_NO_MULTIVERSION to disable the dispatch.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12                   \
+    && defined(__x86_64__) && defined(__linux__) && defined(__GLIBC__)            \
+    && !defined(FN_NO_MULTIVERSION)
+#define FN_HAVE_MULTIVERSION 1
+#define FN_MULTIVERSION                                                          \
+    __attribute__((target_clones(                                                \
+        "default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4"           \
+    )))
+#else
+#define FN_MULTIVERSION
+#endif
+
+/**
+ * \brief Return the name of the kernel variant selected for this CPU
+ *
+ * This mirrors the priority order used by the ifunc resolver, so it names
+ * the variant that is actually running.
+ */
+inline const char* active_cpu_variant() noexcept
+{
+#ifdef FN_HAVE_MULTIVERSION
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("x86-64-v4")) {
+        return "x86-64-v4";
+    } else if (__builtin_cpu_supports("x86-64-v3")) {
+        return "x86-64-v3";
+    } else if (__builtin_cpu_supports("x86-64-v2")) {
+        return "x86-64-v2";
+    }
+#endif
+    return "default";
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cmath>
+#include <complex>
+#include <limits>
 #include <map>
 #include <type_traits>
 #include <utility>
@@ -8,6 +10,7 @@
 
 #include <Python.h>
 
+#include "fastnumbers/column_shape.hpp"
 #include "fastnumbers/compatibility.hpp"
 #include "fastnumbers/exception.hpp"
 #include "fastnumbers/extractor.hpp"
@@ -16,6 +19,7 @@
 #include "fastnumbers/parser.hpp"
 #include "fastnumbers/payload.hpp"
 #include "fastnumbers/selectors.hpp"
+#include "fastnumbers/tracing.hpp"
 #include "fastnumbers/user_options.hpp"
 
 /**
@@ -34,6 +38,11 @@ public:
         , m_type_error()
         , m_options(options)
         , m_buffer()
+        , m_speculation()
+        , m_shape(
+              std::is_arithmetic_v<T> && options.get_base() == 10
+              && !options.number_format().is_custom()
+          )
     { }
 
     // Copy and assignment are disallowed
@@ -45,50 +54,138 @@ public:
     ~CTypeExtractor() = default;
 
     /**
-     * \brief Return a C number in the requested type
+     * \brief Store a C number in the requested type, or why there is none
+     *
+     * No replacements are made here, so NaN and INF are stored as-is and
+     * an error is reported to be replaced later with replace_error().
+     * Only errors that the user wants raised are raised right away.
+     *
+     * The result is not returned as a RawPayload because this is called
+     * for every element of an array, and the variant is costly to pass
+     * back through the iteration machinery compared to a plain bool.
+     *
      * \param input The Python object from which to extract the number
-     * \return The C number in the template type specified
+     * \param value The C number in the template type specified, on success
+     * \param error The reason there is no number, on failure
+     * \return true on success, false on failure
      * \throw exception_is_set If a Python exception is set and needs to be raised
      */
-    T extract_c_number(PyObject* input) noexcept(false)
+    bool extract_c_number(PyObject* input, T& value, ErrorType& error) noexcept(false)
     {
+        // Homogeneous columns of strings can skip the general parser
+        if (m_shape.enabled()) {
+            const char* str = nullptr;
+            std::size_t len = 0;
+            if (!exact_ascii_string(input, str, len)) {
+                m_shape.disable();
+            } else if (m_shape.parse(str, str + len, value)) {
+                return true;
+            }
+        }
+
         // Get the payload no matter which parser was returned
         RawPayload<T> payload;
         std::visit(
             [&payload](const auto& parser) {
                 parser.as_number(payload);
             },
-            extract_parser(input, m_buffer, m_options)
+            extract_parser(input, m_buffer, m_options, m_speculation)
         );
+        if (const T* result = std::get_if<T>(&payload)) {
+            value = *result;
+            return true;
+        }
 
-        // Function to pass-through a valid value, handling the special
-        // case of the value being NaN or INF and requiring a replacement.
-        auto handle_value = [&](const T value) -> T {
-            if constexpr (std::is_floating_point_v<T>) {
-                const bool replace_nan = !std::holds_alternative<std::monostate>(m_nan);
-                const bool replace_inf = !std::holds_alternative<std::monostate>(m_inf);
-                if (std::isnan(value) && replace_nan) {
-                    return replace_value(ReplaceType::NAN_, input);
-                } else if (std::isinf(value) && replace_inf) {
-                    return replace_value(ReplaceType::INF_, input);
-                }
+        // Raise now if there is no replacement for the error
+        error = std::get<ErrorType>(payload);
+        const ReplaceType key = error_key(error);
+        if (std::holds_alternative<std::monostate>(get_value(key))) {
+            replace_value(key, input);
+        }
+        return false;
+    }
+
+    /**
+     * \brief Return the replacement for an input that could not be converted
+     * \param err The reason the input could not be converted
+     * \param input The Python object that could not be converted
+     * \return The C number after replacement
+     * \throw exception_is_set If a Python exception is set and needs to be raised
+     */
+    T replace_error(const ErrorType err, PyObject* input) const noexcept(false)
+    {
+        return replace_value(error_key(err), input);
+    }
+
+    /**
+     * \brief Replace the NaN and INF values of an array of converted values
+     *
+     * The values are first counted with a branch-free loop that the compiler
+     * can vectorize, so that an array with no NaN or INF costs one fast pass
+     * and no per-element checks were needed while converting.
+     *
+     * \param data The start of the array
+     * \param size The number of elements in the array
+     * \param stride The distance between elements of the array, in elements
+     * \param get_item Return a new reference to the input at an index
+     * \throw exception_is_set If a Python exception is set and needs to be raised
+     */
+    template <typename GetItem>
+    void replace_nan_and_inf(
+        T* data, const Py_ssize_t size, const Py_ssize_t stride, const GetItem& get_item
+    ) const noexcept(false)
+    {
+        if constexpr (std::is_floating_point_v<T> || is_complex_v<T>) {
+            const bool replace_nan = !std::holds_alternative<std::monostate>(m_nan);
+            const bool replace_inf = !std::holds_alternative<std::monostate>(m_inf);
+            if (!(replace_nan || replace_inf)
+                || count_not_finite(data, size, stride) == 0) {
+                return;
             }
-            return value;
-        };
 
-        // Function to call the appropriate error handler if an error occured.
-        auto handle_error = [this, input](const ErrorType err) -> T {
-            if (err == ErrorType::BAD_VALUE) {
-                return replace_value(ReplaceType::FAIL_, input);
-            } else if (err == ErrorType::OVERFLOW_) {
-                return replace_value(ReplaceType::OVERFLOW_, input);
-            } else {
-                return replace_value(ReplaceType::TYPE_ERROR_, input);
+            for (Py_ssize_t i = 0; i < size; ++i) {
+                T& value = data[i * stride];
+                if (is_finite(value)) {
+                    continue;
+                }
+                if (replace_nan && is_nan(value)) {
+                    value = replace_at(ReplaceType::NAN_, i, get_item);
+                } else if (replace_inf && is_inf(value)) {
+                    value = replace_at(ReplaceType::INF_, i, get_item);
+                }
             }
-        };
+        }
+    }
 
-        // Based perform different logic depending on what was contained in the payload
-        return std::visit(overloaded { handle_value, handle_error }, payload);
+    /**
+     * \brief Is any replacement a Python callable?
+     *
+     * A callable may raise or have side effects, so unlike a constant it
+     * must be called in the order of the elements.
+     */
+    bool has_callable_replacement() const noexcept
+    {
+        return std::holds_alternative<PyObject*>(m_inf)
+            || std::holds_alternative<PyObject*>(m_nan)
+            || std::holds_alternative<PyObject*>(m_fail)
+            || std::holds_alternative<PyObject*>(m_overflow)
+            || std::holds_alternative<PyObject*>(m_type_error);
+    }
+
+    /**
+     * \brief Might the input of a converted value still be needed?
+     *
+     * Only NaN and INF are replaced after conversion (possibly by calling
+     * a function with the input), so the input of any other value is no
+     * longer needed once it is converted.
+     */
+    static bool may_be_replaced(const T value) noexcept
+    {
+        if constexpr (std::is_floating_point_v<T> || is_complex_v<T>) {
+            return !is_finite(value);
+        } else {
+            return false;
+        }
     }
 
     /**
@@ -184,7 +281,118 @@ private:
     /// A buffer into which to store text data
     Buffer m_buffer;
 
+    /// The type that the elements are speculated to be
+    TypeSpeculation m_speculation;
+
+    /// The learned shape of the strings being converted
+    ColumnShape m_shape;
+
 private:
+    /**
+     * \brief Get the characters of an exact str stored as ASCII, or of bytes
+     * \return false if the object is neither, otherwise true
+     */
+    static bool
+    exact_ascii_string(PyObject* obj, const char*& str, std::size_t& len) noexcept
+    {
+        if (PyUnicode_CheckExact(obj) && PyUnicode_IS_READY(obj)
+            && PyUnicode_IS_COMPACT_ASCII(obj)) {
+            str = (const char*)PyUnicode_1BYTE_DATA(obj);
+            len = static_cast<std::size_t>(PyUnicode_GET_LENGTH(obj));
+            return true;
+        } else if (PyBytes_CheckExact(obj)) {
+            str = PyBytes_AS_STRING(obj);
+            len = static_cast<std::size_t>(PyBytes_GET_SIZE(obj));
+            return true;
+        }
+        return false;
+    }
+
+    /// The replacement to use for a conversion error
+    static ReplaceType error_key(const ErrorType err) noexcept
+    {
+        if (err == ErrorType::BAD_VALUE) {
+            return ReplaceType::FAIL_;
+        } else if (err == ErrorType::OVERFLOW_) {
+            return ReplaceType::OVERFLOW_;
+        } else {
+            return ReplaceType::TYPE_ERROR_;
+        }
+    }
+
+    /// Is the value neither NaN nor INF? Written to be branch-free.
+    static bool is_finite(const T value) noexcept
+    {
+        if constexpr (is_complex_v<T>) {
+            using V = typename T::value_type;
+            constexpr V max = std::numeric_limits<V>::max();
+            return (std::abs(value.real()) <= max) & (std::abs(value.imag()) <= max);
+        } else {
+            return std::abs(value) <= std::numeric_limits<T>::max();
+        }
+    }
+
+    /// Is the value NaN? A complex is NaN if either component is.
+    static bool is_nan(const T value) noexcept
+    {
+        if constexpr (is_complex_v<T>) {
+            return std::isnan(value.real()) || std::isnan(value.imag());
+        } else {
+            return std::isnan(value);
+        }
+    }
+
+    /// Is the value INF? A complex is INF if either component is.
+    static bool is_inf(const T value) noexcept
+    {
+        if constexpr (is_complex_v<T>) {
+            return std::isinf(value.real()) || std::isinf(value.imag());
+        } else {
+            return std::isinf(value);
+        }
+    }
+
+    /// Count the values in an array that are NaN or INF
+    static Py_ssize_t count_not_finite(
+        const T* data, const Py_ssize_t size, const Py_ssize_t stride
+    ) noexcept
+    {
+        Py_ssize_t count = 0;
+        if (stride == 1) {
+            for (Py_ssize_t i = 0; i < size; ++i) {
+                count += static_cast<Py_ssize_t>(!is_finite(data[i]));
+            }
+        } else {
+            for (Py_ssize_t i = 0; i < size; ++i) {
+                count += static_cast<Py_ssize_t>(!is_finite(data[i * stride]));
+            }
+        }
+        return count;
+    }
+
+    /**
+     * \brief Replace the value at an index of the input
+     *
+     * The input is only looked up if the replacement is a callable.
+     */
+    template <typename GetItem>
+    T replace_at(const ReplaceType key, const Py_ssize_t index, const GetItem& get_item)
+        const noexcept(false)
+    {
+        if (const T* value = std::get_if<T>(&get_value(key))) {
+            return *value;
+        }
+        PyObject* item = get_item(index);
+        try {
+            const T value = replace_value(key, item);
+            Py_DECREF(item);
+            return value;
+        } catch (...) {
+            Py_DECREF(item);
+            throw;
+        }
+    }
+
     /// Return the object that corresponds to the user's requested key -
     /// the return is a reference so it can be edited
     ReplaceValue& get_value(ReplaceType key) noexcept
@@ -359,6 +567,7 @@ private:
     ) const
     {
         // Call a Python function
+        FN_TRACE2(callback__invoke, callable, input);
         PyObject* retval = PyObject_CallFunctionObjArgs(callable, input, nullptr);
 
         // On exception, no need to define our our own message,
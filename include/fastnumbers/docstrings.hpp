@@ -8,7 +8,8 @@ PyDoc_STRVAR(
     try_real__doc__,
     "try_real(x, *, inf=fastnumbers.ALLOWED, nan=fastnumbers.ALLOWED, "
     "on_fail=fastnumbers.INPUT, on_type_error=fastnumbers.RAISE, "
-    "coerce=True, allow_underscores=False, map=False)\n"
+    "coerce=True, allow_underscores=False, allow_fraction=False, assume_valid=False, map=False, "
+    "decimal_point='.', thousands=None, accounting=False, suffixes=None)\n"
     "Quickly convert input to an *int* or *float* depending on value.\n"
     "\n"
     "Any input that is valid for the built-in *float* or *int* functions will\n"
@@ -58,11 +59,45 @@ PyDoc_STRVAR(
     "    or *float* (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
-    "map : bool or type(list), optional\n"
+    "allow_fraction : bool, optional\n"
+    "    If *True*, a string may also be a rational number, either ``'3/4'`` or\n"
+    "    a mixed number like ``'1 3/4'``, and is converted to the nearest\n"
+    "    float (i.e. correctly rounded). There can be no whitespace around the\n"
+    "    ``'/'``, and a zero denominator is invalid. The default is *False*.\n"
+    "assume_valid : bool, optional\n"
+    "    If *True*, strings are trusted to be valid numbers with no whitespace,\n"
+    "    such as data written by another program, so the whitespace is not\n"
+    "    stripped and integers are converted with no validation at all. The\n"
+    "    result for a string that is not a valid number is unspecified (but\n"
+    "    memory is never read out of bounds). The default is *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
+    "map : bool, type(list), or 'inplace', optional\n"
     "    If *True* or *list*, instead of accepting a single value to convert this\n"
     "    function accepts an iterable of values to convert. If *True* it returns\n"
     "    an iterable of the results, and if *list* it returns a *list* of\n"
-    "    the results. The default is *False*.\n"
+    "    the results. If ``'inplace'``, the input must be a *list*, and each of\n"
+    "    its elements is replaced by its result as soon as it is converted, so\n"
+    "    no second list is created; the same list is returned. If an error is\n"
+    "    raised, the elements before it are already converted. The default is\n"
+    "    *False*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -126,6 +161,10 @@ PyDoc_STRVAR(
     "    7\n"
     "    >>> try_real(['56.0', '56.07'], map=list)\n"
     "    [56, 56.07]\n"
+    "    >>> try_real('1,234', thousands=',')\n"
+    "    1234\n"
+    "    >>> try_real(['10k', '1.5GiB', '45%'], suffixes=['si', 'iec', 'percent'], map=list)\n"
+    "    [10000, 1610612736, 0.45]\n"
     "\n"
 );
 
@@ -133,7 +172,9 @@ PyDoc_STRVAR(
     try_float__doc__,
     "try_float(x, *, inf=fastnumbers.ALLOWED, nan=fastnumbers.ALLOWED, "
     "on_fail=fastnumbers.INPUT, on_type_error=fastnumbers.RAISE, "
-    "allow_underscores=False, map=False)\n"
+    "allow_underscores=False, allow_hex_float=False, allow_fraction=False, assume_valid=False, "
+    "map=False, decimal_point='.', "
+    "thousands=None, accounting=False, suffixes=None)\n"
     "Quickly convert input to a *float*.\n"
     "\n"
     "Any input that is valid for the built-in *float* function will\n"
@@ -175,11 +216,50 @@ PyDoc_STRVAR(
     "    or *float* (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
-    "map : bool or type(list), optional\n"
+    "allow_hex_float : bool, optional\n"
+    "    If *True*, a string starting with ``'0x'`` (after the sign) is a\n"
+    "    hexadecimal float as accepted by *float.fromhex*, e.g. ``'0x1.8p+3'``,\n"
+    "    and is converted exactly. A value too large to represent is an\n"
+    "    *OverflowError*, like for *float.fromhex*. The default is *False*.\n"
+    "allow_fraction : bool, optional\n"
+    "    If *True*, a string may also be a rational number, either ``'3/4'`` or\n"
+    "    a mixed number like ``'1 3/4'``, and is converted to the nearest\n"
+    "    float (i.e. correctly rounded). There can be no whitespace around the\n"
+    "    ``'/'``, and a zero denominator is invalid. The default is *False*.\n"
+    "assume_valid : bool, optional\n"
+    "    If *True*, strings are trusted to be valid numbers with no whitespace,\n"
+    "    such as data written by another program, so the whitespace is not\n"
+    "    stripped and integers are converted with no validation at all. The\n"
+    "    result for a string that is not a valid number is unspecified (but\n"
+    "    memory is never read out of bounds). The default is *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
+    "map : bool, type(list), or 'inplace', optional\n"
     "    If *True* or *list*, instead of accepting a single value to convert this\n"
     "    function accepts an iterable of values to convert. If *True* it returns\n"
     "    an iterable of the results, and if *list* it returns a *list* of\n"
-    "    the results. The default is *False*.\n"
+    "    the results. If ``'inplace'``, the input must be a *list*, and each of\n"
+    "    its elements is replaced by its result as soon as it is converted, so\n"
+    "    no second list is created; the same list is returned. If an error is\n"
+    "    raised, the elements before it are already converted. The default is\n"
+    "    *False*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -220,6 +300,10 @@ PyDoc_STRVAR(
     "    56.07\n"
     "    >>> try_float(56)\n"
     "    56.0\n"
+    "    >>> try_float('0x1.8p+3', allow_hex_float=True)\n"
+    "    12.0\n"
+    "    >>> try_float('1 1/2', allow_fraction=True)\n"
+    "    1.5\n"
     "    >>> try_float('invalid', on_fail=50)\n"
     "    50\n"
     "    >>> try_float('nan')\n"
@@ -236,13 +320,20 @@ PyDoc_STRVAR(
     "    7\n"
     "    >>> try_float(['56.0', '56.07'], map=list)\n"
     "    [56.0, 56.07]\n"
+    "    >>> try_float('1.234,56', decimal_point=',', thousands='.')\n"
+    "    1234.56\n"
+    "    >>> try_float('(1,234.50)', thousands=',', accounting=True)\n"
+    "    -1234.5\n"
+    "    >>> try_float('3.2M', suffixes='si')\n"
+    "    3200000.0\n"
     "\n"
 );
 
 PyDoc_STRVAR(
     try_int__doc__,
     "try_int(x, *, on_fail=fastnumbers.INPUT, on_type_error=fastnumbers.RAISE, "
-    "base=10, allow_underscores=False, map=False)\n"
+    "base=10, allow_underscores=False, assume_valid=False, map=False, "
+    "decimal_point='.', thousands=None, accounting=False, suffixes=None)\n"
     "Quickly convert input to an *int*.\n"
     "\n"
     "Any input that is valid for the built-in *int*\n"
@@ -277,11 +368,40 @@ PyDoc_STRVAR(
     "    or *float* (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
-    "map : bool or type(list), optional\n"
+    "assume_valid : bool, optional\n"
+    "    If *True*, strings are trusted to be valid numbers with no whitespace,\n"
+    "    such as data written by another program, so the whitespace is not\n"
+    "    stripped and integers are converted with no validation at all. The\n"
+    "    result for a string that is not a valid number is unspecified (but\n"
+    "    memory is never read out of bounds). The default is *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
+    "map : bool, type(list), or 'inplace', optional\n"
     "    If *True* or *list*, instead of accepting a single value to convert this\n"
     "    function accepts an iterable of values to convert. If *True* it returns\n"
     "    an iterable of the results, and if *list* it returns a *list* of\n"
-    "    the results. The default is *False*.\n"
+    "    the results. If ``'inplace'``, the input must be a *list*, and each of\n"
+    "    its elements is replaced by its result as soon as it is converted, so\n"
+    "    no second list is created; the same list is returned. If an error is\n"
+    "    raised, the elements before it are already converted. The default is\n"
+    "    *False*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -345,7 +465,8 @@ PyDoc_STRVAR(
 PyDoc_STRVAR(
     try_forceint__doc__,
     "try_forceint(x, *, on_fail=fastnumbers.INPUT, on_type_error=fastnumbers.RAISE, "
-    "allow_underscores=False, map=False)\n"
+    "allow_underscores=False, assume_valid=False, map=False, decimal_point='.', "
+    "thousands=None, accounting=False, suffixes=None)\n"
     "Quickly convert input to an *int*, truncating if a *float*.\n"
     "\n"
     "Any input that is valid for the built-in *int*\n"
@@ -384,11 +505,40 @@ PyDoc_STRVAR(
     "    or *float* (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
-    "map : bool or type(list), optional\n"
+    "assume_valid : bool, optional\n"
+    "    If *True*, strings are trusted to be valid numbers with no whitespace,\n"
+    "    such as data written by another program, so the whitespace is not\n"
+    "    stripped and integers are converted with no validation at all. The\n"
+    "    result for a string that is not a valid number is unspecified (but\n"
+    "    memory is never read out of bounds). The default is *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
+    "map : bool, type(list), or 'inplace', optional\n"
     "    If *True* or *list*, instead of accepting a single value to convert this\n"
     "    function accepts an iterable of values to convert. If *True* it returns\n"
     "    an iterable of the results, and if *list* it returns a *list* of\n"
-    "    the results. The default is *False*.\n"
+    "    the results. If ``'inplace'``, the input must be a *list*, and each of\n"
+    "    its elements is replaced by its result as soon as it is converted, so\n"
+    "    no second list is created; the same list is returned. If an error is\n"
+    "    raised, the elements before it are already converted. The default is\n"
+    "    *False*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -443,11 +593,332 @@ PyDoc_STRVAR(
     "\n"
 );
 
+PyDoc_STRVAR(
+    try_complex__doc__,
+    "try_complex(x, *, on_fail=fastnumbers.INPUT, on_type_error=fastnumbers.RAISE, "
+    "allow_underscores=False, map=False)\n"
+    "Quickly convert input to a *complex*.\n"
+    "\n"
+    "Any input that is valid for the built-in *complex* function when given\n"
+    "a single argument will be converted to a *complex*, e.g. '1+2j', '(3-4J)',\n"
+    "'5j', or '6'. An input of a single numeric unicode character is also valid.\n"
+    "\n"
+    "If the given input is a string and cannot be converted to a *complex*\n"
+    "it will be returned as-is unless `on_fail` indicates otherwise.\n"
+    "\n"
+    "Parameters\n"
+    "----------\n"
+    "input : {str, complex, float, int} or iterable of {str, complex, float, int}\n"
+    "    The input you wish to convert to a *complex* - must be an iterable of\n"
+    "    inputs if *map* is not *False*.\n"
+    "on_fail : optional\n"
+    "    Control what happens when an input string cannot be converted to a\n"
+    "    *complex*. The default is *INPUT* which indicates that the value should\n"
+    "    be returned as-is. Other valid values are *RAISE* to indicate a\n"
+    "    *ValueError* should be raised, a callable accepting a single argument\n"
+    "    that will be called with the input to return an alternate value, or a\n"
+    "    default value to be returned instead of the input.\n"
+    "on_type_error : optional\n"
+    "    Control what happens when the input is neither numeric nor string. Behavior\n"
+    "    matches that of `on_fail` except that the default value is *RAISE* and a\n"
+    "    *TypeError* is raised instead of *ValueError*.\n"
+    "allow_underscores : bool, optional\n"
+    "    Underscores are allowed in numeric literals and in strings passed to\n"
+    "    *complex* (see PEP 515 for details on what is and is not allowed). You\n"
+    "    can enable that behavior by setting this option to *True* - the default\n"
+    "    is *False*.\n"
+    "map : bool, type(list), or 'inplace', optional\n"
+    "    If *True* or *list*, instead of accepting a single value to convert this\n"
+    "    function accepts an iterable of values to convert. If *True* it returns\n"
+    "    an iterable of the results, and if *list* it returns a *list* of\n"
+    "    the results. If ``'inplace'``, the input must be a *list*, and each of\n"
+    "    its elements is replaced by its result as soon as it is converted, so\n"
+    "    no second list is created; the same list is returned. If an error is\n"
+    "    raised, the elements before it are already converted. The default is\n"
+    "    *False*.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "out : {str, complex} or list of {str, complex}\n"
+    "    If the input could be converted to a *complex*, the return type will be\n"
+    "    *complex*. Otherwise, the return value can be manipulated.\n"
+    "    by the value of `on_fail` or `on_type_error`.\n"
+    "    If *map* is *True*, then the output will be an iterator of these things.\n"
+    "    If *map* is *list*, then the output will be a *list* of these things.\n"
+    "\n"
+    "Raises\n"
+    "------\n"
+    "TypeError\n"
+    "    If the input is not one of *str*, *complex*, *float*, or *int* and\n"
+    "    `on_type_error` is set to *RAISE*.\n"
+    "ValueError\n"
+    "    If `on_fail` is set to *RAISE* and a triggering event is set.\n"
+    "\n"
+    "See Also\n"
+    "--------\n"
+    "try_float\n"
+    "\n"
+    "Examples\n"
+    "--------\n"
+    "\n"
+    "    >>> from fastnumbers import RAISE, try_complex\n"
+    "    >>> try_complex('1+2j')\n"
+    "    (1+2j)\n"
+    "    >>> try_complex(' (3.5-4J) ')\n"
+    "    (3.5-4j)\n"
+    "    >>> try_complex('5j')\n"
+    "    5j\n"
+    "    >>> try_complex('6')\n"
+    "    (6+0j)\n"
+    "    >>> try_complex(7.5)\n"
+    "    (7.5+0j)\n"
+    "    >>> try_complex('1+2i')\n"
+    "    '1+2i'\n"
+    "    >>> try_complex('invalid', on_fail=0j)\n"
+    "    0j\n"
+    "    >>> try_complex('1+2i', on_fail=RAISE) #doctest: +IGNORE_EXCEPTION_DETAIL\n"
+    "    Traceback (most recent call last):\n"
+    "      ...\n"
+    "    ValueError: complex() arg is a malformed string\n"
+    "    >>> try_complex(['1+2j', '-3j'], map=list)\n"
+    "    [(1+2j), -3j]\n"
+    "\n"
+);
+
+PyDoc_STRVAR(
+    try_fraction__doc__,
+    "try_fraction(x, *, on_fail=fastnumbers.INPUT, on_type_error=fastnumbers.RAISE, "
+    "allow_underscores=False, map=False)\n"
+    "Quickly convert input to a *fractions.Fraction*.\n"
+    "\n"
+    "A string that is a rational number, either ``'3/4'`` or a mixed number\n"
+    "like ``'1 3/4'``, or a decimal number like ``'1.25'`` or ``'2e-3'`` will\n"
+    "be converted exactly to a *Fraction*. The numerator and denominator are\n"
+    "parsed as integers and given directly to *Fraction*, so its regular\n"
+    "expression parsing is not used. Numbers (including *float* and\n"
+    "*decimal.Decimal*) are given to *Fraction* as-is. An input of a single\n"
+    "digit unicode character is also valid.\n"
+    "\n"
+    "If the given input is a string and cannot be converted to a *Fraction*\n"
+    "it will be returned as-is unless `on_fail` indicates otherwise.\n"
+    "\n"
+    "Parameters\n"
+    "----------\n"
+    "input : {str, Fraction, float, int} or iterable of {str, Fraction, float, int}\n"
+    "    The input you wish to convert to a *Fraction* - must be an iterable of\n"
+    "    inputs if *map* is not *False*.\n"
+    "on_fail : optional\n"
+    "    Control what happens when an input cannot be converted to a *Fraction*.\n"
+    "    The default is *INPUT* which indicates that the value should be\n"
+    "    returned as-is. Other valid values are *RAISE* to indicate the error\n"
+    "    should be raised (a *ValueError*, or a *ZeroDivisionError* for a zero\n"
+    "    denominator), a callable accepting a single argument that will be\n"
+    "    called with the input to return an alternate value, or a default value\n"
+    "    to be returned instead of the input.\n"
+    "on_type_error : optional\n"
+    "    Control what happens when the input is neither numeric nor string. Behavior\n"
+    "    matches that of `on_fail` except that the default value is *RAISE* and a\n"
+    "    *TypeError* is raised instead of *ValueError*.\n"
+    "allow_underscores : bool, optional\n"
+    "    Underscores are allowed in numeric literals and in strings passed to\n"
+    "    *Fraction* (see PEP 515 for details on what is and is not allowed). You\n"
+    "    can enable that behavior by setting this option to *True* - the default\n"
+    "    is *False*.\n"
+    "map : bool, type(list), or 'inplace', optional\n"
+    "    If *True* or *list*, instead of accepting a single value to convert this\n"
+    "    function accepts an iterable of values to convert. If *True* it returns\n"
+    "    an iterable of the results, and if *list* it returns a *list* of\n"
+    "    the results. If ``'inplace'``, the input must be a *list*, and each of\n"
+    "    its elements is replaced by its result as soon as it is converted, so\n"
+    "    no second list is created; the same list is returned. If an error is\n"
+    "    raised, the elements before it are already converted. The default is\n"
+    "    *False*.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "out : {str, Fraction} or list of {str, Fraction}\n"
+    "    If the input could be converted to a *Fraction*, the return type will be\n"
+    "    *Fraction*. Otherwise, the return value can be manipulated.\n"
+    "    by the value of `on_fail` or `on_type_error`.\n"
+    "    If *map* is *True*, then the output will be an iterator of these things.\n"
+    "    If *map* is *list*, then the output will be a *list* of these things.\n"
+    "\n"
+    "Raises\n"
+    "------\n"
+    "TypeError\n"
+    "    If the input is not one of *str* or a number and `on_type_error` is set\n"
+    "    to *RAISE*.\n"
+    "ValueError\n"
+    "    If `on_fail` is set to *RAISE* and a triggering event is set.\n"
+    "\n"
+    "See Also\n"
+    "--------\n"
+    "try_float\n"
+    "\n"
+    "Examples\n"
+    "--------\n"
+    "\n"
+    "    >>> from fastnumbers import RAISE, try_fraction\n"
+    "    >>> try_fraction('3/4')\n"
+    "    Fraction(3, 4)\n"
+    "    >>> try_fraction('-1 1/2')\n"
+    "    Fraction(-3, 2)\n"
+    "    >>> try_fraction('0.125')\n"
+    "    Fraction(1, 8)\n"
+    "    >>> try_fraction(0.5)\n"
+    "    Fraction(1, 2)\n"
+    "    >>> try_fraction('3 / 4')\n"
+    "    '3 / 4'\n"
+    "    >>> try_fraction('invalid', on_fail=0)\n"
+    "    0\n"
+    "    >>> try_fraction('1/2/3', on_fail=RAISE) #doctest: +IGNORE_EXCEPTION_DETAIL\n"
+    "    Traceback (most recent call last):\n"
+    "      ...\n"
+    "    ValueError: Invalid literal for Fraction: '1/2/3'\n"
+    "    >>> try_fraction(['1/3', '2/3'], map=list)\n"
+    "    [Fraction(1, 3), Fraction(2, 3)]\n"
+    "\n"
+);
+
+PyDoc_STRVAR(
+    try_decimal__doc__,
+    "try_decimal(x, *, inf=fastnumbers.ALLOWED, nan=fastnumbers.ALLOWED, "
+    "on_fail=fastnumbers.INPUT, on_type_error=fastnumbers.RAISE, "
+    "allow_underscores=False, map=False, decimal_point='.', thousands=None, "
+    "accounting=False, suffixes=None)\n"
+    "Validate input and convert it to a *decimal.Decimal*.\n"
+    "\n"
+    "Any string that is valid for the built-in *float* function will be\n"
+    "converted exactly to a *Decimal*, keeping its digits (e.g. '1.10' is\n"
+    "``Decimal('1.10')``). Strings are validated before *Decimal* is called,\n"
+    "and the *Decimal*-only string \"sNaN\" is also accepted. Numbers (including\n"
+    "*float*) are given to *Decimal* as-is, and a *Decimal* is returned\n"
+    "unchanged. An input of a single digit unicode character is also valid.\n"
+    "\n"
+    "*Decimal* has no C API, so a valid string is still parsed by *Decimal*\n"
+    "itself, and this is not faster than calling *Decimal* directly on valid\n"
+    "strings. What it adds is the number format, `inf`, `nan`, and `on_fail`\n"
+    "handling of the other functions, without building an exception for\n"
+    "strings that are not numbers.\n"
+    "\n"
+    "If the given input is a string and cannot be converted to a *Decimal*\n"
+    "it will be returned as-is unless `on_fail` indicates otherwise.\n"
+    "\n"
+    "Parameters\n"
+    "----------\n"
+    "input : {str, Decimal, float, int} or iterable of {str, Decimal, float, int}\n"
+    "    The input you wish to convert to a *Decimal* - must be an iterable of\n"
+    "    inputs if *map* is not *False*.\n"
+    "inf : optional\n"
+    "    Control how INF is interpreted/handled. The default is *ALLOWED*, which\n"
+    "    indicates that both the string \"inf\" and an infinite number are\n"
+    "    returned as ``Decimal('Infinity')``. Other valid values are *INPUT* to\n"
+    "    indicate that if given this value it should be returned as-is, *RAISE*\n"
+    "    to indicate a *ValueError* should be raised, a callable accepting a\n"
+    "    single argument that will be called with the input to return an\n"
+    "    alternate value, or a default value to be returned instead of INF.\n"
+    "nan : optional\n"
+    "    Control how NaN is interpreted/handled. Behavior matches that of\n"
+    "    `inf` except it is for the string \"nan\" and the value NaN, which is\n"
+    "    returned as ``Decimal('NaN')``.\n"
+    "on_fail : optional\n"
+    "    Control what happens when an input string cannot be converted to a\n"
+    "    *Decimal*. The default is *INPUT* which indicates that the value should\n"
+    "    be returned as-is. Other valid values are *RAISE* to indicate a\n"
+    "    *ValueError* should be raised, a callable accepting a single argument\n"
+    "    that will be called with the input to return an alternate value, or a\n"
+    "    default value to be returned instead of the input.\n"
+    "on_type_error : optional\n"
+    "    Control what happens when the input is neither numeric nor string. Behavior\n"
+    "    matches that of `on_fail` except that the default value is *RAISE* and a\n"
+    "    *TypeError* is raised instead of *ValueError*.\n"
+    "allow_underscores : bool, optional\n"
+    "    Underscores are allowed in numeric literals and in strings passed to\n"
+    "    *Decimal* (see PEP 515 for details on what is and is not allowed). You\n"
+    "    can enable that behavior by setting this option to *True* - the default\n"
+    "    is *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    default is *None*.\n"
+    "map : bool, type(list), or 'inplace', optional\n"
+    "    If *True* or *list*, instead of accepting a single value to convert this\n"
+    "    function accepts an iterable of values to convert. If *True* it returns\n"
+    "    an iterable of the results, and if *list* it returns a *list* of\n"
+    "    the results. If ``'inplace'``, the input must be a *list*, and each of\n"
+    "    its elements is replaced by its result as soon as it is converted, so\n"
+    "    no second list is created; the same list is returned. If an error is\n"
+    "    raised, the elements before it are already converted. The default is\n"
+    "    *False*.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "out : {str, Decimal} or list of {str, Decimal}\n"
+    "    If the input could be converted to a *Decimal*, the return type will be\n"
+    "    *Decimal*. Otherwise, the return value can be manipulated.\n"
+    "    by the value of `on_fail`, `on_type_error`, `inf`, or `nan`.\n"
+    "    If *map* is *True*, then the output will be an iterator of these things.\n"
+    "    If *map* is *list*, then the output will be a *list* of these things.\n"
+    "\n"
+    "Raises\n"
+    "------\n"
+    "TypeError\n"
+    "    If the input is not one of *str* or a number and `on_type_error` is set\n"
+    "    to *RAISE*.\n"
+    "ValueError\n"
+    "    If one of `on_fail`, `inf`, or `nan` are set to *RAISE* and a triggering\n"
+    "    event is set.\n"
+    "\n"
+    "See Also\n"
+    "--------\n"
+    "try_float\n"
+    "\n"
+    "Examples\n"
+    "--------\n"
+    "\n"
+    "    >>> from fastnumbers import RAISE, try_decimal\n"
+    "    >>> try_decimal('1.10')\n"
+    "    Decimal('1.10')\n"
+    "    >>> try_decimal('-1e-3')\n"
+    "    Decimal('-0.001')\n"
+    "    >>> try_decimal('1.234,50', decimal_point=',', thousands='.')\n"
+    "    Decimal('1234.50')\n"
+    "    >>> try_decimal(0.5)\n"
+    "    Decimal('0.5')\n"
+    "    >>> try_decimal('inf')\n"
+    "    Decimal('Infinity')\n"
+    "    >>> try_decimal('nan', nan=None) is None\n"
+    "    True\n"
+    "    >>> try_decimal('12 USD')\n"
+    "    '12 USD'\n"
+    "    >>> try_decimal('12 USD', on_fail=RAISE) #doctest: +IGNORE_EXCEPTION_DETAIL\n"
+    "    Traceback (most recent call last):\n"
+    "      ...\n"
+    "    ValueError: could not convert string to Decimal: '12 USD'\n"
+    "    >>> try_decimal(['1.5', '2'], map=list)\n"
+    "    [Decimal('1.5'), Decimal('2')]\n"
+    "\n"
+);
+
 PyDoc_STRVAR(
     check_real__doc__,
     "check_real(x, *, consider=None, inf=fastnumbers.NUMBER_ONLY, "
     "nan=fastnumbers.NUMBER_ONLY, "
-    "allow_underscores=False)\n"
+    "allow_underscores=False, decimal_point='.', thousands=None, accounting=False, suffixes=None)\n"
     "Quickly determine if a string is a real number.\n"
     "\n"
     "Returns *True* if the input is valid input for the built-in `float` or\n"
@@ -478,6 +949,25 @@ PyDoc_STRVAR(
     "    or `float` (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -522,7 +1012,8 @@ PyDoc_STRVAR(
     check_float__doc__,
     "check_float(x, *, consider=None, inf=fastnumbers.NUMBER_ONLY, "
     "nan=fastnumbers.NUMBER_ONLY, "
-    "strict=False, allow_underscores=False)\n"
+    "strict=False, allow_underscores=False, decimal_point='.', thousands=None, "
+    "accounting=False, suffixes=None)\n"
     "Quickly determine if a string is a `float`.\n"
     "\n"
     "Returns *True* if the input is valid input for the built-in `float`\n"
@@ -560,6 +1051,25 @@ PyDoc_STRVAR(
     "    or `float` (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -605,7 +1115,8 @@ PyDoc_STRVAR(
 
 PyDoc_STRVAR(
     check_int__doc__,
-    "check_int(x, *, consider=None, base=10, allow_underscores=False)\n"
+    "check_int(x, *, consider=None, base=10, allow_underscores=False, "
+    "decimal_point='.', thousands=None, accounting=False, suffixes=None)\n"
     "Quickly determine if a string is an `int`.\n"
     "\n"
     "Returns *True* if the input is valid input for the built-in `int`\n"
@@ -634,6 +1145,25 @@ PyDoc_STRVAR(
     "    or `float` (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -676,7 +1206,8 @@ PyDoc_STRVAR(
 
 PyDoc_STRVAR(
     check_intlike__doc__,
-    "check_intlike(x, *, consider=None, allow_underscores=False)\n"
+    "check_intlike(x, *, consider=None, allow_underscores=False, "
+    "decimal_point='.', thousands=None, accounting=False, suffixes=None)\n"
     "Quickly determine if a string (or object) is an `int` or `int`-like.\n"
     "\n"
     "Returns *True* if the input is valid input for the built-in `int`\n"
@@ -705,6 +1236,25 @@ PyDoc_STRVAR(
     "    or `float` (see PEP 515 for details on what is and is not allowed). You can\n"
     "    enable that behavior by setting this option to *True* - the default is\n"
     "    *False*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
     "\n"
     "See Also\n"
     "--------\n"
@@ -738,7 +1288,7 @@ PyDoc_STRVAR(
 PyDoc_STRVAR(
     query_type__doc__,
     "query_type(x, *, allow_inf=False, allow_nan=False, coerce=False, allowed_types=*, "
-    "allow_underscores=True)\n"
+    "allow_underscores=True, decimal_point='.', thousands=None, accounting=False, suffixes=None)\n"
     "Quickly determine the type that fastnumbers would return for a given input.\n"
     "\n"
     "For string or bytes-like input, the contents of the string will be examined and\n"
@@ -772,6 +1322,25 @@ PyDoc_STRVAR(
     "    and in strings passed to `int` or `float` (see PEP 515 for details on\n"
     "    what is and is not allowed). You can disable that behavior by setting\n"
     "    this option to *False* - the default is *True*.\n"
+    "decimal_point : str, optional\n"
+    "    The character that separates the integer and decimal parts of a number\n"
+    "    in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.\n"
+    "thousands : str or None, optional\n"
+    "    The character that groups the integer digits of a number in a string by\n"
+    "    thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators\n"
+    "    that do not divide the integer digits into groups of three is invalid.\n"
+    "    The default is *None*, meaning no separator is allowed.\n"
+    "accounting : bool, optional\n"
+    "    If *True*, a number in a string that is enclosed in parentheses is\n"
+    "    negative, e.g. ``'(1,234.50)'``. The default is *False*.\n"
+    "suffixes : str, dict, list, or None, optional\n"
+    "    Unit suffixes that may follow a number in a string, which then is\n"
+    "    multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the\n"
+    "    name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),\n"
+    "    ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``\n"
+    "    (%) - or a dict of suffix to multiplier, or a list of these. The\n"
+    "    scaling is exact, so the result is an *int* if it is integral. Only\n"
+    "    base-10 numbers may have a suffix. The default is *None*.\n"
     "\n"
     "Returns\n"
     "-------\n"
@@ -811,6 +1380,90 @@ PyDoc_STRVAR(
     "\n"
 );
 
+PyDoc_STRVAR(
+    cpu_features__doc__,
+    "cpu_features()\n"
+    "Report which CPU-specific variant of the parsing kernels is in use.\n"
+    "\n"
+    "On x86-64 Linux, the hot parsing loops are compiled once for each of the\n"
+    "x86-64-v2, x86-64-v3, and x86-64-v4 micro-architecture levels in addition\n"
+    "to the baseline, and the best variant for the running CPU is selected\n"
+    "when the module is loaded. On other platforms only the baseline exists.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "result : dict\n"
+    "    The key *multiversioned* is *True* if multiple variants were compiled,\n"
+    "    and the key *variant* names the active variant (*default* is the\n"
+    "    baseline). If multiversioned, the remaining keys indicate support for\n"
+    "    the individual CPU features that distinguish the variants.\n"
+    "\n"
+    "Examples\n"
+    "--------\n"
+    "\n"
+    "    >>> from fastnumbers import cpu_features\n"
+    "    >>> features = cpu_features()\n"
+    "    >>> features['variant'] in ('default', 'x86-64-v2', 'x86-64-v3', 'x86-64-v4')\n"
+    "    True\n"
+    "\n"
+);
+
+PyDoc_STRVAR(
+    set_conversion_limits__doc__,
+    "set_conversion_limits(*, max_digits=None, max_exponent=None)\n"
+    "Limit the size of strings that will be converted to an *int*.\n"
+    "\n"
+    "Converting a very long string of digits to an *int*, or a float-like\n"
+    "string with a huge exponent to an *int* with ``denoise=True``\n"
+    "(e.g. ``'1e4294967295'``), takes time that grows faster than linearly with\n"
+    "the size of the result. Strings that exceed these limits are rejected\n"
+    "before any such work is done, and are treated as failed conversions\n"
+    "(raising the same :exc:`ValueError` as :func:`int` if ``on_fail=RAISE``).\n"
+    "\n"
+    "Parameters\n"
+    "----------\n"
+    "max_digits : int or None, optional\n"
+    "    The maximum number of digits in a string converted to an *int*.\n"
+    "    Zero means no limit. *None* (the default) follows the interpreter's\n"
+    "    :func:`sys.get_int_max_str_digits`, or no limit before Python 3.11.\n"
+    "max_exponent : int or None, optional\n"
+    "    The maximum exponent magnitude of a float-like string converted to an\n"
+    "    *int*. Zero means no limit. *None* (the default) follows the\n"
+    "    interpreter's :func:`sys.get_int_max_str_digits`, or no limit before\n"
+    "    Python 3.11.\n"
+    "\n"
+    "See Also\n"
+    "--------\n"
+    "get_conversion_limits\n"
+    "\n"
+);
+
+PyDoc_STRVAR(
+    get_conversion_limits__doc__,
+    "get_conversion_limits()\n"
+    "Report the limits on the size of strings that will be converted to an *int*.\n"
+    "\n"
+    "Returns\n"
+    "-------\n"
+    "result : dict\n"
+    "    The keys *max_digits* and *max_exponent* give the limits currently in\n"
+    "    effect, where zero means no limit.\n"
+    "\n"
+    "Examples\n"
+    "--------\n"
+    "\n"
+    "    >>> from fastnumbers import get_conversion_limits, set_conversion_limits\n"
+    "    >>> set_conversion_limits(max_digits=1000, max_exponent=0)\n"
+    "    >>> get_conversion_limits()\n"
+    "    {'max_digits': 1000, 'max_exponent': 0}\n"
+    "    >>> set_conversion_limits()\n"
+    "\n"
+    "See Also\n"
+    "--------\n"
+    "set_conversion_limits\n"
+    "\n"
+);
+
 PyDoc_STRVAR(
     fastnumbers_int__doc__,
     "int(x=0, *, base=10)\n"
@@ -92,6 +92,19 @@ private:
         // Otherwise, tell the downstream parser what action to take based
         // on the user requested type
         switch (ntype) {
+        case UserType::COMPLEX:
+            return convert(m_parser.as_pycomplex(), ntype);
+
+        case UserType::FRACTION:
+            return convert(m_parser.as_pyfraction(), ntype);
+
+        case UserType::DECIMAL:
+            if (typeflags & nan_or_inf) {
+                return handle_nan_and_inf();
+            } else {
+                return convert(m_parser.as_pydecimal(), ntype);
+            }
+
         case UserType::REAL:
             if (typeflags & nan_or_inf) {
                 return handle_nan_and_inf();
@@ -131,6 +144,17 @@ private:
         case UserType::FLOAT:
             return from_text_as_float();
 
+        case UserType::COMPLEX:
+            // The complex parser handles NaN and infinity itself
+            return convert(m_parser.as_pycomplex(), ntype);
+
+        case UserType::FRACTION:
+            // NaN and infinity are invalid, as they have no exact fraction
+            return convert(m_parser.as_pyfraction(), ntype);
+
+        case UserType::DECIMAL:
+            return from_text_as_decimal();
+
         case UserType::INT:
             return from_text_as_int();
 
@@ -182,6 +206,20 @@ private:
         return convert(m_parser.as_pyfloat(), UserType::FLOAT);
     }
 
+    /// Logic for evaluating a text python object as a decimal
+    Payload from_text_as_decimal() noexcept
+    {
+        // Special-case handling of infinity and NaN
+        if (m_parser.peek_inf()) {
+            return inf_action(m_parser.is_negative());
+        } else if (m_parser.peek_nan()) {
+            return nan_action(m_parser.is_negative());
+        }
+
+        // Otherwise, attempt to convert to a python decimal
+        return convert(m_parser.as_pydecimal(), UserType::DECIMAL);
+    }
+
     /// Logic for evaluating a text python object as an int
     Payload from_text_as_int() noexcept
     {
@@ -201,7 +239,25 @@ private:
     /// Return an error due to a bad type
     static Payload typed_error(const UserType ntype, const bool type = true) noexcept
     {
-        if (ntype == UserType::REAL || ntype == UserType::FLOAT) {
+        if (ntype == UserType::COMPLEX) {
+            if (type) {
+                return ActionType::ERROR_BAD_TYPE_COMPLEX;
+            } else {
+                return ActionType::ERROR_INVALID_COMPLEX;
+            }
+        } else if (ntype == UserType::FRACTION) {
+            if (type) {
+                return ActionType::ERROR_BAD_TYPE_FRACTION;
+            } else {
+                return ActionType::ERROR_INVALID_FRACTION;
+            }
+        } else if (ntype == UserType::DECIMAL) {
+            if (type) {
+                return ActionType::ERROR_BAD_TYPE_DECIMAL;
+            } else {
+                return ActionType::ERROR_INVALID_DECIMAL;
+            }
+        } else if (ntype == UserType::REAL || ntype == UserType::FLOAT) {
             if (type) {
                 return ActionType::ERROR_BAD_TYPE_FLOAT;
             } else {
@@ -254,7 +310,13 @@ private:
                     // NOTE: We explicitly are not handling ErrorType:OVERFLOW_
                     // because it cannot be returned in the PyObject* code path.
                     if (err == ErrorType::BAD_VALUE) {
-                        if (ntype == UserType::FLOAT || ntype == UserType::REAL) {
+                        if (ntype == UserType::COMPLEX) {
+                            return ActionType::ERROR_INVALID_COMPLEX;
+                        } else if (ntype == UserType::FRACTION) {
+                            return ActionType::ERROR_INVALID_FRACTION;
+                        } else if (ntype == UserType::DECIMAL) {
+                            return ActionType::ERROR_INVALID_DECIMAL;
+                        } else if (ntype == UserType::FLOAT || ntype == UserType::REAL) {
                             return ActionType::ERROR_INVALID_FLOAT;
                         } else {
                             return ActionType::ERROR_INVALID_INT;
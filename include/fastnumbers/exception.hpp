@@ -3,6 +3,8 @@
 #include <functional>
 #include <stdexcept>
 
+#include "fastnumbers/conversion_limits.hpp"
+
 /// Custom exception class to tell the handler to just return NULL
 class exception_is_set : public std::runtime_error {
 public:
@@ -49,8 +51,10 @@ public:
 
     /// Handle all exceptions from running fastnumbers logic.
     /// This is a "function try block", hence the missing pair of braces.
+    /// Each run is a new call, so conversion limits are read afresh.
     PyObject* run(std::function<PyObject*()> func) noexcept(false)
     try {
+        ConversionLimits::begin_call();
         return func();
     } catch (const exception_is_set&) {
         return nullptr;
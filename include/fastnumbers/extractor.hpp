@@ -11,6 +11,67 @@
 /// Can store any possible parser
 using AnyParser = std::variant<CharacterParser, UnicodeParser, NumericParser>;
 
+/**
+ * \class TypeSpeculation
+ * \brief Remember the kind of parser the first element of a loop needed
+ *
+ * In practice the elements of a collection are nearly always of one type,
+ * so the exact type of the first element is remembered and later elements
+ * of that exact type skip the chain of type checks in extract_parser().
+ * Only built-in types are speculated on, since their kind cannot change.
+ */
+class TypeSpeculation {
+public:
+    /// The kinds of input that are speculated on
+    enum class Kind {
+        NONE, ///< No speculation, always use the general dispatch
+        ASCII_STR, ///< An exact str, if stored as ASCII
+        BYTES, ///< An exact bytes
+        NUMERIC, ///< An exact int or float
+    };
+
+    TypeSpeculation() noexcept
+        : m_type(nullptr)
+        , m_kind(Kind::NONE)
+        , m_decided(false)
+    { }
+
+    /// Speculate based on the first element of a loop
+    void observe(PyObject* obj) noexcept
+    {
+        if (m_decided) {
+            return;
+        }
+        m_decided = true;
+        if (PyUnicode_CheckExact(obj)) {
+            m_kind = Kind::ASCII_STR;
+        } else if (PyBytes_CheckExact(obj)) {
+            m_kind = Kind::BYTES;
+        } else if (PyFloat_CheckExact(obj) || PyLong_CheckExact(obj)) {
+            m_kind = Kind::NUMERIC;
+        } else {
+            return;
+        }
+        m_type = Py_TYPE(obj);
+    }
+
+    /// The kind of the given object if it is of the speculated type
+    Kind kind_of(const PyObject* obj) const noexcept
+    {
+        return Py_TYPE(obj) == m_type ? m_kind : Kind::NONE;
+    }
+
+private:
+    /// The exact type of the first element, or nullptr
+    PyTypeObject* m_type;
+
+    /// The kind of input of the first element
+    Kind m_kind;
+
+    /// Whether the first element was seen
+    bool m_decided;
+};
+
 /**
  * \brief Return the appropriate parser for the conained data
  * \param obj The Python object from which to extract data
@@ -22,3 +83,20 @@ using AnyParser = std::variant<CharacterParser, UnicodeParser, NumericParser>;
 AnyParser extract_parser(
     PyObject* obj, Buffer& buffer, const UserOptions& options
 ) noexcept(false);
+
+/**
+ * \brief Return the appropriate parser for the contained data,
+ *        speculating that it is of the same type as earlier data
+ * \param obj The Python object from which to extract data
+ * \param buffer The buffer into which to potentially store data
+ * \param options A UserOptions instance containing the options
+ *                specified by the user.
+ * \param speculation The type speculation for the loop containing obj
+ * \return std::variant of CharacterParser, UnicodeParser, or NumericParser
+ */
+AnyParser extract_parser(
+    PyObject* obj,
+    Buffer& buffer,
+    const UserOptions& options,
+    TypeSpeculation& speculation
+) noexcept(false);
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "fastnumbers/content_hash.hpp"
+#include "fastnumbers/helpers.hpp"
+
+/**
+ * \class Factorizer
+ * \brief Assign each distinct C number a code in order of first appearance
+ *
+ * The distinct values are kept in a vector (so their code is their index)
+ * and found again through an open-addressing hash table with linear
+ * probing, which is kept at most half full. Each slot of the table holds
+ * a copy of its value, so that a lookup only touches the table.
+ *
+ * Values are compared as numbers, except that all NaN are one value,
+ * like numpy.unique. That means -0.0 and 0.0 are also one value.
+ */
+template <typename T>
+class Factorizer {
+public:
+    /// Start with no values
+    Factorizer() noexcept(false)
+        : m_uniques()
+        , m_slots(INITIAL_CAPACITY, Slot { T(), EMPTY })
+        , m_mask(INITIAL_CAPACITY - 1)
+    { }
+
+    /// Return the code of a value, giving it a new code if it is new
+    std::size_t code(const T value) noexcept(false)
+    {
+        std::size_t slot = hash(value) & m_mask;
+        while (true) {
+            const Slot& entry = m_slots[slot];
+            if (entry.index == EMPTY) {
+                return insert(slot, value);
+            } else if (same(entry.value, value)) {
+                return entry.index;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+    }
+
+    /// The distinct values, in order of their codes
+    const std::vector<T>& uniques() const noexcept { return m_uniques; }
+
+private:
+    /// An entry of the hash table
+    struct Slot {
+        /// The value
+        T value;
+
+        /// The code of the value, or EMPTY if the slot is not used
+        std::size_t index;
+    };
+
+    /// The distinct values, in order of their codes
+    std::vector<T> m_uniques;
+
+    /// The hash table of values and their codes
+    std::vector<Slot> m_slots;
+
+    /// The size of the hash table minus one (the size is a power of two)
+    std::size_t m_mask;
+
+    static constexpr std::size_t EMPTY = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t INITIAL_CAPACITY = 64;
+
+    /// Store a new value at an empty slot, and grow if needed
+    std::size_t insert(const std::size_t slot, const T value) noexcept(false)
+    {
+        const std::size_t index = m_uniques.size();
+        m_uniques.push_back(value);
+        m_slots[slot] = Slot { value, index };
+        if (2 * m_uniques.size() > m_slots.size()) {
+            grow();
+        }
+        return index;
+    }
+
+    /// Double the size of the hash table and re-insert all codes
+    void grow() noexcept(false)
+    {
+        m_slots.assign(2 * m_slots.size(), Slot { T(), EMPTY });
+        m_mask = m_slots.size() - 1;
+        for (std::size_t index = 0; index < m_uniques.size(); ++index) {
+            std::size_t slot = hash(m_uniques[index]) & m_mask;
+            while (m_slots[slot].index != EMPTY) {
+                slot = (slot + 1) & m_mask;
+            }
+            m_slots[slot] = Slot { m_uniques[index], index };
+        }
+    }
+
+    /// The bits of a real number, the same for all values that are the same
+    template <typename V>
+    static uint64_t key(const V value) noexcept
+    {
+        if constexpr (std::is_floating_point_v<V>) {
+            if (std::isnan(value)) {
+                return 0x7FF8000000000000ULL;
+            }
+            const double widened = value == 0 ? 0.0 : static_cast<double>(value);
+            uint64_t bits;
+            std::memcpy(&bits, &widened, sizeof(bits));
+            return bits;
+        } else {
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    /// Hash a value so that values that are the same hash the same
+    static std::size_t hash(const T value) noexcept
+    {
+        if constexpr (is_complex_v<T>) {
+            if (is_nan(value)) {
+                return static_cast<std::size_t>(ContentHash::fmix64(key(NAN)));
+            }
+            const uint64_t real = ContentHash::fmix64(key(value.real()));
+            const uint64_t both = ContentHash::fmix64(real ^ key(value.imag()));
+            return static_cast<std::size_t>(both);
+        } else {
+            return static_cast<std::size_t>(ContentHash::fmix64(key(value)));
+        }
+    }
+
+    /// Are two values the same?
+    static bool same(const T a, const T b) noexcept
+    {
+        if constexpr (is_complex_v<T>) {
+            return a == b || (is_nan(a) && is_nan(b));
+        } else {
+            return key(a) == key(b);
+        }
+    }
+
+    /// Is a complex value NaN? It is if either component is.
+    static bool is_nan(const T value) noexcept
+    {
+        if constexpr (is_complex_v<T>) {
+            return std::isnan(value.real()) || std::isnan(value.imag());
+        } else {
+            return false;
+        }
+    }
+};
@@ -1,9 +1,20 @@
 #pragma once
 
+#include <complex>
+#include <type_traits>
+
 /// Always evaluates to false - helps with static_assert messages
 template <class>
 inline constexpr bool always_false_v = false;
 
+/// Is the type a std::complex type?
+template <class T>
+struct is_complex : std::false_type { };
+template <class T>
+struct is_complex<std::complex<T>> : std::true_type { };
+template <class T>
+inline constexpr bool is_complex_v = is_complex<T>::value;
+
 /// Aid in constructing multiple overloads from lambdas for std::visit
 /// See https://en.cppreference.com/w/cpp/utility/variant/visit
 template <class... Ts>
@@ -7,6 +7,7 @@
 #include <Python.h>
 
 #include "fastnumbers/evaluator.hpp"
+#include "fastnumbers/extractor.hpp"
 #include "fastnumbers/resolver.hpp"
 #include "fastnumbers/selectors.hpp"
 #include "fastnumbers/user_options.hpp"
@@ -30,6 +31,7 @@ public:
         , m_num_only(false)
         , m_str_only(false)
         , m_strict(false)
+        , m_speculation()
     { }
 
     /**
@@ -49,6 +51,7 @@ public:
         , m_num_only(rhs.m_num_only)
         , m_str_only(rhs.m_str_only)
         , m_strict(rhs.m_strict)
+        , m_speculation()
     { }
 
     /// Move constructor steals object, no need to re-increment
@@ -60,6 +63,7 @@ public:
         , m_num_only(std::exchange(rhs.m_num_only, false))
         , m_str_only(std::exchange(rhs.m_str_only, false))
         , m_strict(std::exchange(rhs.m_strict, false))
+        , m_speculation()
     { }
 
     // Assignment not allowed
@@ -68,6 +72,20 @@ public:
     /// Destruct
     ~Implementation() noexcept { Py_XDECREF(m_allowed_types); }
 
+    /// Visit the Python objects held by the Implementation, for the garbage collector
+    int traverse(visitproc visit, void* arg) const noexcept
+    {
+        Py_VISIT(m_allowed_types);
+        return m_resolver.traverse(visit, arg);
+    }
+
+    /// Release the Python objects held by the Implementation, to break cycles
+    void clear() noexcept
+    {
+        Py_CLEAR(m_allowed_types);
+        m_resolver.clear();
+    }
+
     /// Convert the object to the desired user type
     PyObject* convert(PyObject* input) const noexcept(false);
 
@@ -105,12 +123,35 @@ public:
         m_resolver.set_type_error_action(val);
     }
 
+    /// Set the values returned for infinity and NaN when they are allowed
+    void set_allowed_inf_nan(
+        PyObject* pos_inf, PyObject* neg_inf, PyObject* pos_nan, PyObject* neg_nan
+    ) noexcept
+    {
+        m_resolver.set_allowed_inf_nan(pos_inf, neg_inf, pos_nan, neg_nan);
+    }
+
     /// Set whether or not underscores are allowed in strings
     void set_underscores_allowed(const bool val) noexcept
     {
         m_options.set_underscores_allowed(val);
     }
 
+    /// Set whether or not hexadecimal floats are allowed in strings
+    void set_hex_float_allowed(const bool val) noexcept
+    {
+        m_options.set_hex_float_allowed(val);
+    }
+
+    /// Set whether or not rational numbers like "3/4" are allowed in strings
+    void set_fraction_allowed(const bool val) noexcept
+    {
+        m_options.set_fraction_allowed(val);
+    }
+
+    /// Set whether strings are trusted to be valid numbers
+    void set_assume_valid(const bool val) noexcept { m_options.set_assume_valid(val); }
+
     /// Set whether intlike floats should be returned as ints
     void set_coerce(const bool val) noexcept { m_options.set_coerce(val); }
 
@@ -137,6 +178,12 @@ public:
         m_options.set_unicode_allowed(val);
     }
 
+    /// Set the locale-style format in which strings are written
+    void set_number_format(const NumberFormat& val) noexcept
+    {
+        m_options.set_number_format(val);
+    }
+
     /// Set whether we accept unicode characters based on if base is default or not
     void set_unicode_allowed() noexcept
     {
@@ -174,6 +221,10 @@ private:
     /// For checking floats, indicate input must be strictly floating-point
     bool m_strict;
 
+    /// The type the inputs are speculated to be when converting many
+    /// (this is only a cache, so it may change in const methods)
+    mutable TypeSpeculation m_speculation;
+
     /// Return value for resolve_types() function
     struct Types {
         bool from_str;
@@ -226,6 +277,22 @@ private:
     void validate_not_disallow(const PyObject* selector) const noexcept(false);
 };
 
+/**
+ * \brief Create a NumberFormat from the options given by the user
+ *
+ * \param decimal_point The decimal point character as a str, or nullptr for '.'
+ * \param thousands The thousands separator as a str, or nullptr or None for none
+ * \param accounting Whether a number in parentheses is negative
+ * \param suffixes The unit suffixes that may follow a number, or nullptr or None
+ * \throws fastnumbers_exception if a character or suffix is not allowed
+ */
+NumberFormat create_number_format(
+    PyObject* decimal_point,
+    PyObject* thousands,
+    const bool accounting,
+    PyObject* suffixes = nullptr
+) noexcept(false);
+
 /**
  * \brief Iterate over the elements of a collection and convert each one into a list
  *
@@ -248,6 +315,62 @@ PyObject* iter_iteration_impl(
     PyObject* input, std::function<PyObject*(PyObject*)> convert
 ) noexcept(false);
 
+/**
+ * \brief Convert the elements of a collection only when they are accessed
+ *
+ * \param input The given input object that should be iterable
+ * \param impl The Implementation that performs the conversion
+ * \return A new python sequence producing the converted results, or nullptr on error
+ */
+PyObject* lazy_iteration_impl(PyObject* input, Implementation impl) noexcept(false);
+
+/**
+ * \brief Prepare a conversion to be applied later, from C++ or Python
+ *
+ * \param impl The Implementation that performs the conversion
+ * \return A new python callable object holding the conversion, or nullptr on error
+ */
+PyObject* converter_impl(Implementation impl) noexcept(false);
+
+/**
+ * \brief Convert the fields of each record (dict) in place, or collect them
+ *
+ * \param input The sequence of records
+ * \param fields A dict of field name to converter from converter_impl, or if
+ *               collecting, a sequence of field names
+ * \param collect Whether to collect the field values instead of converting
+ * \param recurse Whether to look for records inside of records and lists
+ * \return None, or if collecting, a new list of one list of values per field
+ */
+PyObject* records_impl(
+    PyObject* input, PyObject* fields, const bool collect, const bool recurse
+) noexcept(false);
+
+/**
+ * \brief Iterate over the elements of a collection and store each conversion
+ *        in a numpy array of dtype object
+ *
+ * \param input The given input object that should be iterable
+ * \param output The numpy array of dtype object to populate
+ * \param converter The converter from converter_impl to use
+ * \param consume Whether or not to release the elements of the input list
+ *                as they are converted, leaving the list empty
+ */
+void object_array_impl(
+    PyObject* input, PyObject* output, PyObject* converter, const bool consume
+) noexcept(false);
+
+/**
+ * \brief Replace each element of a list with its conversion
+ *
+ * \param input The given input object, which must be a list
+ * \param convert A function accepting a single argument that performs the conversion
+ * \return A new reference to the input list, or nullptr on error
+ */
+PyObject* inplace_iteration_impl(
+    PyObject* input, std::function<PyObject*(PyObject*)> convert
+) noexcept(false);
+
 /**
  * \brief Iterate over the elements of a collection and convert each one
  *
@@ -259,7 +382,13 @@ PyObject* iter_iteration_impl(
  * \param on_overflow The object specifying what action to take on overflow
  * \param on_type_error The object specifying what action to take on type error
  * \param allow_underscores Whether or not it is OK for numbers to contain underscores
+ * \param allow_hex_float Whether or not strings may be hexadecimal floats
+ * \param allow_fraction Whether or not strings may be rational numbers like "3/4"
+ * \param assume_valid Whether or not strings are trusted to be valid numbers
+ * \param consume Whether or not to release the elements of the input list
+ *                as they are converted, leaving the list empty
  * \param base The integer base use when parsing ints, use INT_MIN for default
+ * \param number_format The locale-style format in which strings are written
  */
 void array_impl(
     PyObject* input,
@@ -270,5 +399,187 @@ void array_impl(
     PyObject* on_overflow,
     PyObject* on_type_error,
     bool allow_underscores,
-    const int base = std::numeric_limits<int>::min()
-) noexcept(false);
\ No newline at end of file
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    bool consume,
+    const int base = std::numeric_limits<int>::min(),
+    const NumberFormat& number_format = NumberFormat()
+) noexcept(false);
+
+/**
+ * \brief Number the distinct values of a collection, in order of first appearance
+ *
+ * Each element is converted as for array_impl, and the code of its value
+ * is placed in the codes array. If most values turn out to be distinct,
+ * numbering stops and all values are returned instead, to be sorted.
+ *
+ * \param input The iterable to convert
+ * \param codes The integer array in which to place the codes
+ * \param values An array whose type the values have (it may be empty)
+ * \param inf Replacement to use for infinity
+ * \param nan Replacement to use for NaN
+ * \param on_fail Replacement to use on conversion failure
+ * \param on_overflow Replacement to use on overflow
+ * \param on_type_error Replacement to use on type error
+ * \param allow_underscores Whether or not to accept underscores in strings
+ * \param allow_hex_float Whether or not to accept hexadecimal floats in strings
+ * \param allow_fraction Whether or not to accept rational numbers in strings
+ * \param assume_valid Whether or not strings are trusted to be valid numbers
+ * \param base The integer base use when parsing ints, use INT_MIN for default
+ * \param number_format The locale-style format in which strings are written
+ * \return A tuple of a bytearray and a bool. If the bool is true, the bytearray
+ *         has the distinct values as C numbers in order of their codes,
+ *         otherwise numbering stopped and it has the values of all elements
+ */
+PyObject* factorize_impl(
+    PyObject* input,
+    PyObject* codes,
+    PyObject* values,
+    PyObject* inf,
+    PyObject* nan,
+    PyObject* on_fail,
+    PyObject* on_overflow,
+    PyObject* on_type_error,
+    bool allow_underscores,
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    const int base = std::numeric_limits<int>::min(),
+    const NumberFormat& number_format = NumberFormat()
+) noexcept(false);
+
+/**
+ * \brief Locate the values of a collection among sorted bin edges
+ *
+ * Each element is converted to a double as for array_impl, and NaN
+ * (including failures replaced with NaN) goes to a bin of its own.
+ *
+ * \param input The iterable to convert
+ * \param output The integer array in which to place the bin of each element,
+ *               or the count of each bin
+ * \param edges A contiguous array of double of the bin edges, in increasing order
+ * \param right Whether or not a value equal to an edge belongs to the bin below
+ * \param counts Whether to place the count of each bin instead of the bins
+ * \param inf Replacement to use for infinity
+ * \param nan Replacement to use for NaN
+ * \param on_fail Replacement to use on conversion failure
+ * \param on_type_error Replacement to use on type error
+ * \param allow_underscores Whether or not to accept underscores in strings
+ * \param allow_hex_float Whether or not to accept hexadecimal floats in strings
+ * \param allow_fraction Whether or not to accept rational numbers in strings
+ * \param assume_valid Whether or not strings are trusted to be valid numbers
+ * \param number_format The locale-style format in which strings are written
+ */
+void digitize_impl(
+    PyObject* input,
+    PyObject* output,
+    PyObject* edges,
+    bool right,
+    bool counts,
+    PyObject* inf,
+    PyObject* nan,
+    PyObject* on_fail,
+    PyObject* on_type_error,
+    bool allow_underscores,
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    const NumberFormat& number_format = NumberFormat()
+) noexcept(false);
+
+/**
+ * \brief Create an empty sketch of numbers
+ *
+ * \param k The size of the top level of the quantile sketch
+ * \param precision The number of bits that choose a register of the
+ *                  distinct value estimator
+ * \return A new python object holding the sketch
+ */
+PyObject* sketch_impl(PyObject* k, PyObject* precision) noexcept(false);
+
+/**
+ * \brief Convert the values of a collection and add them to a sketch
+ *
+ * Each element is converted to a double as for array_impl, and NaN
+ * (including failures replaced with NaN) is only counted.
+ *
+ * \param sketch The sketch from sketch_impl
+ * \param input The iterable to convert
+ * \param inf Replacement to use for infinity
+ * \param nan Replacement to use for NaN
+ * \param on_fail Replacement to use on conversion failure
+ * \param on_type_error Replacement to use on type error
+ * \param allow_underscores Whether or not to accept underscores in strings
+ * \param allow_hex_float Whether or not to accept hexadecimal floats in strings
+ * \param allow_fraction Whether or not to accept rational numbers in strings
+ * \param assume_valid Whether or not strings are trusted to be valid numbers
+ * \param number_format The locale-style format in which strings are written
+ */
+void sketch_update_impl(
+    PyObject* sketch,
+    PyObject* input,
+    PyObject* inf,
+    PyObject* nan,
+    PyObject* on_fail,
+    PyObject* on_type_error,
+    bool allow_underscores,
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    const NumberFormat& number_format = NumberFormat()
+) noexcept(false);
+
+/**
+ * \brief Add the values of an already converted array to a sketch
+ *
+ * This lets the values that e.g. try_array placed in an array be added
+ * without converting them again. NaN values are only counted.
+ *
+ * \param sketch The sketch from sketch_impl
+ * \param values A one-dimensional array of integral or float type
+ */
+void sketch_add_impl(PyObject* sketch, PyObject* values) noexcept(false);
+
+/**
+ * \brief Add the values of one sketch to another
+ *
+ * \param sketch The sketch to which to add
+ * \param other The sketch whose values to add, which must have the same precision
+ */
+void sketch_merge_impl(PyObject* sketch, PyObject* other) noexcept(false);
+
+/**
+ * \brief Estimate quantiles of the values of a sketch
+ *
+ * \param sketch The sketch
+ * \param quantiles A sequence of fractions between 0 and 1
+ * \return A new list of the estimated quantile of each fraction
+ */
+PyObject*
+sketch_quantiles_impl(PyObject* sketch, PyObject* quantiles) noexcept(false);
+
+/**
+ * \brief Summarize the values of a sketch
+ *
+ * \param sketch The sketch
+ * \return A new tuple of the count, the NaN count, the minimum, the maximum,
+ *         and the estimated number of distinct values
+ */
+PyObject* sketch_summary_impl(PyObject* sketch) noexcept(false);
+
+/**
+ * \brief Serialize a sketch
+ *
+ * \param sketch The sketch
+ * \return A new bytes object from which sketch_loads_impl can recreate it
+ */
+PyObject* sketch_dumps_impl(PyObject* sketch) noexcept(false);
+
+/**
+ * \brief Recreate a sketch serialized by sketch_dumps_impl
+ *
+ * \param data A bytes-like object
+ * \return A new python object holding the sketch
+ */
+PyObject* sketch_loads_impl(PyObject* data) noexcept(false);
\ No newline at end of file
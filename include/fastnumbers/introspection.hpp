@@ -1,9 +1,23 @@
 #pragma once
 
+#include <complex>
+
 /// Return a string form of the given type
 template <typename T>
 constexpr inline const char* type_name() noexcept;
 
+template <>
+constexpr inline const char* type_name<std::complex<double>>() noexcept
+{
+    return "double complex";
+}
+
+template <>
+constexpr inline const char* type_name<std::complex<float>>() noexcept
+{
+    return "float complex";
+}
+
 template <>
 constexpr inline const char* type_name<double>() noexcept
 {
@@ -137,6 +137,26 @@ public:
         m_index += 1;
     }
 
+    /// The index at which the next value will be placed
+    Py_ssize_t index() const noexcept { return m_index; }
+
+    /// The start of the buffer data
+    template <typename T>
+    T* data() noexcept
+    {
+        return static_cast<T*>(m_buf.buf);
+    }
+
+    /// The distance between elements of the buffer, in elements
+    Py_ssize_t stride() const noexcept { return m_stride; }
+
+    /// Access an already placed value of the buffer
+    template <typename T>
+    T& at(const Py_ssize_t index) noexcept
+    {
+        return *(static_cast<T*>(m_buf.buf) + (index * m_stride));
+    }
+
 private:
     /// The buffer where the data should be added
     Py_buffer& m_buf;
@@ -316,6 +336,27 @@ public:
         IterState m_state;
     };
 
+    /**
+     * \brief Can the items be looked up again by their position?
+     *
+     * This is true for a list or tuple, and for any iterable that
+     * get_size() had to copy into a list. Other sequences may look up
+     * items by something other than position (e.g. a pandas Series).
+     */
+    bool is_fast_sequence() const noexcept { return m_fast_sequence != nullptr; }
+
+    /**
+     * \brief Return a new reference to the item at the given position
+     *
+     * This is only valid if is_fast_sequence() is true.
+     */
+    PyObject* get_item(const Py_ssize_t index) const noexcept
+    {
+        PyObject* item = PySequence_Fast_GET_ITEM(m_fast_sequence, index);
+        Py_INCREF(item);
+        return item;
+    }
+
     /// Convenient name for the ItemIterator
     typedef ItemIterator iterator;
 
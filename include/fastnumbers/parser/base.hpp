@@ -88,6 +88,15 @@ public:
         const bool force_int = false, const bool coerce = false
     ) const noexcept(false) = 0;
 
+    /// Convert the stored object to a python complex
+    virtual RawPayload<PyObject*> as_pycomplex() const noexcept(false) = 0;
+
+    /// Convert the stored object to a python fractions.Fraction
+    virtual RawPayload<PyObject*> as_pyfraction() const noexcept(false) = 0;
+
+    /// Convert the stored object to a python decimal.Decimal
+    virtual RawPayload<PyObject*> as_pydecimal() const noexcept(false) = 0;
+
     /// Check the type of the number.
     virtual NumberFlags get_number_type() const noexcept { return m_number_type; }
 
@@ -128,6 +137,24 @@ public:
         const StringChecker& checker, const bool is_negative
     ) noexcept;
 
+    /**
+     * \brief The fractions.Fraction class
+     *
+     * The module is imported on first use and kept for the life of the process.
+     *
+     * \return A borrowed reference, or NULL with a Python exception set
+     */
+    static PyObject* fraction_type() noexcept;
+
+    /**
+     * \brief The decimal.Decimal class
+     *
+     * The module is imported on first use and kept for the life of the process.
+     *
+     * \return A borrowed reference, or NULL with a Python exception set
+     */
+    static PyObject* decimal_type() noexcept;
+
 protected:
     /// Constructor for use only by base-classes to define the parser type
     /// and base requirements
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <complex>
 #include <cstring>
 #include <vector>
 
@@ -49,6 +50,15 @@ public:
         const bool force_int = false, const bool coerce = false
     ) const noexcept(false) override;
 
+    /// Convert the stored object to a python complex
+    RawPayload<PyObject*> as_pycomplex() const noexcept(false) override;
+
+    /// Convert the stored object to a python fractions.Fraction
+    RawPayload<PyObject*> as_pyfraction() const noexcept(false) override;
+
+    /// Convert the stored object to a python decimal.Decimal
+    RawPayload<PyObject*> as_pydecimal() const noexcept(false) override;
+
     /// Check the type of the number.
     NumberFlags get_number_type() const noexcept override;
 
@@ -82,6 +92,12 @@ public:
     template <typename T, typename std::enable_if_t<std::is_integral_v<T>, bool> = true>
     RawPayload<T> as_number() const noexcept(false)
     {
+        // Trusted strings that cannot overflow go straight to the digits
+        const bool negative_unsigned = std::is_unsigned_v<T> && is_negative();
+        if (!negative_unsigned && trusted_base10_int(overflow_cutoff<T>())) {
+            return parse_int_unchecked<T>(signed_start(), end());
+        }
+
         bool error;
         bool overflow;
         constexpr bool always_convert = true;
@@ -128,6 +144,11 @@ public:
         typename std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
     RawPayload<T> as_number() const noexcept(false)
     {
+        // Hexadecimal floats have their own grammar
+        if (options().allow_hex_float() && has_hex_prefix(m_start, m_str_len)) {
+            return as_hex_float<T>();
+        }
+
         bool error;
         T result = parse_float<T>(signed_start(), end(), error);
 
@@ -138,8 +159,12 @@ public:
             result = parse_float<T>(buffer.start(), buffer.end(), error);
         }
 
-        // If there is still an error then it is real
+        // If there is still an error then it is real,
+        // unless it is a rational number such as "3/4"
         if (error) {
+            if (options().allow_fraction()) {
+                return as_rational<T>();
+            }
             return ErrorType::BAD_VALUE;
         }
 
@@ -147,6 +172,37 @@ public:
         return static_cast<T>(result);
     }
 
+    /**
+     * \brief Convert the contained value into a number C++
+     *
+     * This template specialization is for complex types. The whole
+     * original string is parsed, since a complex number can be in
+     * parentheses and its sign may belong to either part.
+     */
+    template <typename T, typename std::enable_if_t<is_complex_v<T>, bool> = true>
+    RawPayload<T> as_number() const noexcept(false)
+    {
+        using V = typename T::value_type;
+        V real;
+        V imag;
+        bool error;
+        parse_complex(m_start_orig, m_end_orig, real, imag, error);
+
+        // If an error occured because of underscores, remove them and re-parse
+        const std::size_t len = static_cast<std::size_t>(m_end_orig - m_start_orig);
+        if (error && options().allow_underscores() && std::memchr(m_start_orig, '_', len)) {
+            Buffer buffer(m_start_orig, len);
+            buffer.remove_valid_underscores();
+            parse_complex(buffer.start(), buffer.end(), real, imag, error);
+        }
+
+        // If there is still an error then it is real
+        if (error) {
+            return ErrorType::BAD_VALUE;
+        }
+        return T(real, imag);
+    }
+
     /**
      * \brief Convert the contained value into a number C++
      *
@@ -172,6 +228,18 @@ private:
     std::size_t m_str_len;
 
 private:
+    /**
+     * \brief Check if the string can be parsed as an int without validation
+     *
+     * This is only when the user promised valid strings, the base is 10,
+     * and there are few enough digits that the result cannot overflow.
+     */
+    bool trusted_base10_int(const std::size_t max_digits) const noexcept
+    {
+        return options().assume_valid() && options().get_base() == 10
+            && m_str_len <= max_digits;
+    }
+
     /// Check if the character array contains valid underscores
     bool has_valid_underscores() const noexcept
     {
@@ -179,6 +247,119 @@ private:
             && std::memchr(m_start, '_', m_str_len);
     }
 
+    /// Convert the contained hexadecimal float into a number C++
+    template <typename T>
+    RawPayload<T> as_hex_float() const noexcept
+    {
+        bool error;
+        bool overflow;
+        const T result = parse_hex_float<T>(m_start, end(), error, overflow);
+        if (error) {
+            return ErrorType::BAD_VALUE;
+        } else if (overflow) {
+            return ErrorType::OVERFLOW_;
+        }
+        return is_negative() ? -result : result;
+    }
+
+    /**
+     * \brief Find the parts of the contained rational number such as "1 1/2"
+     *
+     * If underscores are allowed and present, they are removed into the
+     * given buffer, which then owns the characters of the parts.
+     *
+     * \return false if the string is not a rational number, otherwise true
+     */
+    bool read_rational_parts(RationalParts& parts, Buffer& buffer) const noexcept(false)
+    {
+        if (read_rational(m_start, end(), parts)) {
+            return true;
+        } else if (!has_valid_underscores()) {
+            return false;
+        }
+        buffer.copy(m_start, m_str_len);
+        buffer.remove_valid_underscores();
+        return read_rational(buffer.start(), buffer.end(), parts);
+    }
+
+    /// Convert the contained rational number into a number C++
+    template <typename T>
+    RawPayload<T> as_rational() const noexcept(false)
+    {
+        RationalParts parts;
+        Buffer buffer;
+        if (!read_rational_parts(parts, buffer)) {
+            return ErrorType::BAD_VALUE;
+        }
+
+        // Use the fast path when exact, otherwise fall back on Python ints
+        T result;
+        bool zero_division;
+        if (!rational_to_float(parts, result, zero_division)) {
+            if (zero_division) {
+                return ErrorType::BAD_VALUE;
+            }
+            const RawPayload<double> big
+                = rational_as_double(parts, std::is_same_v<T, float>);
+            if (std::holds_alternative<ErrorType>(big)) {
+                return std::get<ErrorType>(big);
+            }
+            result = static_cast<T>(std::get<double>(big));
+        }
+
+        // A rational zero is exact, so like fractions.Fraction it has no
+        // negative zero, but a negative quotient that underflows keeps its sign
+        const bool exact_zero = result == T(0) && parts.is_zero();
+        return is_negative() && !exact_zero ? -result : result;
+    }
+
+    /**
+     * \brief Create Python ints for the numerator and denominator of a rational
+     *
+     * The numerator includes the whole part. No more digits than allowed
+     * by ConversionLimits are converted.
+     *
+     * \return false with a Python exception set on failure, otherwise true
+     */
+    static bool rational_as_pylongs(
+        const RationalParts& parts, PyObject*& numerator, PyObject*& denominator
+    ) noexcept;
+
+    /**
+     * \brief Divide a rational number of any size with Python ints
+     *
+     * Python's int true division is correctly rounded. A zero denominator
+     * or too many digits is a BAD_VALUE, and a too large result is OVERFLOW_.
+     * If the result is to be narrowed to float, a quotient that is exactly
+     * halfway between two floats is moved toward the exact quotient, as
+     * rational_to_float does, so that it is not rounded twice.
+     */
+    static RawPayload<double>
+    rational_as_double(const RationalParts& parts, const bool narrow = false)
+        noexcept(false);
+
+    /**
+     * \brief Compare a Python float with the exact quotient of two Python ints
+     *
+     * \return 1 if the float is larger, -1 if it is smaller, 0 if they are
+     *         equal, or -2 with a Python exception set on failure
+     */
+    static int
+    compare_to_quotient(PyObject* value, PyObject* numerator, PyObject* denominator)
+        noexcept;
+
+    /**
+     * \brief Create Python ints for the exact fraction of a decimal number
+     *
+     * The numerator is the digits of the number, and the denominator
+     * is the power of ten implied by the decimal point and exponent.
+     *
+     * \return false with a Python exception set on failure, otherwise true
+     */
+    static bool decimal_as_pylongs(
+        const StringChecker& checker, PyObject*& numerator, PyObject*& denominator
+    ) noexcept(false);
+
     /// Check if the character array contains invalid underscores
     bool has_invalid_underscores() const noexcept
     {
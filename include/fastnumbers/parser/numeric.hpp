@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <complex>
 #include <type_traits>
 
 #include <Python.h>
@@ -32,6 +33,16 @@ public:
         // more effort getting the sign for all cases.
         if (flags & NumberType::Float && !(flags & NumberType::User)) {
             set_negative(get_double() < 0);
+        } else if (flags & (NumberType::Infinity | NumberType::NaN)) {
+            // Infinity and NaN are replaced rather than converted, so the
+            // sign is also needed for objects like decimal.Decimal("-inf").
+            const double value = PyFloat_AsDouble(m_obj);
+            if (value == -1.0 && PyErr_Occurred()) {
+                // Retrieving the value later will expose the error
+                PyErr_Clear();
+            } else {
+                set_negative(std::signbit(value));
+            }
         }
     }
 
@@ -84,6 +95,80 @@ public:
         }
     }
 
+    /// Convert the stored object to a python complex
+    RawPayload<PyObject*> as_pycomplex() const noexcept(false) override
+    {
+        if (PyComplex_CheckExact(m_obj)) {
+            Py_INCREF(m_obj);
+            return m_obj;
+        }
+
+        // Let Python handle __complex__, __float__, and __index__. Errors other
+        // than bad types (e.g. overflow) are left set to be raised as-is.
+        const Py_complex value = PyComplex_AsCComplex(m_obj);
+        if (value.real == -1.0 && PyErr_Occurred()) {
+            if (PyErr_ExceptionMatches(PyExc_TypeError)) {
+                PyErr_Clear();
+                return ErrorType::TYPE_ERROR;
+            }
+            return nullptr;
+        }
+        return PyComplex_FromCComplex(value);
+    }
+
+    /// Convert the stored object to a python fractions.Fraction
+    RawPayload<PyObject*> as_pyfraction() const noexcept(false) override
+    {
+        PyObject* fraction = Parser::fraction_type();
+        if (fraction == nullptr) {
+            return nullptr;
+        }
+
+        // Let Fraction handle ints, floats, Decimals and other Rationals.
+        // Errors other than bad types (e.g. NaN or infinity) are left set.
+        PyObject* result = PyObject_CallFunctionObjArgs(fraction, m_obj, nullptr);
+        if (result == nullptr && PyErr_ExceptionMatches(PyExc_TypeError)) {
+            PyErr_Clear();
+            return ErrorType::TYPE_ERROR;
+        }
+        return result;
+    }
+
+    /// Convert the stored object to a python decimal.Decimal
+    RawPayload<PyObject*> as_pydecimal() const noexcept(false) override
+    {
+        PyObject* decimal = Parser::decimal_type();
+        if (decimal == nullptr) {
+            return nullptr;
+        } else if (Py_IS_TYPE(m_obj, reinterpret_cast<PyTypeObject*>(decimal))) {
+            Py_INCREF(m_obj);
+            return m_obj;
+        } else if (get_number_type() == static_cast<NumberFlags>(NumberType::INVALID)) {
+            return ErrorType::TYPE_ERROR;
+        }
+
+        // Decimal itself accepts int, float and Decimal. Other objects that
+        // behave like numbers are first made into an int or float.
+        PyObject* value = nullptr;
+        if (PyLong_Check(m_obj) || PyFloat_Check(m_obj)
+            || PyObject_IsInstance(m_obj, decimal) == 1) {
+            Py_INCREF(m_obj);
+            value = m_obj;
+        } else if (get_number_type() & NumberType::Integer) {
+            value = PyNumber_Long(m_obj);
+        } else {
+            value = PyNumber_Float(m_obj);
+        }
+        PyObject* result
+            = value == nullptr ? nullptr : PyObject_Vectorcall(decimal, &value, 1, nullptr);
+        Py_XDECREF(value);
+        if (result == nullptr && PyErr_ExceptionMatches(PyExc_TypeError)) {
+            PyErr_Clear();
+            return ErrorType::TYPE_ERROR;
+        }
+        return result;
+    }
+
     /// Check the type of the number.
     NumberFlags get_number_type() const noexcept override
     {
@@ -134,8 +219,24 @@ public:
     template <typename T>
     RawPayload<T> as_number() const noexcept
     {
+        // Special handling for complex numbers
+        if constexpr (is_complex_v<T>) {
+            // Let Python handle __complex__, __float__, and __index__.
+            const Py_complex value = PyComplex_AsCComplex(m_obj);
+            if (value.real == -1.0 && PyErr_Occurred()) {
+                const ErrorType err = PyErr_ExceptionMatches(PyExc_TypeError)
+                    ? ErrorType::TYPE_ERROR
+                    : (PyErr_ExceptionMatches(PyExc_OverflowError) ? ErrorType::OVERFLOW_
+                                                                    : ErrorType::BAD_VALUE);
+                PyErr_Clear();
+                return err;
+            }
+            using V = typename T::value_type;
+            return T(static_cast<V>(value.real), static_cast<V>(value.imag));
+        }
+
         // Special handling for floating point numbers
-        if constexpr (std::is_floating_point_v<T>) {
+        else if constexpr (std::is_floating_point_v<T>) {
             // Fast path if we know it is not numeric
             if (!(get_number_type() & (NumberType::Float | NumberType::Integer))) {
                 return ErrorType::TYPE_ERROR;
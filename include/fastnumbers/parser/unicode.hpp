@@ -1,5 +1,6 @@
 #pragma once
 
+#include <complex>
 #include <limits>
 #include <type_traits>
 
@@ -80,6 +81,61 @@ public:
         }
     }
 
+    /// Convert the stored object to a python complex
+    RawPayload<PyObject*> as_pycomplex() const noexcept(false) override
+    {
+        const NumberFlags ntype = get_number_type();
+
+        // Quit here if not a valid number
+        if (!(ntype & (NumberType::Integer | NumberType::Float))) {
+            return ErrorType::BAD_VALUE;
+        }
+        const double value = (ntype & NumberType::Integer)
+            ? static_cast<double>(m_digit)
+            : m_numeric;
+        return PyComplex_FromDoubles(value, 0.0);
+    }
+
+    /// Convert the stored object to a python fractions.Fraction
+    RawPayload<PyObject*> as_pyfraction() const noexcept(false) override
+    {
+        // Only digits are exact, other numeric characters like vulgar fractions are not
+        if (!(get_number_type() & NumberType::Integer)) {
+            return ErrorType::BAD_VALUE;
+        }
+        PyObject* fraction = Parser::fraction_type();
+        if (fraction == nullptr) {
+            return nullptr;
+        }
+        PyObject* digit = pyobject_from_int(m_digit);
+        if (digit == nullptr) {
+            return nullptr;
+        }
+        PyObject* result = PyObject_CallFunctionObjArgs(fraction, digit, nullptr);
+        Py_DECREF(digit);
+        return result;
+    }
+
+    /// Convert the stored object to a python decimal.Decimal
+    RawPayload<PyObject*> as_pydecimal() const noexcept(false) override
+    {
+        // Only digits are valid, like for Decimal itself
+        if (!(get_number_type() & NumberType::Integer)) {
+            return ErrorType::BAD_VALUE;
+        }
+        PyObject* decimal = Parser::decimal_type();
+        if (decimal == nullptr) {
+            return nullptr;
+        }
+        PyObject* digit = pyobject_from_int(m_digit);
+        if (digit == nullptr) {
+            return nullptr;
+        }
+        PyObject* result = PyObject_Vectorcall(decimal, &digit, 1, nullptr);
+        Py_DECREF(digit);
+        return result;
+    }
+
     /// Check the type of the number.
     NumberFlags get_number_type() const noexcept override
     {
@@ -147,6 +203,28 @@ public:
         return static_cast<T>((ntype & NumberType::Integer) ? m_digit : m_numeric);
     }
 
+    /**
+     * \brief Convert the contained value into a number C++
+     *
+     * This template specialization is for complex types.
+     */
+    template <typename T, typename std::enable_if_t<is_complex_v<T>, bool> = true>
+    RawPayload<T> as_number() const noexcept
+    {
+        using V = typename T::value_type;
+        return std::visit(
+            overloaded {
+                [](const V value) -> RawPayload<T> {
+                    return T(value, static_cast<V>(0.0));
+                },
+                [](const ErrorType err) -> RawPayload<T> {
+                    return err;
+                },
+            },
+            as_number<V>()
+        );
+    }
+
     /**
      * \brief Convert the contained value into a number C++
      *
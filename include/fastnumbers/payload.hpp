@@ -14,9 +14,15 @@ enum class ActionType {
     NEG_INF_ACTION, ///< Return negative infinity
     ERROR_INVALID_INT, ///< Raise invalid int exception
     ERROR_INVALID_FLOAT, ///< Raise invalid float exception
+    ERROR_INVALID_COMPLEX, ///< Raise invalid complex exception
+    ERROR_INVALID_FRACTION, ///< Raise invalid fraction exception
+    ERROR_INVALID_DECIMAL, ///< Raise invalid decimal exception
     ERROR_INVALID_BASE, ///< Raise invalid base exception
     ERROR_BAD_TYPE_INT, ///< Raise invalid type for int
     ERROR_BAD_TYPE_FLOAT, ///< Raise invalid type for float
+    ERROR_BAD_TYPE_COMPLEX, ///< Raise invalid type for complex
+    ERROR_BAD_TYPE_FRACTION, ///< Raise invalid type for fraction
+    ERROR_BAD_TYPE_DECIMAL, ///< Raise invalid type for decimal
     ERROR_ILLEGAL_EXPLICIT_BASE, ///< Raise illegal explict base exception
 };
 
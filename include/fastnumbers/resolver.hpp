@@ -1,5 +1,6 @@
 #pragma once
 
+#include <initializer_list>
 #include <utility>
 #include <variant>
 
@@ -8,6 +9,7 @@
 #include "fastnumbers/helpers.hpp"
 #include "fastnumbers/payload.hpp"
 #include "fastnumbers/selectors.hpp"
+#include "fastnumbers/tracing.hpp"
 #include "fastnumbers/user_options.hpp"
 
 /**
@@ -27,6 +29,10 @@ public:
         , m_nan(Selectors::ALLOWED)
         , m_fail(Selectors::RAISE)
         , m_type_error(Selectors::RAISE)
+        , m_pos_inf(Selectors::POS_INFINITY)
+        , m_neg_inf(Selectors::NEG_INFINITY)
+        , m_pos_nan(Selectors::POS_NAN)
+        , m_neg_nan(Selectors::NEG_NAN)
         , m_base(base)
     { }
 
@@ -36,6 +42,10 @@ public:
         , m_nan(Selectors::incref(rhs.m_nan))
         , m_fail(Selectors::incref(rhs.m_fail))
         , m_type_error(Selectors::incref(rhs.m_type_error))
+        , m_pos_inf(rhs.m_pos_inf)
+        , m_neg_inf(rhs.m_neg_inf)
+        , m_pos_nan(rhs.m_pos_nan)
+        , m_neg_nan(rhs.m_neg_nan)
         , m_base(rhs.m_base)
     { }
 
@@ -45,6 +55,10 @@ public:
         , m_nan(std::exchange(rhs.m_nan, nullptr))
         , m_fail(std::exchange(rhs.m_fail, nullptr))
         , m_type_error(std::exchange(rhs.m_type_error, nullptr))
+        , m_pos_inf(rhs.m_pos_inf)
+        , m_neg_inf(rhs.m_neg_inf)
+        , m_pos_nan(rhs.m_pos_nan)
+        , m_neg_nan(rhs.m_neg_nan)
         , m_base(std::exchange(rhs.m_base, 0))
     { }
 
@@ -60,6 +74,26 @@ public:
         Selectors::decref(m_type_error);
     };
 
+    /// Visit the Python objects held by the Resolver, for the garbage collector
+    int traverse(visitproc visit, void* arg) const noexcept
+    {
+        for (PyObject* obj : { m_inf, m_nan, m_fail, m_type_error }) {
+            if (!Selectors::is_selector(obj)) {
+                Py_VISIT(obj);
+            }
+        }
+        return 0;
+    }
+
+    /// Release the Python objects held by the Resolver, restoring the defaults
+    void clear() noexcept
+    {
+        Selectors::decref(std::exchange(m_inf, Selectors::ALLOWED));
+        Selectors::decref(std::exchange(m_nan, Selectors::ALLOWED));
+        Selectors::decref(std::exchange(m_fail, Selectors::RAISE));
+        Selectors::decref(std::exchange(m_type_error, Selectors::RAISE));
+    }
+
     /// Define how a value of infinity will be interpreted
     void set_inf_action(PyObject* inf_value) noexcept
     {
@@ -72,6 +106,22 @@ public:
         m_nan = Selectors::incref(nan_value);
     }
 
+    /**
+     * \brief Define the values returned when infinity or NaN is ALLOWED
+     *
+     * The defaults are Python floats. The values are borrowed, so they
+     * must live at least as long as the Resolver.
+     */
+    void set_allowed_inf_nan(
+        PyObject* pos_inf, PyObject* neg_inf, PyObject* pos_nan, PyObject* neg_nan
+    ) noexcept
+    {
+        m_pos_inf = pos_inf;
+        m_neg_inf = neg_inf;
+        m_pos_nan = pos_nan;
+        m_neg_nan = neg_nan;
+    }
+
     /// Define how a conversion failure will be interpreted
     void set_fail_action(PyObject* fail_value) noexcept
     {
@@ -122,6 +172,9 @@ public:
                     // These actions are indicative of TypeErrors
                     case ActionType::ERROR_BAD_TYPE_INT:
                     case ActionType::ERROR_BAD_TYPE_FLOAT:
+                    case ActionType::ERROR_BAD_TYPE_COMPLEX:
+                    case ActionType::ERROR_BAD_TYPE_FRACTION:
+                    case ActionType::ERROR_BAD_TYPE_DECIMAL:
                     case ActionType::ERROR_ILLEGAL_EXPLICIT_BASE:
                         return type_error_action(input, atype);
 
@@ -147,6 +200,18 @@ private:
     /// The desired return action for invalid types
     PyObject* m_type_error;
 
+    /// The value returned for positive infinity when it is allowed
+    PyObject* m_pos_inf;
+
+    /// The value returned for negative infinity when it is allowed
+    PyObject* m_neg_inf;
+
+    /// The value returned for positive NaN when it is allowed
+    PyObject* m_pos_nan;
+
+    /// The value returned for negative NaN when it is allowed
+    PyObject* m_neg_nan;
+
     /// Desired integer base - used in error message generation
     int m_base;
 
@@ -187,13 +252,12 @@ private:
     {
         PyObject* my_inf = inf_obj(input);
         if (my_inf == Selectors::ALLOWED) {
-            return increment_reference(
-                negative ? Selectors::NEG_INFINITY : Selectors::POS_INFINITY
-            );
+            return increment_reference(negative ? m_neg_inf : m_pos_inf);
         } else if (my_inf == Selectors::RAISE) {
             PyErr_SetString(PyExc_ValueError, "infinity is disallowed");
             return nullptr;
         } else if (PyCallable_Check(my_inf)) {
+            FN_TRACE2(callback__invoke, my_inf, input);
             return PyObject_CallFunctionObjArgs(my_inf, input, nullptr);
         } else { // handles INPUT and a custom default value
             return increment_reference(my_inf);
@@ -205,13 +269,12 @@ private:
     {
         PyObject* my_nan = nan_obj(input);
         if (my_nan == Selectors::ALLOWED) {
-            return increment_reference(
-                negative ? Selectors::NEG_NAN : Selectors::POS_NAN
-            );
+            return increment_reference(negative ? m_neg_nan : m_pos_nan);
         } else if (my_nan == Selectors::RAISE) {
             PyErr_SetString(PyExc_ValueError, "NaN is disallowed");
             return nullptr;
         } else if (PyCallable_Check(my_nan)) {
+            FN_TRACE2(callback__invoke, my_nan, input);
             return PyObject_CallFunctionObjArgs(my_nan, input, nullptr);
         } else { // handles INPUT and a custom default value
             return increment_reference(my_nan);
@@ -254,6 +317,7 @@ private:
     {
         PyErr_Clear();
         if (PyCallable_Check(actionable)) {
+            FN_TRACE2(callback__invoke, actionable, input);
             return PyObject_CallFunctionObjArgs(actionable, input, nullptr);
         } else { // handles INPUT and a custom default value
             return increment_reference(actionable);
@@ -284,6 +348,31 @@ private:
             );
             break;
 
+        case ActionType::ERROR_BAD_TYPE_COMPLEX:
+            // Raise an exception due passing an invalid type to convert to a complex
+            PyErr_Format(
+                PyExc_TypeError,
+                "complex() first argument must be a string or a number, not '%s'",
+                Py_TYPE(input)->tp_name
+            );
+            break;
+
+        case ActionType::ERROR_BAD_TYPE_FRACTION:
+            // Raise an exception due passing an invalid type to convert to a fraction
+            PyErr_SetString(
+                PyExc_TypeError, "argument should be a string or a Rational instance"
+            );
+            break;
+
+        case ActionType::ERROR_BAD_TYPE_DECIMAL:
+            // Raise an exception due passing an invalid type to convert to a decimal
+            PyErr_Format(
+                PyExc_TypeError,
+                "conversion from %s to Decimal is not supported",
+                Py_TYPE(input)->tp_name
+            );
+            break;
+
         case ActionType::ERROR_INVALID_INT:
             // Raise an exception due to an invalid integer
             PyErr_Format(
@@ -301,6 +390,23 @@ private:
             );
             break;
 
+        case ActionType::ERROR_INVALID_COMPLEX:
+            // Raise an exception due to an invalid complex
+            PyErr_SetString(PyExc_ValueError, "complex() arg is a malformed string");
+            break;
+
+        case ActionType::ERROR_INVALID_FRACTION:
+            // Raise an exception due to an invalid fraction
+            PyErr_Format(PyExc_ValueError, "Invalid literal for Fraction: %.200R", input);
+            break;
+
+        case ActionType::ERROR_INVALID_DECIMAL:
+            // Raise an exception due to an invalid decimal
+            PyErr_Format(
+                PyExc_ValueError, "could not convert string to Decimal: %.200R", input
+            );
+            break;
+
         default:
             // ERROR_ILLEGAL_EXPLICIT_BASE
             // ERROR_INVALID_BASE
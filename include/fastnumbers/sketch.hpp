@@ -0,0 +1,601 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "fastnumbers/content_hash.hpp"
+#include "fastnumbers/third_party/fast_float.h"
+
+/**
+ * \class HyperLogLog
+ * \brief Estimate the number of distinct values from their 64-bit hashes
+ *
+ * The first "precision" bits of a hash choose a register, which keeps the
+ * largest number of leading zeros (plus one) seen in the rest of the bits.
+ * The estimate is made with the improved estimator of Ertl (2017), which
+ * needs no bias correction tables and is accurate at all cardinalities.
+ * The standard error is about 1.04 / sqrt(2 ** precision).
+ */
+class HyperLogLog {
+public:
+    static constexpr int MIN_PRECISION = 4;
+    static constexpr int MAX_PRECISION = 18;
+
+    /// Start with no values, with 2 ** precision registers
+    explicit HyperLogLog(const int precision) noexcept(false)
+        : m_precision(precision)
+        , m_registers(std::size_t(1) << precision, 0)
+    { }
+
+    /// The number of bits of the hash that choose the register
+    int precision() const noexcept { return m_precision; }
+
+    /// The registers, one byte each
+    const std::vector<uint8_t>& registers() const noexcept { return m_registers; }
+
+    /// The largest value a register can hold
+    uint8_t max_register() const noexcept
+    {
+        return static_cast<uint8_t>(65 - m_precision);
+    }
+
+    /// Add the hash of a value
+    void add(const uint64_t hash) noexcept
+    {
+        const auto index = static_cast<std::size_t>(hash >> (64 - m_precision));
+
+        // A bit just past the end of the hash keeps the count finite
+        const uint64_t sentinel = uint64_t(1) << (m_precision - 1);
+        const uint64_t rest = (hash << m_precision) | sentinel;
+        const auto rank = static_cast<uint8_t>(fast_float::leading_zeroes(rest) + 1);
+        m_registers[index] = std::max(m_registers[index], rank);
+    }
+
+    /// Add the values of another estimator of the same precision
+    void merge(const HyperLogLog& other) noexcept
+    {
+        for (std::size_t i = 0; i < m_registers.size(); ++i) {
+            m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+        }
+    }
+
+    /// Replace the registers, returning false if they are not valid
+    bool load(const uint8_t* data) noexcept
+    {
+        const uint8_t* end = data + m_registers.size();
+        if (std::any_of(data, end, [this](uint8_t r) { return r > max_register(); })) {
+            return false;
+        }
+        std::copy(data, end, m_registers.begin());
+        return true;
+    }
+
+    /// Estimate the number of distinct values
+    double estimate() const noexcept(false)
+    {
+        // Count the registers of each value
+        const int q = 64 - m_precision;
+        std::vector<double> histogram(static_cast<std::size_t>(q + 2), 0.0);
+        for (const uint8_t value : m_registers) {
+            histogram[value] += 1.0;
+        }
+
+        const auto m = static_cast<double>(m_registers.size());
+        double z = m * tau(1.0 - histogram[static_cast<std::size_t>(q + 1)] / m);
+        for (int k = q; k >= 1; --k) {
+            z = 0.5 * (z + histogram[static_cast<std::size_t>(k)]);
+        }
+        z += m * sigma(histogram[0] / m);
+        return ALPHA_INF * m * m / z;
+    }
+
+private:
+    /// The number of bits of the hash that choose the register
+    int m_precision;
+
+    /// The registers
+    std::vector<uint8_t> m_registers;
+
+    /// The bias correction of the estimator, 1 / (2 ln 2)
+    static constexpr double ALPHA_INF = 0.72134752044448170368;
+
+    /// Correction for the registers that are still zero
+    static double sigma(double x) noexcept
+    {
+        if (x == 1.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        double y = 1.0;
+        double z = x;
+        double previous;
+        do {
+            x *= x;
+            previous = z;
+            z += x * y;
+            y += y;
+        } while (z != previous);
+        return z;
+    }
+
+    /// Correction for the registers that are full
+    static double tau(double x) noexcept
+    {
+        if (x == 0.0 || x == 1.0) {
+            return 0.0;
+        }
+        double y = 1.0;
+        double z = 1.0 - x;
+        double previous;
+        do {
+            x = std::sqrt(x);
+            previous = z;
+            y *= 0.5;
+            z -= (1.0 - x) * (1.0 - x) * y;
+        } while (z != previous);
+        return z / 3.0;
+    }
+};
+
+/**
+ * \class KllSketch
+ * \brief Estimate the quantiles of a stream of numbers in bounded memory
+ *
+ * This is the KLL sketch of Karnin, Lang, and Liberty (2016). Values are
+ * kept in a stack of compactors, where each value at level h stands for
+ * 2 ** h of the original values. When the sketch is full, the lowest level
+ * over its capacity is sorted and every other value (starting at random
+ * at the first or second) moves up a level. The capacity of the levels
+ * shrinks geometrically going down from the top level, which has "k".
+ *
+ * The rank error is about 1.7 / k. The coin flips come from a fixed seed,
+ * so that the same values always give the same sketch.
+ */
+class KllSketch {
+public:
+    static constexpr std::size_t MIN_K = 8;
+    static constexpr std::size_t MAX_K = 65535;
+
+    /// The most levels, which is enough for 2 ** 63 values
+    static constexpr std::size_t MAX_LEVELS = 64;
+
+    /// Start with no values
+    explicit KllSketch(const std::size_t k) noexcept(false)
+        : m_k(k)
+        , m_levels(1)
+        , m_retained(0)
+        , m_capacities()
+        , m_capacity(0)
+        , m_coin(SEED)
+    {
+        update_capacities();
+    }
+
+    /// The size of the top level
+    std::size_t k() const noexcept { return m_k; }
+
+    /// The values of each level
+    const std::vector<std::vector<double>>& levels() const noexcept { return m_levels; }
+
+    /// The state of the coin
+    uint64_t coin() const noexcept { return m_coin; }
+
+    /// Add a value
+    void add(const double value) noexcept(false)
+    {
+        m_levels[0].push_back(value);
+        m_retained += 1;
+        if (m_retained >= m_capacity) {
+            compress();
+        }
+    }
+
+    /// Add the values of another sketch, which may be this one
+    void merge(const KllSketch& other) noexcept(false)
+    {
+        // A vector's own elements cannot be inserted into it, so a sketch
+        // that is merged into itself is copied first
+        if (&other == this) {
+            const KllSketch copy(other);
+            merge(copy);
+            return;
+        }
+        while (m_levels.size() < other.m_levels.size()) {
+            grow();
+        }
+        for (std::size_t h = 0; h < other.m_levels.size(); ++h) {
+            const auto& source = other.m_levels[h];
+            m_levels[h].insert(m_levels[h].end(), source.begin(), source.end());
+            m_retained += source.size();
+        }
+        while (m_retained >= m_capacity) {
+            compress();
+        }
+    }
+
+    /// Replace the levels and coin, e.g. with those of a serialized sketch
+    void load(std::vector<std::vector<double>> levels, const uint64_t coin) noexcept(
+        false
+    )
+    {
+        m_levels = std::move(levels);
+        m_retained = 0;
+        for (const auto& level : m_levels) {
+            m_retained += level.size();
+        }
+        update_capacities();
+        m_coin = coin;
+    }
+
+    /**
+     * \brief Estimate quantiles
+     *
+     * The quantile q is the smallest value such that at least a fraction
+     * q of the values are less than or equal to it.
+     *
+     * \param fractions The fractions, between 0 and 1
+     * \return The estimated quantile of each fraction, or NaN if empty
+     */
+    std::vector<double> quantiles(const std::vector<double>& fractions) const
+        noexcept(false)
+    {
+        // Sort all retained values along with the weight each stands for
+        std::vector<std::pair<double, double>> weighted;
+        weighted.reserve(m_retained);
+        double weight = 1.0;
+        for (const auto& level : m_levels) {
+            for (const double value : level) {
+                weighted.emplace_back(value, weight);
+            }
+            weight *= 2.0;
+        }
+        std::sort(weighted.begin(), weighted.end());
+        double total = 0.0;
+        for (auto& item : weighted) {
+            total += item.second;
+            item.second = total;
+        }
+
+        std::vector<double> result;
+        result.reserve(fractions.size());
+        for (const double fraction : fractions) {
+            if (weighted.empty()) {
+                result.push_back(std::numeric_limits<double>::quiet_NaN());
+                continue;
+            }
+            const double target = fraction * total;
+            auto found = std::lower_bound(
+                weighted.begin(),
+                weighted.end(),
+                target,
+                [](const std::pair<double, double>& item, const double t) {
+                    return item.second < t;
+                }
+            );
+            result.push_back(found == weighted.end() ? weighted.back().first
+                                                     : found->first);
+        }
+        return result;
+    }
+
+private:
+    /// The size of the top level
+    std::size_t m_k;
+
+    /// The values of each level, where level h stands for 2 ** h values each
+    std::vector<std::vector<double>> m_levels;
+
+    /// The number of values in all levels
+    std::size_t m_retained;
+
+    /// The number of values in each level at which it is compacted
+    std::vector<std::size_t> m_capacities;
+
+    /// The number of values in all levels at which to compress
+    std::size_t m_capacity;
+
+    /// The state of the xorshift generator of coin flips
+    uint64_t m_coin;
+
+    static constexpr uint64_t SEED = 0x9E3779B97F4A7C15ULL;
+
+    /// Set the capacity of each level, which is 2/3 of the one above it
+    void update_capacities() noexcept(false)
+    {
+        m_capacities.resize(m_levels.size());
+        m_capacity = 0;
+        double size = static_cast<double>(m_k);
+        for (std::size_t h = m_levels.size(); h-- > 0;) {
+            m_capacities[h] = static_cast<std::size_t>(std::ceil(size)) + 1;
+            m_capacity += m_capacities[h];
+            size *= 2.0 / 3.0;
+        }
+    }
+
+    /// Add a level at the top
+    void grow() noexcept(false)
+    {
+        m_levels.emplace_back();
+        update_capacities();
+    }
+
+    /// Flip a coin
+    bool flip() noexcept
+    {
+        m_coin ^= m_coin << 13;
+        m_coin ^= m_coin >> 7;
+        m_coin ^= m_coin << 17;
+        return (m_coin & 1) != 0;
+    }
+
+    /// Compact the lowest level that is over its capacity
+    void compress() noexcept(false)
+    {
+        for (std::size_t h = 0; h < m_levels.size(); ++h) {
+            if (m_levels[h].size() < m_capacities[h]) {
+                continue;
+            }
+            if (h + 1 == m_levels.size()) {
+                grow();
+            }
+            std::vector<double>& level = m_levels[h];
+            std::vector<double>& above = m_levels[h + 1];
+
+            // With an odd number of values, the last one (before sorting) stays
+            std::sort(level.begin(), level.end() - (level.size() % 2));
+            const std::size_t pairs = level.size() / 2;
+            const std::size_t offset = flip() ? 1 : 0;
+            for (std::size_t i = 0; i < pairs; ++i) {
+                above.push_back(level[2 * i + offset]);
+            }
+            const auto moved = static_cast<std::ptrdiff_t>(2 * pairs);
+            level.erase(level.begin(), level.begin() + moved);
+            m_retained -= pairs;
+            if (m_retained < m_capacity) {
+                return;
+            }
+        }
+    }
+};
+
+/**
+ * \class NumericSketch
+ * \brief Summarize a stream of numbers: their count, extremes, quantiles,
+ *        and number of distinct values
+ *
+ * NaN is only counted. Sketches with the same precision can be merged, and
+ * they can be serialized to bytes in a portable (little-endian) format.
+ */
+class NumericSketch {
+public:
+    /// Start with no values
+    NumericSketch(const std::size_t k, const int precision) noexcept(false)
+        : m_quantiles(k)
+        , m_distinct(precision)
+        , m_count(0)
+        , m_nan_count(0)
+        , m_min(std::numeric_limits<double>::quiet_NaN())
+        , m_max(std::numeric_limits<double>::quiet_NaN())
+    { }
+
+    /// Add a value
+    void add(const double value) noexcept(false)
+    {
+        if (std::isnan(value)) {
+            m_nan_count += 1;
+            return;
+        }
+        if (m_count == 0) {
+            m_min = m_max = value;
+        } else {
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+        }
+        m_count += 1;
+        m_quantiles.add(value);
+
+        // Values that compare equal must hash the same, so -0.0 becomes 0.0
+        const double normalized = value == 0.0 ? 0.0 : value;
+        uint64_t bits;
+        std::memcpy(&bits, &normalized, sizeof(bits));
+        m_distinct.add(ContentHash::fmix64(bits));
+    }
+
+    /// Add the values of another sketch, returning false if it does not fit
+    bool merge(const NumericSketch& other) noexcept(false)
+    {
+        if (other.m_distinct.precision() != m_distinct.precision()) {
+            return false;
+        }
+        if (other.m_count > 0) {
+            m_min = m_count == 0 ? other.m_min : std::min(m_min, other.m_min);
+            m_max = m_count == 0 ? other.m_max : std::max(m_max, other.m_max);
+        }
+        m_count += other.m_count;
+        m_nan_count += other.m_nan_count;
+        m_quantiles.merge(other.m_quantiles);
+        m_distinct.merge(other.m_distinct);
+        return true;
+    }
+
+    /// The number of values that are not NaN
+    uint64_t count() const noexcept { return m_count; }
+
+    /// The number of NaN values
+    uint64_t nan_count() const noexcept { return m_nan_count; }
+
+    /// The smallest value, or NaN if there are none
+    double min() const noexcept { return m_min; }
+
+    /// The largest value, or NaN if there are none
+    double max() const noexcept { return m_max; }
+
+    /// Estimate the number of distinct values
+    double distinct() const noexcept(false)
+    {
+        return m_count == 0 ? 0.0 : m_distinct.estimate();
+    }
+
+    /// Estimate quantiles, which are exact at 0 (the minimum) and 1 (the maximum)
+    std::vector<double> quantiles(const std::vector<double>& fractions) const
+        noexcept(false)
+    {
+        std::vector<double> result = m_quantiles.quantiles(fractions);
+        for (std::size_t i = 0; i < fractions.size(); ++i) {
+            if (fractions[i] <= 0.0) {
+                result[i] = m_min;
+            } else if (fractions[i] >= 1.0) {
+                result[i] = m_max;
+            }
+        }
+        return result;
+    }
+
+    /// Serialize to bytes
+    std::string serialize() const noexcept(false)
+    {
+        std::string data(MAGIC);
+        put(data, VERSION, 1);
+        put(data, m_quantiles.k(), 4);
+        put(data, static_cast<uint64_t>(m_distinct.precision()), 1);
+        put(data, m_count, 8);
+        put(data, m_nan_count, 8);
+        put(data, bits_of(m_min), 8);
+        put(data, bits_of(m_max), 8);
+        put(data, m_quantiles.coin(), 8);
+        put(data, m_quantiles.levels().size(), 4);
+        for (const auto& level : m_quantiles.levels()) {
+            put(data, level.size(), 8);
+            for (const double value : level) {
+                put(data, bits_of(value), 8);
+            }
+        }
+        const auto& registers = m_distinct.registers();
+        data.append(registers.begin(), registers.end());
+        return data;
+    }
+
+    /// Deserialize from bytes, returning nullptr if they are not valid
+    static std::unique_ptr<NumericSketch> deserialize(std::string_view data) noexcept(
+        false
+    )
+    {
+        uint64_t version, k, precision, count, nan_count, min, max, coin, height;
+        if (data.substr(0, MAGIC.size()) != MAGIC) {
+            return nullptr;
+        }
+        data.remove_prefix(MAGIC.size());
+        if (!get(data, version, 1) || version != VERSION || !get(data, k, 4)
+            || k < KllSketch::MIN_K || k > KllSketch::MAX_K || !get(data, precision, 1)
+            || precision < HyperLogLog::MIN_PRECISION
+            || precision > HyperLogLog::MAX_PRECISION || !get(data, count, 8)
+            || !get(data, nan_count, 8) || !get(data, min, 8) || !get(data, max, 8)
+            || !get(data, coin, 8) || coin == 0 || !get(data, height, 4) || height == 0
+            || height > KllSketch::MAX_LEVELS) {
+            return nullptr;
+        }
+
+        // The values must stand for exactly the number of values counted
+        std::vector<std::vector<double>> levels(height);
+        uint64_t weight = 0;
+        for (std::size_t h = 0; h < height; ++h) {
+            uint64_t size;
+            if (!get(data, size, 8) || size > data.size() / 8
+                || size > (std::numeric_limits<uint64_t>::max() - weight) >> h) {
+                return nullptr;
+            }
+            weight += size << h;
+            levels[h].resize(size);
+            for (double& value : levels[h]) {
+                uint64_t bits;
+                get(data, bits, 8);
+                std::memcpy(&value, &bits, sizeof(value));
+                if (std::isnan(value)) {
+                    return nullptr;
+                }
+            }
+        }
+        if (weight != count) {
+            return nullptr;
+        }
+
+        auto sketch = std::make_unique<NumericSketch>(
+            static_cast<std::size_t>(k), static_cast<int>(precision)
+        );
+        const auto* registers = reinterpret_cast<const uint8_t*>(data.data());
+        if (data.size() != sketch->m_distinct.registers().size()
+            || !sketch->m_distinct.load(registers)) {
+            return nullptr;
+        }
+        sketch->m_quantiles.load(std::move(levels), coin);
+        sketch->m_count = count;
+        sketch->m_nan_count = nan_count;
+        std::memcpy(&sketch->m_min, &min, sizeof(double));
+        std::memcpy(&sketch->m_max, &max, sizeof(double));
+        return sketch;
+    }
+
+private:
+    /// The quantile sketch
+    KllSketch m_quantiles;
+
+    /// The distinct value estimator
+    HyperLogLog m_distinct;
+
+    /// The number of values that are not NaN
+    uint64_t m_count;
+
+    /// The number of NaN values
+    uint64_t m_nan_count;
+
+    /// The smallest value
+    double m_min;
+
+    /// The largest value
+    double m_max;
+
+    static constexpr std::string_view MAGIC = "FNSK";
+    static constexpr uint64_t VERSION = 1;
+
+    /// The bits of a double
+    static uint64_t bits_of(const double value) noexcept
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    /// Append the lowest bytes of an integer, least significant first
+    static void
+    put(std::string& data, uint64_t value, const std::size_t bytes) noexcept(false)
+    {
+        for (std::size_t i = 0; i < bytes; ++i) {
+            data.push_back(static_cast<char>(value & 0xFF));
+            value >>= 8;
+        }
+    }
+
+    /// Read and remove an integer written by put(), returning false if too short
+    static bool
+    get(std::string_view& data, uint64_t& value, const std::size_t bytes) noexcept
+    {
+        if (data.size() < bytes) {
+            return false;
+        }
+        value = 0;
+        for (std::size_t i = 0; i < bytes; ++i) {
+            const auto byte = static_cast<unsigned char>(data[i]);
+            value |= static_cast<uint64_t>(byte) << (8 * i);
+        }
+        data.remove_prefix(bytes);
+        return true;
+    }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Python.h>
+
+/*
+ * Static tracepoints (USDT) for attaching tools like bpftrace or perf
+ * to a production build of fastnumbers.
+ *
+ * When <sys/sdt.h> is available each probe compiles to a single no-op
+ * instruction plus an ELF note describing where the arguments live, so
+ * the probes cost essentially nothing unless a tracer is attached.
+ * When the header is not available (or FN_NO_USDT is defined) the
+ * probes compile to nothing at all.
+ *
+ * All probes live in the "fastnumbers" provider:
+ *
+ *   function__entry(const char* name)
+ *   function__return(const char* name, int error_set)
+ *   array__start(ssize_t count, const char* format)
+ *   array__end(ssize_t count, const char* format)
+ *   bigint__fallback(size_t ndigits)
+ *   buffer__heap_alloc(size_t nbytes)
+ *   callback__invoke(PyObject* callable, PyObject* input)
+ */
+
+#if defined(__linux__) && !defined(FN_NO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define FN_HAVE_USDT 1
+#endif
+#endif
+
+#ifdef FN_HAVE_USDT
+#define FN_TRACE1(name, a1) DTRACE_PROBE1(fastnumbers, name, a1)
+#define FN_TRACE2(name, a1, a2) DTRACE_PROBE2(fastnumbers, name, a1, a2)
+#else
+// The arguments are not evaluated, but are still "used" to silence warnings.
+#define FN_TRACE1(name, a1) static_cast<void>(sizeof(a1))
+#define FN_TRACE2(name, a1, a2) static_cast<void>(sizeof(a1) + sizeof(a2))
+#endif
+
+/**
+ * \class FunctionTrace
+ * \brief Fire the entry and return probes for a Python-exposed function
+ *
+ * The entry probe fires on construction and the return probe fires
+ * on destruction, so every return path of a function is covered.
+ */
+class FunctionTrace {
+public:
+    /// Fire the entry probe for the named function
+    explicit FunctionTrace(const char* name) noexcept
+        : m_name(name)
+    {
+        FN_TRACE1(function__entry, m_name);
+    }
+
+    FunctionTrace(const FunctionTrace&) = delete;
+    FunctionTrace(FunctionTrace&&) = delete;
+    FunctionTrace& operator=(const FunctionTrace&) = delete;
+
+    /// Fire the return probe, indicating whether a Python error was set
+    ~FunctionTrace() noexcept
+    {
+        FN_TRACE2(function__return, m_name, PyErr_Occurred() != nullptr);
+    }
+
+private:
+    /// The name of the traced function, as seen from Python
+    const char* m_name;
+};
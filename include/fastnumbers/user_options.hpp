@@ -4,6 +4,7 @@
 
 #include <Python.h>
 
+#include "fastnumbers/c_str_parsing.hpp"
 #include "fastnumbers/selectors.hpp"
 
 /// The conversion the user has requested
@@ -13,6 +14,9 @@ enum class UserType {
     INT, ///< Convert to/check an int
     INTLIKE, ///< Check int-like
     FORCEINT, ///< Force conversion to int
+    COMPLEX, ///< Convert to a complex
+    FRACTION, ///< Convert to a fractions.Fraction
+    DECIMAL, ///< Convert to a decimal.Decimal
 };
 
 /**
@@ -25,6 +29,9 @@ public:
         : m_base(10)
         , m_default_base(true)
         , m_underscore_allowed(false)
+        , m_hex_float_allowed(false)
+        , m_fraction_allowed(false)
+        , m_assume_valid(false)
         , m_coerce(false)
         , m_denoise(false)
         , m_nan_allowed_str(false)
@@ -32,6 +39,7 @@ public:
         , m_inf_allowed_str(false)
         , m_inf_allowed_num(false)
         , m_unicode_allowed(true)
+        , m_number_format()
     { }
     UserOptions(const UserOptions&) = default;
     UserOptions(UserOptions&&) = default;
@@ -57,6 +65,24 @@ public:
     /// Are underscores allowed?
     bool allow_underscores() const noexcept { return m_underscore_allowed; }
 
+    /// Define whether or not hexadecimal floats are allowed
+    void set_hex_float_allowed(const bool val) noexcept { m_hex_float_allowed = val; }
+
+    /// Are hexadecimal floats allowed?
+    bool allow_hex_float() const noexcept { return m_hex_float_allowed; }
+
+    /// Define whether or not rational numbers like "3/4" are allowed
+    void set_fraction_allowed(const bool val) noexcept { m_fraction_allowed = val; }
+
+    /// Are rational numbers allowed?
+    bool allow_fraction() const noexcept { return m_fraction_allowed; }
+
+    /// Tell the analyzer that strings are known to be valid numbers
+    void set_assume_valid(const bool val) noexcept { m_assume_valid = val; }
+
+    /// Can strings be parsed without validation?
+    bool assume_valid() const noexcept { return m_assume_valid; }
+
     /// Tell the analyzer whether or not to coerce to int for REAL
     void set_coerce(const bool coerce) noexcept { m_coerce = coerce; }
 
@@ -148,6 +174,15 @@ public:
     /// Indicate if we allow non-ASCII unicode characters as input
     bool allow_unicode() const noexcept { return m_unicode_allowed; }
 
+    /// Tell the analyzer the locale-style format in which strings are written
+    void set_number_format(const NumberFormat& number_format) noexcept
+    {
+        m_number_format = number_format;
+    }
+
+    /// The locale-style format in which strings are written
+    const NumberFormat& number_format() const noexcept { return m_number_format; }
+
 private:
     /// The desired base of integers when parsing
     int m_base;
@@ -158,6 +193,15 @@ private:
     /// Whether or not underscores are allowed when parsing
     bool m_underscore_allowed;
 
+    /// Whether or not hexadecimal floats are allowed when parsing
+    bool m_hex_float_allowed;
+
+    /// Whether or not rational numbers like "3/4" are allowed when parsing
+    bool m_fraction_allowed;
+
+    /// Whether or not strings are trusted to be valid numbers
+    bool m_assume_valid;
+
     /// Whether or not floats should be coerced to integers if user wants REAL
     bool m_coerce;
 
@@ -179,4 +223,7 @@ private:
 
     /// Whether or not a unicode character is allowed
     bool m_unicode_allowed;
+
+    /// The decimal point, thousands separator, and negative style of strings
+    NumberFormat m_number_format;
 };
\ No newline at end of file
@@ -226,6 +226,14 @@ def float_try(x):
         return x
 
 
+def decimal_try(x):
+    """Simulate try_decimal but with try/except."""
+    try:
+        return decimal.Decimal(x)
+    except decimal.InvalidOperation:
+        return x
+
+
 def real_re(
     x,
     int_match=re.compile(r"[-+]?\d+$").match,
@@ -434,6 +442,15 @@ timer.add_function("float_re", "regex", "from __main__ import float_re")
 timer.add_function("try_float", "fastnumbers", "from fastnumbers import try_float")
 timer.time_functions()
 
+timer = Timer("Timing comparison of `Decimal` functions with error handling")
+timer.add_function(
+    "decimal_try", "try/except", setup="from __main__ import decimal_try"
+)
+timer.add_function(
+    "try_decimal", "fastnumbers", setup="from fastnumbers import try_decimal"
+)
+timer.time_functions()
+
 timer = Timer(
     "Timing comparison of `float` (but coerce to `int` if possible) "
     "functions with error handling"
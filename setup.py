@@ -4,9 +4,13 @@ from __future__ import annotations
 
 import os
 import pathlib
+import shutil
+import subprocess
 import sys
+import sysconfig
 
 from setuptools import Extension, setup
+from setuptools.command.build_ext import build_ext
 
 # Compilation arguments are platform-dependent
 link_args = ["-lm", "-lstdc++"]
@@ -39,6 +43,86 @@ else:
             link_args.append("--coverage")
     if "FN_WARNINGS_AS_ERRORS" in os.environ:
         compile_args.append("-Werror")
+    if "FN_NO_USDT" in os.environ:
+        compile_args.append("-DFN_NO_USDT")
+    if "FN_NO_MULTIVERSION" in os.environ:
+        compile_args.append("-DFN_NO_MULTIVERSION")
+
+
+class PGOBuildExt(build_ext):
+    """
+    Build the extension, optionally with profile-guided optimization.
+
+    If FN_PGO is set in the environment, the extension is first built
+    with instrumentation, then a training workload (dev/pgo-training.py)
+    is run against it, and then it is rebuilt using the recorded profile
+    as well as link-time optimization. Only GCC and Clang are supported.
+    """
+
+    def build_extensions(self) -> None:
+        """Build the extension."""
+        if "FN_PGO" not in os.environ:
+            super().build_extensions()
+            return
+        if sys.platform == "win32":
+            msg = "FN_PGO is only supported for GCC and Clang"
+            raise RuntimeError(msg)
+
+        compiler = os.environ.get("CC", sysconfig.get_config_var("CC") or "")
+        is_clang = "clang" in compiler
+        profile_dir = pathlib.Path(self.build_temp, "pgo").resolve()
+        shutil.rmtree(profile_dir, ignore_errors=True)
+        profile_dir.mkdir(parents=True)
+
+        # Stage 1: Build with instrumentation, always recompiling.
+        self.force = True
+        self._add_flags([f"-fprofile-generate={profile_dir}"])
+        super().build_extensions()
+
+        # Stage 2: Run the training workload on the instrumented build.
+        for extension in self.extensions:
+            subprocess.run(
+                [
+                    sys.executable,
+                    "dev/pgo-training.py",
+                    self.get_ext_fullpath(extension.name),
+                ],
+                check=True,
+            )
+
+        # Clang needs the raw profile data to be merged before it can be used.
+        if is_clang:
+            profile = profile_dir / "default.profdata"
+            raw_profiles = sorted(map(str, profile_dir.glob("*.profraw")))
+            subprocess.run(
+                ["llvm-profdata", "merge", f"-output={profile}", *raw_profiles],
+                check=True,
+            )
+            use_flags = [f"-fprofile-use={profile}", "-flto"]
+        else:
+            use_flags = [
+                f"-fprofile-use={profile_dir}",
+                "-fprofile-correction",
+                "-flto=auto",
+            ]
+
+        # Stage 3: Rebuild using the profile and link-time optimization.
+        self._remove_flags([f"-fprofile-generate={profile_dir}"])
+        self._add_flags(use_flags)
+        super().build_extensions()
+
+    def _add_flags(self, flags: list[str]) -> None:
+        """Add flags to both the compile and link steps."""
+        for extension in self.extensions:
+            extension.extra_compile_args.extend(flags)
+            extension.extra_link_args.extend(flags)
+
+    def _remove_flags(self, flags: list[str]) -> None:
+        """Remove flags from both the compile and link steps."""
+        for extension in self.extensions:
+            for flag in flags:
+                extension.extra_compile_args.remove(flag)
+                extension.extra_link_args.remove(flag)
 
 
 ext = [
@@ -54,4 +138,4 @@ ext = [
 
 # Define how to build the extension module.
 # All other data is in the pyproject.toml file.
-setup(ext_modules=ext)
+setup(ext_modules=ext, cmdclass={"build_ext": PGOBuildExt})
@@ -10,6 +10,7 @@
 #include <charconv>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 
 /*********************/
@@ -26,6 +27,11 @@ StringChecker::StringChecker(const char* str, const char* end, int base) noexcep
     , m_int_trailing_zeros(0U)
     , m_dec_trailing_zeros(0U)
     , m_contained_type(StringType::INVALID)
+{
+    scan(str, end, base);
+}
+
+void StringChecker::scan(const char* str, const char* end, int base) noexcept
 {
     const std::size_t len = static_cast<std::size_t>(end - str);
 
@@ -104,11 +110,15 @@ StringChecker::StringChecker(const char* str, const char* end, int base) noexcep
                 str += 1;
             }
 
-            // Parse the exponent as a digit.
+            // Parse the exponent as a digit. Saturate rather than wrap
+            // so that a huge exponent cannot masquerade as a small one.
             const char* exp_digit_start = str;
             int32_t this_char_as_digit = 0L;
             while (str != end && (this_char_as_digit = to_digit<int32_t>(*str)) >= 0) {
-                set_exponent(exponent_value() * 10UL + this_char_as_digit);
+                const uint64_t expon = exponent_value() * 10ULL + this_char_as_digit;
+                set_exponent(static_cast<uint32_t>(
+                    std::min(expon, static_cast<uint64_t>(UINT32_MAX))
+                ));
                 str += 1;
             }
 
@@ -148,7 +158,18 @@ StringChecker::StringChecker(const char* str, const char* end, int base) noexcep
     }
 }
 
+// The implementation is separate from the exported declaration so that the
+// CPU-specific clones are only ever referenced from within this file.
+FN_MULTIVERSION static void
+remove_valid_underscores_impl(char* str, const char*& end, const bool based) noexcept;
+
 void remove_valid_underscores(char* str, const char*& end, const bool based) noexcept
+{
+    remove_valid_underscores_impl(str, end, based);
+}
+
+static void
+remove_valid_underscores_impl(char* str, const char*& end, const bool based) noexcept
 {
     // Ignore a leading negative sign
     if (*str == '-') {
@@ -225,3 +246,380 @@ void remove_valid_underscores(char* str, const char*& end, const bool based) noe
         str[i] = '\0';
     }
 }
+
+bool normalize_number_format(
+    char* str, const char*& end, const NumberFormat& format
+) noexcept
+{
+    const char* in = str;
+    const char* stop = end;
+    char* out = str;
+
+    // Whitespace is not part of the number.
+    consume_whitespace(in, stop);
+    while (in != stop && is_whitespace(*(stop - 1))) {
+        stop -= 1;
+    }
+
+    // Accounting negatives are in parentheses and may not also have a sign.
+    if (format.accounting && stop - in > 1 && *in == '(' && *(stop - 1) == ')') {
+        in += 1;
+        stop -= 1;
+        if (in != stop && is_sign(*in)) {
+            return false;
+        }
+        *out++ = '-';
+    } else if (in != stop && is_sign(*in)) {
+        *out++ = *in++;
+    }
+
+    // Keep track of the digit groups in the integer part of the number.
+    // A group ends at a separator, and the integer part ends at the first
+    // character that is neither a digit nor a separator.
+    bool in_integer = true;
+    bool grouped = false;
+    std::size_t group_length = 0;
+    for (; in != stop; ++in) {
+        const char c = *in;
+        if (in_integer && is_valid_digit(c)) {
+            group_length += 1;
+            *out++ = c;
+            continue;
+        }
+
+        if (format.thousands != '\0' && c == format.thousands) {
+            const bool valid_group
+                = grouped ? group_length == 3 : (group_length > 0 && group_length <= 3);
+            if (!in_integer || !valid_group) {
+                return false;
+            }
+            grouped = true;
+            group_length = 0;
+            continue;
+        }
+
+        // Anything else ends the integer part, and so the last group.
+        if (in_integer) {
+            if (grouped && group_length != 3) {
+                return false;
+            }
+            in_integer = false;
+        }
+        if (c == format.decimal_point) {
+            *out++ = '.';
+        } else if (c == '.') {
+            return false;
+        } else {
+            *out++ = c;
+        }
+    }
+    if (in_integer && grouped && group_length != 3) {
+        return false;
+    }
+
+    // Update the end position and fill the trailing data with nul characters.
+    const char* new_end = out;
+    while (out != end) {
+        *out++ = '\0';
+    }
+    end = new_end;
+    return true;
+}
+
+/// Room needed past the scaled digits for a sign, decimal point and exponent
+static constexpr std::size_t SUFFIX_SLACK = 24;
+
+/// Exponents are saturated here when scaling, which is far past overflow
+static constexpr int64_t SUFFIX_EXPONENT_CAP = 1000000000000LL;
+
+void SuffixTable::add(const Suffix& suffix)
+{
+    const auto same = std::find_if(
+        m_suffixes.begin(),
+        m_suffixes.end(),
+        [&suffix](const Suffix& s) { return s.text == suffix.text; }
+    );
+    if (same != m_suffixes.end()) {
+        *same = suffix;
+    } else {
+        // Keep the longest suffixes first so that e.g. "KiB" beats "B".
+        const auto shorter = std::find_if(
+            m_suffixes.begin(),
+            m_suffixes.end(),
+            [&suffix](const Suffix& s) { return s.text.size() < suffix.text.size(); }
+        );
+        m_suffixes.insert(shorter, suffix);
+    }
+    m_last_chars[static_cast<unsigned char>(suffix.text.back())] = true;
+
+    // Each multiplication by the factor adds at most as many digits as it
+    // has, and the decimal exponent can add as many zeros as its magnitude.
+    std::size_t factor_digits = 0;
+    for (uint32_t factor = suffix.factor; factor > 0; factor /= 10) {
+        factor_digits += 1;
+    }
+    const std::size_t growth = suffix.repeat * factor_digits
+        + static_cast<std::size_t>(std::abs(static_cast<int64_t>(suffix.power10)))
+        + SUFFIX_SLACK;
+    m_max_growth = std::max(m_max_growth, growth);
+}
+
+const Suffix* SuffixTable::find(const char* str, const char* end) const noexcept
+{
+    if (str == end || !m_last_chars[static_cast<unsigned char>(*(end - 1))]) {
+        return nullptr;
+    }
+    const std::size_t len = static_cast<std::size_t>(end - str);
+    for (const Suffix& suffix : m_suffixes) {
+        const std::size_t n = suffix.text.size();
+        if (n < len && std::memcmp(end - n, suffix.text.data(), n) == 0) {
+            return &suffix;
+        }
+    }
+    return nullptr;
+}
+
+void apply_suffix(char* str, const char*& end, const SuffixTable& table) noexcept
+{
+    const Suffix* suffix = table.find(str, end);
+    if (suffix == nullptr) {
+        return;
+    }
+
+    // Whitespace is allowed between the number and the suffix.
+    const char* stop = end - suffix->text.size();
+    while (stop != str && is_whitespace(*(stop - 1))) {
+        stop -= 1;
+    }
+
+    // Only decimal numbers are scaled. Find the integer and decimal digits,
+    // and the value of the exponent if there is one.
+    const char* in = str;
+    const bool negative = in != stop && *in == '-';
+    if (in != stop && is_sign(*in)) {
+        in += 1;
+    }
+    const char* int_start = in;
+    while (in != stop && is_valid_digit(*in)) {
+        in += 1;
+    }
+    const char* int_end = in;
+    const char* dec_start = in;
+    if (in != stop && *in == '.') {
+        in += 1;
+        dec_start = in;
+        while (in != stop && is_valid_digit(*in)) {
+            in += 1;
+        }
+    }
+    const char* dec_end = in;
+    if (int_start == int_end && dec_start == dec_end) {
+        return;
+    }
+    const bool has_exponent = in != stop && (*in == 'e' || *in == 'E');
+    int64_t exponent = 0;
+    if (has_exponent) {
+        in += 1;
+        const bool exp_negative = in != stop && *in == '-';
+        if (in != stop && is_sign(*in)) {
+            in += 1;
+        }
+        const char* exp_start = in;
+        for (; in != stop && is_valid_digit(*in); ++in) {
+            exponent = std::min(exponent * 10 + (*in - '0'), SUFFIX_EXPONENT_CAP);
+        }
+        if (in == exp_start) {
+            return;
+        }
+        exponent = exp_negative ? -exponent : exponent;
+    }
+    if (in != stop) {
+        return;
+    }
+
+    // Move the digits (without the decimal point) to the far end of the
+    // available space. This leaves room before them for the multiplication
+    // to grow into, and ensures that writing the result from the start of
+    // the string never overtakes the digits still to be read.
+    char* const capacity_end = str + (end - str) + table.max_growth();
+    const std::size_t n_int = static_cast<std::size_t>(int_end - int_start);
+    const std::size_t n_dec = static_cast<std::size_t>(dec_end - dec_start);
+    std::memmove(capacity_end - n_dec, dec_start, n_dec);
+    std::memmove(capacity_end - n_dec - n_int, int_start, n_int);
+    char* digits = capacity_end - n_dec - n_int;
+    int64_t point = static_cast<int64_t>(n_int);
+
+    // Multiply the digits by the factor, as on paper.
+    for (uint32_t i = 0; i < suffix->repeat; ++i) {
+        uint64_t carry = 0;
+        for (char* d = capacity_end; d != digits;) {
+            --d;
+            const uint64_t value = static_cast<uint64_t>(*d - '0') * suffix->factor + carry;
+            *d = static_cast<char>('0' + value % 10);
+            carry = value / 10;
+        }
+        for (; carry > 0; carry /= 10) {
+            *--digits = static_cast<char>('0' + carry % 10);
+            point += 1;
+        }
+    }
+    const int64_t n_digits = static_cast<int64_t>(capacity_end - digits);
+
+    // Write the result, scaling by the power of ten either by moving the
+    // decimal point or by changing the exponent.
+    char* out = str;
+    if (negative) {
+        *out++ = '-';
+    }
+    if (has_exponent) {
+        for (int64_t i = 0; i < n_digits; ++i) {
+            if (i == point) {
+                *out++ = '.';
+            }
+            *out++ = digits[i];
+        }
+        *out++ = 'e';
+        out = std::to_chars(out, capacity_end, exponent + suffix->power10).ptr;
+    } else {
+        point += suffix->power10;
+
+        // The integer part, padded with zeros if the point moved past the digits.
+        if (point <= 0) {
+            *out++ = '0';
+        }
+        for (int64_t i = 0; i < point; ++i) {
+            *out++ = i < n_digits ? digits[i] : '0';
+        }
+
+        // The decimal part, without trailing zeros.
+        int64_t last = n_digits;
+        while (last > std::max(point, int64_t(0)) && digits[last - 1] == '0') {
+            last -= 1;
+        }
+        if (last > std::max(point, int64_t(0))) {
+            *out++ = '.';
+            for (int64_t i = point; i < last; ++i) {
+                *out++ = i < 0 ? '0' : digits[i];
+            }
+        }
+    }
+
+    // Update the end position and nul-terminate.
+    *out = '\0';
+    end = out;
+}
+
+/// Bits of a hexadecimal mantissa kept before digits only set "inexact"
+static constexpr int HEX_MANTISSA_BITS = 60;
+
+/// Hexadecimal float exponents are saturated here, which is far past overflow
+static constexpr int64_t HEX_EXPONENT_CAP = 1000000000000LL;
+
+bool read_hex_float(
+    const char* str,
+    const char* end,
+    uint64_t& mantissa,
+    int64_t& exponent,
+    bool& inexact
+) noexcept
+{
+    mantissa = 0;
+    exponent = 0;
+    inexact = false;
+    if (!has_hex_prefix(str, static_cast<std::size_t>(end - str))) {
+        return false;
+    }
+    str += 2;
+
+    // Accumulate the digits. Each digit after the point scales by 2**-4,
+    // and each digit before the point that does not fit scales by 2**4.
+    bool seen_digit = false;
+    bool seen_point = false;
+    for (; str != end; str += 1) {
+        if (*str == '.') {
+            if (seen_point) {
+                return false;
+            }
+            seen_point = true;
+            continue;
+        }
+        const int digit = to_digit<int>(*str, 16);
+        if (digit < 0) {
+            break;
+        }
+        seen_digit = true;
+        if ((mantissa >> (HEX_MANTISSA_BITS - 4)) == 0) {
+            mantissa = (mantissa << 4) | static_cast<uint64_t>(digit);
+            exponent -= seen_point ? 4 : 0;
+        } else {
+            inexact |= digit != 0;
+            exponent += seen_point ? 0 : 4;
+        }
+    }
+    if (!seen_digit) {
+        return false;
+    }
+
+    // Read the optional binary exponent.
+    if (str != end) {
+        if (lowercase(*str) != 'p') {
+            return false;
+        }
+        str += 1;
+        const bool negative = str != end && *str == '-';
+        if (str != end && is_sign(*str)) {
+            str += 1;
+        }
+        if (str == end) {
+            return false;
+        }
+        int64_t value = 0;
+        for (; str != end; str += 1) {
+            const int digit = to_digit<int>(*str);
+            if (digit < 0) {
+                return false;
+            }
+            value = std::min(value * 10 + digit, HEX_EXPONENT_CAP);
+        }
+        exponent += negative ? -value : value;
+    }
+    return true;
+}
+
+bool read_rational(const char* str, const char* end, RationalParts& parts) noexcept
+{
+    // The first run of digits is either the whole part or the numerator.
+    const char* first = str;
+    consume_digits(str, end);
+    if (str == first || str == end) {
+        return false;
+    }
+    const char* first_end = str;
+
+    // Whitespace means the first run was the whole part.
+    if (is_whitespace(*str)) {
+        consume_whitespace(str, end);
+        parts.whole = first;
+        parts.whole_end = first_end;
+        parts.numerator = str;
+        consume_digits(str, end);
+        if (str == parts.numerator) {
+            return false;
+        }
+        parts.numerator_end = str;
+    } else {
+        parts.whole = parts.whole_end = first;
+        parts.numerator = first;
+        parts.numerator_end = first_end;
+    }
+
+    // The denominator follows the '/' and ends the string.
+    if (str == end || *str != '/') {
+        return false;
+    }
+    str += 1;
+    parts.denominator = str;
+    consume_digits(str, end);
+    parts.denominator_end = str;
+    return str != parts.denominator && str == end;
+}
@@ -1,18 +1,71 @@
 #include <cstddef>
+#include <cstring>
 #include <variant>
 
 #include <Python.h>
 
 #include "fastnumbers/buffer.hpp"
+#include "fastnumbers/cpu_dispatch.hpp"
 #include "fastnumbers/extractor.hpp"
 #include "fastnumbers/parser.hpp"
 #include "fastnumbers/user_options.hpp"
 
 // Forward declarations
-AnyParser parse_unicode_to_char(
+FN_MULTIVERSION AnyParser parse_unicode_to_char(
     PyObject* obj, Buffer& char_buffer, const UserOptions& options
 ) noexcept(false);
 
+/**
+ * \brief Create a CharacterParser, first rewriting locale-style numbers
+ *        and unit suffixes into Python's format if the user asked for that
+ *
+ * If the data must be rewritten and is not already in the buffer
+ * it is copied there, so that the original data is never modified.
+ */
+static CharacterParser make_character_parser(
+    const char* str,
+    const std::size_t len,
+    Buffer& buffer,
+    const UserOptions& options,
+    const bool explict_base_allowed = true
+) noexcept(false)
+{
+    const NumberFormat& format = options.number_format();
+    if (!format.is_custom()) {
+        return CharacterParser(str, len, options, explict_base_allowed);
+    }
+
+    // Make a nul-terminated copy to modify, with room to grow if scaled.
+    const std::size_t needed = len + 1 + format.max_growth();
+    if (str != buffer.start()) {
+        buffer.reserve(needed);
+        std::memcpy(buffer.start(), str, len);
+        buffer.start()[len] = '\0';
+    } else {
+        buffer.extend(needed);
+    }
+
+    // If the separators were in invalid positions then there is no number.
+    const char* end = buffer.start() + len;
+    if (!normalize_number_format(buffer.start(), end, format)) {
+        return CharacterParser("", 0, options, explict_base_allowed);
+    }
+
+    // Suffixes are only for decimal numbers, since e.g. "E" is a hex digit.
+    const bool decimal = options.is_default_base() || options.get_base() == 10;
+    if (format.suffixes != nullptr && decimal) {
+        // The digits of the number must be contiguous to be scaled
+        const std::size_t normalized = static_cast<std::size_t>(end - buffer.start());
+        if (options.allow_underscores()
+            && std::memchr(buffer.start(), '_', normalized) != nullptr) {
+            remove_valid_underscores(buffer.start(), end, false);
+        }
+        apply_suffix(buffer.start(), end, *format.suffixes);
+    }
+    const std::size_t new_len = static_cast<std::size_t>(end - buffer.start());
+    return CharacterParser(buffer.start(), new_len, options, explict_base_allowed);
+}
+
 AnyParser
 extract_parser(PyObject* obj, Buffer& buffer, const UserOptions& options) noexcept(false)
 {
@@ -34,9 +87,10 @@ extract_parser(PyObject* obj, Buffer& buffer, const UserOptions& options) noexce
     if (PyUnicode_Check(obj)) {
         // Unicode in ASCII form is stored like bytes!
         if (PyUnicode_IS_READY(obj) && PyUnicode_IS_COMPACT_ASCII(obj)) {
-            return CharacterParser(
+            return make_character_parser(
                 (const char*)PyUnicode_1BYTE_DATA(obj),
                 static_cast<const std::size_t>(PyUnicode_GET_LENGTH(obj)),
+                buffer,
                 options
             );
         }
@@ -44,15 +98,17 @@ extract_parser(PyObject* obj, Buffer& buffer, const UserOptions& options) noexce
         // Here is the special-case handling for non-ASCII unicode.
         return parse_unicode_to_char(obj, buffer, options);
     } else if (PyBytes_Check(obj)) {
-        return CharacterParser(
+        return make_character_parser(
             PyBytes_AS_STRING(obj),
             static_cast<const std::size_t>(PyBytes_GET_SIZE(obj)),
+            buffer,
             options
         );
     } else if (PyByteArray_Check(obj)) {
-        return CharacterParser(
+        return make_character_parser(
             PyByteArray_AS_STRING(obj),
             static_cast<const std::size_t>(PyByteArray_GET_SIZE(obj)),
+            buffer,
             options
         );
     }
@@ -76,7 +132,7 @@ extract_parser(PyObject* obj, Buffer& buffer, const UserOptions& options) noexce
         // which was allocated when we created the buffer. For this reason
         // it is safe to release the buffer here.
         PyBuffer_Release(&view);
-        return CharacterParser(buffer.start(), len, options, false);
+        return make_character_parser(buffer.start(), len, buffer, options, false);
     }
 
     // If here, we have no idea what the type is. The NumericParser is
@@ -84,6 +140,48 @@ extract_parser(PyObject* obj, Buffer& buffer, const UserOptions& options) noexce
     return NumericParser(obj, options);
 }
 
+AnyParser extract_parser(
+    PyObject* obj,
+    Buffer& buffer,
+    const UserOptions& options,
+    TypeSpeculation& speculation
+) noexcept(false)
+{
+    speculation.observe(obj);
+    switch (speculation.kind_of(obj)) {
+    case TypeSpeculation::Kind::ASCII_STR:
+        if (PyUnicode_IS_COMPACT_ASCII(obj)) {
+            buffer.reset();
+            return make_character_parser(
+                (const char*)PyUnicode_1BYTE_DATA(obj),
+                static_cast<const std::size_t>(PyUnicode_GET_LENGTH(obj)),
+                buffer,
+                options
+            );
+        }
+        break;
+
+    case TypeSpeculation::Kind::BYTES:
+        buffer.reset();
+        return make_character_parser(
+            PyBytes_AS_STRING(obj),
+            static_cast<const std::size_t>(PyBytes_GET_SIZE(obj)),
+            buffer,
+            options
+        );
+
+    case TypeSpeculation::Kind::NUMERIC:
+        buffer.reset();
+        return NumericParser(obj, options);
+
+    default: // NONE
+        break;
+    }
+
+    // A mismatch uses the general dispatch
+    return extract_parser(obj, buffer, options);
+}
+
 /// Obtain either a CharacterParser or UnicodeParser from unicode data
 AnyParser parse_unicode_to_char(
     PyObject* obj, Buffer& char_buffer, const UserOptions& options
@@ -150,5 +248,5 @@ AnyParser parse_unicode_to_char(
     }
     buffer[buffer_index] = '\0';
 
-    return CharacterParser(buffer, buffer_index, options);
+    return make_character_parser(buffer, buffer_index, char_buffer, options);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 /*
  * This file contains the functions that directly interface with the Python interpreter.
  */
+#include <cstdio>
 #include <exception>
 #include <functional>
 #include <limits>
@@ -10,10 +11,15 @@
 #include <Python.h>
 
 #include "fastnumbers/argparse.hpp"
+#include "fastnumbers/content_hash.hpp"
+#include "fastnumbers/conversion_limits.hpp"
+#include "fastnumbers/cpu_dispatch.hpp"
 #include "fastnumbers/docstrings.hpp"
 #include "fastnumbers/exception.hpp"
 #include "fastnumbers/implementation.hpp"
+#include "fastnumbers/parser/base.hpp"
 #include "fastnumbers/selectors.hpp"
+#include "fastnumbers/tracing.hpp"
 
 /**
  * \brief Function to handle the conversion of base to integers.
@@ -108,14 +114,24 @@ create_consider(const bool str_only, const bool num_only) noexcept
 }
 
 /**
- * \brief Make the value of map one of three possible values
+ * \brief Make the value of map one of six possible values
+ *
+ * The string "lazy" is how fastnumbers.lazy() asks for a lazy sequence,
+ * and "converter" is how convert_records() asks for a prepared conversion.
+ *
  * \param mapval The value of map given on input
- * \return Either PyList_Type, Py_True, or Py_False
+ * \return Either PyList_Type, the "lazy", "inplace", or "converter" string,
+ *         Py_True, or Py_False
  */
 static inline PyObject* normalize_map(PyObject* mapval) noexcept
 {
     if (mapval == (PyObject*)&PyList_Type) {
         return mapval;
+    } else if (PyUnicode_Check(mapval)
+               && (PyUnicode_CompareWithASCIIString(mapval, "lazy") == 0
+                   || PyUnicode_CompareWithASCIIString(mapval, "inplace") == 0
+                   || PyUnicode_CompareWithASCIIString(mapval, "converter") == 0)) {
+        return mapval;
     } else if (PyObject_IsTrue(mapval)) {
         return Py_True;
     } else {
@@ -126,20 +142,36 @@ static inline PyObject* normalize_map(PyObject* mapval) noexcept
 /**
  * \brief Execute the conversion function as a one-off or as an iterable
  * \param input The input from Python-land
- * \param convert The function that converts our input to output
- * \param map If True or list execute as an iterable, otherwise as a one-off
+ * \param impl The Implementation that converts our input to output
+ * \param map If True, list, "lazy", or "inplace" execute as an iterable,
+ *            if "converter" return the conversion itself, otherwise as a one-off
  * \return The object to return to Python-land
  */
 static PyObject* choose_execution_scheme(
-    PyObject* input, std::function<PyObject*(PyObject*)> convert, const PyObject* map
+    PyObject* input, Implementation impl, PyObject* map
 ) noexcept(false)
 {
+    if (map == Py_False) {
+        return impl.convert(input);
+    } else if (PyUnicode_Check(map)
+               && PyUnicode_CompareWithASCIIString(map, "converter") == 0) {
+        return converter_impl(std::move(impl));
+    } else if (PyUnicode_Check(map)
+               && PyUnicode_CompareWithASCIIString(map, "lazy") == 0) {
+        return lazy_iteration_impl(input, std::move(impl));
+    }
+
+    // Use a lambda instead of the convert function directly so that the
+    // Implementation object stays in memory even if we return an iterator.
+    auto convert = [impl = std::move(impl)](PyObject* x) -> PyObject* {
+        return impl.convert(x);
+    };
     if (map == Py_True) {
         return iter_iteration_impl(input, convert);
     } else if (map == (PyObject*)&PyList_Type) {
         return list_iteration_impl(input, convert);
     } else {
-        return convert(input);
+        return inplace_iteration_impl(input, convert);
     }
 }
 
@@ -150,6 +182,8 @@ static PyObject* fastnumbers_try_real(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("try_real");
+
     PyObject* input = nullptr;
     PyObject* inf = Selectors::ALLOWED;
     PyObject* nan = Selectors::ALLOWED;
@@ -158,6 +192,12 @@ static PyObject* fastnumbers_try_real(
     bool coerce = true;
     bool denoise = false;
     bool allow_underscores = false;
+    bool allow_fraction = false;
+    bool assume_valid = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
     PyObject* map = Py_False;
 
     // Read the function argument
@@ -171,6 +211,12 @@ static PyObject* fastnumbers_try_real(
                            "$on_type_error", false, &on_type_error,
                            "$coerce", true, &coerce,
                            "$allow_underscores", true, &allow_underscores,
+                           "$allow_fraction", true, &allow_fraction,
+                           "$assume_valid", true, &assume_valid,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
                            "$map", false, &map,
                            "$denoise", true, &denoise,
                            nullptr, false, nullptr
@@ -179,8 +225,6 @@ static PyObject* fastnumbers_try_real(
 
     // Execute main logic in an exception handler to convert C++ exceptions
     return ExceptionHandler(input).run([&]() -> PyObject* {
-        // Use a lambda instead of the convert function directly so that the
-        // Implementation object stays in memory even if we return an iterator.
         Implementation impl(UserType::REAL);
         impl.set_fail_action(on_fail);
         impl.set_type_error_action(on_type_error);
@@ -189,198 +233,864 @@ static PyObject* fastnumbers_try_real(
         impl.set_coerce(coerce);
         impl.set_denoise(denoise);
         impl.set_underscores_allowed(allow_underscores);
-        auto convert = [impl = std::move(impl)](PyObject* x) -> PyObject* {
-            return impl.convert(x);
-        };
-        return choose_execution_scheme(input, convert, normalize_map(map));
+        impl.set_fraction_allowed(allow_fraction);
+        impl.set_assume_valid(assume_valid);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+        return choose_execution_scheme(input, std::move(impl), normalize_map(map));
+    });
+}
+
+/**
+ * \brief Quickly convert to a float, with error handling
+ */
+static PyObject* fastnumbers_try_float(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("try_float");
+
+    PyObject* input = nullptr;
+    PyObject* inf = Selectors::ALLOWED;
+    PyObject* nan = Selectors::ALLOWED;
+    PyObject* on_fail = Selectors::INPUT;
+    PyObject* on_type_error = Selectors::RAISE;
+    bool allow_underscores = false;
+    bool allow_hex_float = false;
+    bool allow_fraction = false;
+    bool assume_valid = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+    PyObject* map = Py_False;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("try_float", args, len_args, kwnames,
+                           "x", false,  &input,
+                           "$inf", false, &inf,
+                           "$nan", false, &nan,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$allow_hex_float", true, &allow_hex_float,
+                           "$allow_fraction", true, &allow_fraction,
+                           "$assume_valid", true, &assume_valid,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           "$map", false, &map,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        Implementation impl(UserType::FLOAT);
+        impl.set_fail_action(on_fail);
+        impl.set_type_error_action(on_type_error);
+        impl.set_inf_action(inf);
+        impl.set_nan_action(nan);
+        impl.set_underscores_allowed(allow_underscores);
+        impl.set_hex_float_allowed(allow_hex_float);
+        impl.set_fraction_allowed(allow_fraction);
+        impl.set_assume_valid(assume_valid);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+        return choose_execution_scheme(input, std::move(impl), normalize_map(map));
+    });
+}
+
+/**
+ * \brief Quickly convert to an int, with error handling
+ */
+static PyObject* fastnumbers_try_int(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("try_int");
+
+    PyObject* input = nullptr;
+    PyObject* on_fail = Selectors::INPUT;
+    PyObject* on_type_error = Selectors::RAISE;
+    PyObject* pybase = nullptr;
+    bool allow_underscores = false;
+    bool assume_valid = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+    PyObject* map = Py_False;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("try_int", args, len_args, kwnames,
+                           "x", false,  &input,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$base", false, &pybase,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$assume_valid", true, &assume_valid,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           "$map", false, &map,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        Implementation impl(UserType::INT, assess_integer_base_input(pybase));
+        impl.set_fail_action(on_fail);
+        impl.set_type_error_action(on_type_error);
+        impl.set_unicode_allowed(); // determine from base
+        impl.set_underscores_allowed(allow_underscores);
+        impl.set_assume_valid(assume_valid);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+        return choose_execution_scheme(input, std::move(impl), normalize_map(map));
+    });
+}
+
+/**
+ * \brief Quickly convert to an int (even if input is float), with error handling
+ */
+static PyObject* fastnumbers_try_forceint(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("try_forceint");
+
+    PyObject* input = nullptr;
+    PyObject* on_fail = Selectors::INPUT;
+    PyObject* on_type_error = Selectors::RAISE;
+    bool allow_underscores = false;
+    bool assume_valid = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+    bool denoise = false;
+    PyObject* map = Py_False;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("try_forceint", args, len_args, kwnames,
+                           "x", false,  &input,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$assume_valid", true, &assume_valid,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           "$map", false, &map,
+                           "$denoise", true, &denoise,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        Implementation impl(UserType::FORCEINT);
+        impl.set_fail_action(on_fail);
+        impl.set_type_error_action(on_type_error);
+        impl.set_denoise(denoise);
+        impl.set_underscores_allowed(allow_underscores);
+        impl.set_assume_valid(assume_valid);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+        return choose_execution_scheme(input, std::move(impl), normalize_map(map));
+    });
+}
+
+/**
+ * \brief Quickly convert to a complex, with error handling
+ */
+static PyObject* fastnumbers_try_complex(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("try_complex");
+
+    PyObject* input = nullptr;
+    PyObject* on_fail = Selectors::INPUT;
+    PyObject* on_type_error = Selectors::RAISE;
+    bool allow_underscores = false;
+    PyObject* map = Py_False;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("try_complex", args, len_args, kwnames,
+                           "x", false,  &input,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$map", false, &map,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        Implementation impl(UserType::COMPLEX);
+        impl.set_fail_action(on_fail);
+        impl.set_type_error_action(on_type_error);
+        impl.set_underscores_allowed(allow_underscores);
+        return choose_execution_scheme(input, std::move(impl), normalize_map(map));
+    });
+}
+
+/**
+ * \brief Quickly convert to a fractions.Fraction, with error handling
+ */
+static PyObject* fastnumbers_try_fraction(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("try_fraction");
+
+    PyObject* input = nullptr;
+    PyObject* on_fail = Selectors::INPUT;
+    PyObject* on_type_error = Selectors::RAISE;
+    bool allow_underscores = false;
+    PyObject* map = Py_False;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("try_fraction", args, len_args, kwnames,
+                           "x", false,  &input,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$map", false, &map,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        Implementation impl(UserType::FRACTION);
+        impl.set_fail_action(on_fail);
+        impl.set_type_error_action(on_type_error);
+        impl.set_underscores_allowed(allow_underscores);
+        return choose_execution_scheme(input, std::move(impl), normalize_map(map));
+    });
+}
+
+/**
+ * \brief Decimal infinity and NaN, to return when they are allowed
+ *
+ * These are created once and kept for the life of the process.
+ *
+ * \return Positive and negative infinity then NaN, or NULL on error
+ */
+static PyObject* const* decimal_inf_nan() noexcept
+{
+    static PyObject* values[4] = { nullptr, nullptr, nullptr, nullptr };
+    if (values[3] == nullptr) {
+        PyObject* decimal = Parser::decimal_type();
+        if (decimal == nullptr) {
+            return nullptr;
+        }
+        const char* names[4] = { "Infinity", "-Infinity", "NaN", "-NaN" };
+        for (std::size_t i = 0; i < 4; ++i) {
+            if (values[i] == nullptr) {
+                values[i] = PyObject_CallFunction(decimal, "s", names[i]);
+                if (values[i] == nullptr) {
+                    return nullptr;
+                }
+            }
+        }
+    }
+    return values;
+}
+
+/**
+ * \brief Quickly convert to a decimal.Decimal, with error handling
+ */
+static PyObject* fastnumbers_try_decimal(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("try_decimal");
+
+    PyObject* input = nullptr;
+    PyObject* inf = Selectors::ALLOWED;
+    PyObject* nan = Selectors::ALLOWED;
+    PyObject* on_fail = Selectors::INPUT;
+    PyObject* on_type_error = Selectors::RAISE;
+    bool allow_underscores = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+    PyObject* map = Py_False;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("try_decimal", args, len_args, kwnames,
+                           "x", false,  &input,
+                           "$inf", false, &inf,
+                           "$nan", false, &nan,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           "$map", false, &map,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        PyObject* const* inf_nan = decimal_inf_nan();
+        if (inf_nan == nullptr) {
+            throw exception_is_set();
+        }
+
+        Implementation impl(UserType::DECIMAL);
+        impl.set_fail_action(on_fail);
+        impl.set_type_error_action(on_type_error);
+        impl.set_inf_action(inf);
+        impl.set_nan_action(nan);
+        impl.set_allowed_inf_nan(inf_nan[0], inf_nan[1], inf_nan[2], inf_nan[3]);
+        impl.set_underscores_allowed(allow_underscores);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+        return choose_execution_scheme(input, std::move(impl), normalize_map(map));
+    });
+}
+
+/**
+ * \brief Like try_*, but return in a memory buffer
+ */
+static PyObject* fastnumbers_array(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("array");
+
+    PyObject* input = nullptr;
+    PyObject* output = nullptr;
+    PyObject* inf = Selectors::ALLOWED;
+    PyObject* nan = Selectors::ALLOWED;
+    PyObject* on_fail = Selectors::RAISE;
+    PyObject* on_overflow = Selectors::RAISE;
+    PyObject* on_type_error = Selectors::RAISE;
+    PyObject* pybase = nullptr;
+    bool allow_underscores = false;
+    bool allow_hex_float = false;
+    bool allow_fraction = false;
+    bool assume_valid = false;
+    bool consume = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("array", args, len_args, kwnames,
+                           "input", false,  &input,
+                           "output", false, &output,
+                           "$inf", false, &inf,
+                           "$nan", false, &nan,
+                           "$on_fail", false, &on_fail,
+                           "$on_overflow", false, &on_overflow,
+                           "$on_type_error", false, &on_type_error,
+                           "$base", false, &pybase,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$allow_hex_float", true, &allow_hex_float,
+                           "$allow_fraction", true, &allow_fraction,
+                           "$assume_valid", true, &assume_valid,
+                           "$consume", true, &consume,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        array_impl(
+            input,
+            output,
+            inf,
+            nan,
+            on_fail,
+            on_overflow,
+            on_type_error,
+            allow_underscores,
+            allow_hex_float,
+            allow_fraction,
+            assume_valid,
+            consume,
+            assess_integer_base_input(pybase),
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+
+        // No return value, need to return None
+        Py_RETURN_NONE;
+    });
+}
+
+/**
+ * \brief Number the distinct values of an iterable while converting it
+ */
+static PyObject* fastnumbers_factorize(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("factorize");
+
+    PyObject* input = nullptr;
+    PyObject* codes = nullptr;
+    PyObject* values = nullptr;
+    PyObject* inf = Selectors::ALLOWED;
+    PyObject* nan = Selectors::ALLOWED;
+    PyObject* on_fail = Selectors::RAISE;
+    PyObject* on_overflow = Selectors::RAISE;
+    PyObject* on_type_error = Selectors::RAISE;
+    PyObject* pybase = nullptr;
+    bool allow_underscores = false;
+    bool allow_hex_float = false;
+    bool allow_fraction = false;
+    bool assume_valid = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("factorize", args, len_args, kwnames,
+                           "input", false,  &input,
+                           "codes", false, &codes,
+                           "values", false, &values,
+                           "$inf", false, &inf,
+                           "$nan", false, &nan,
+                           "$on_fail", false, &on_fail,
+                           "$on_overflow", false, &on_overflow,
+                           "$on_type_error", false, &on_type_error,
+                           "$base", false, &pybase,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$allow_hex_float", true, &allow_hex_float,
+                           "$allow_fraction", true, &allow_fraction,
+                           "$assume_valid", true, &assume_valid,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        return factorize_impl(
+            input,
+            codes,
+            values,
+            inf,
+            nan,
+            on_fail,
+            on_overflow,
+            on_type_error,
+            allow_underscores,
+            allow_hex_float,
+            allow_fraction,
+            assume_valid,
+            assess_integer_base_input(pybase),
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+    });
+}
+
+/**
+ * \brief Locate the values of an iterable among bin edges while converting it
+ */
+static PyObject* fastnumbers_digitize(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("digitize");
+
+    PyObject* input = nullptr;
+    PyObject* output = nullptr;
+    PyObject* edges = nullptr;
+    bool right = false;
+    bool counts = false;
+    PyObject* inf = Selectors::ALLOWED;
+    PyObject* nan = Selectors::ALLOWED;
+    PyObject* on_fail = Selectors::RAISE;
+    PyObject* on_type_error = Selectors::RAISE;
+    bool allow_underscores = false;
+    bool allow_hex_float = false;
+    bool allow_fraction = false;
+    bool assume_valid = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("digitize", args, len_args, kwnames,
+                           "input", false,  &input,
+                           "output", false, &output,
+                           "edges", false, &edges,
+                           "$right", true, &right,
+                           "$counts", true, &counts,
+                           "$inf", false, &inf,
+                           "$nan", false, &nan,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$allow_hex_float", true, &allow_hex_float,
+                           "$allow_fraction", true, &allow_fraction,
+                           "$assume_valid", true, &assume_valid,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        digitize_impl(
+            input,
+            output,
+            edges,
+            right,
+            counts,
+            inf,
+            nan,
+            on_fail,
+            on_type_error,
+            allow_underscores,
+            allow_hex_float,
+            allow_fraction,
+            assume_valid,
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+        Py_RETURN_NONE;
+    });
+}
+
+/**
+ * \brief Like try_array, but for a numpy array of dtype object
+ */
+static PyObject* fastnumbers_object_array(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("object_array");
+
+    PyObject* input = nullptr;
+    PyObject* output = nullptr;
+    PyObject* converter = nullptr;
+    bool consume = false;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("object_array", args, len_args, kwnames,
+                           "input", false, &input,
+                           "output", false, &output,
+                           "converter", false, &converter,
+                           "$consume", true, &consume,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        object_array_impl(input, output, converter, consume);
+        Py_RETURN_NONE;
+    });
+}
+
+/**
+ * \brief Create an empty sketch of numbers
+ */
+static PyObject* fastnumbers_sketch(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("sketch");
+
+    PyObject* k = nullptr;
+    PyObject* precision = nullptr;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("sketch", args, len_args, kwnames,
+                           "k", false, &k,
+                           "precision", false, &precision,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(k).run([&]() -> PyObject* {
+        return sketch_impl(k, precision);
+    });
+}
+
+/**
+ * \brief Add the values of an iterable to a sketch while converting it
+ */
+static PyObject* fastnumbers_sketch_update(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("sketch_update");
+
+    PyObject* sketch = nullptr;
+    PyObject* input = nullptr;
+    PyObject* inf = Selectors::ALLOWED;
+    PyObject* nan = Selectors::ALLOWED;
+    PyObject* on_fail = Selectors::RAISE;
+    PyObject* on_type_error = Selectors::RAISE;
+    bool allow_underscores = false;
+    bool allow_hex_float = false;
+    bool allow_fraction = false;
+    bool assume_valid = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("sketch_update", args, len_args, kwnames,
+                           "sketch", false, &sketch,
+                           "input", false,  &input,
+                           "$inf", false, &inf,
+                           "$nan", false, &nan,
+                           "$on_fail", false, &on_fail,
+                           "$on_type_error", false, &on_type_error,
+                           "$allow_underscores", true, &allow_underscores,
+                           "$allow_hex_float", true, &allow_hex_float,
+                           "$allow_fraction", true, &allow_fraction,
+                           "$assume_valid", true, &assume_valid,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        sketch_update_impl(
+            sketch,
+            input,
+            inf,
+            nan,
+            on_fail,
+            on_type_error,
+            allow_underscores,
+            allow_hex_float,
+            allow_fraction,
+            assume_valid,
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
+        Py_RETURN_NONE;
+    });
+}
+
+/**
+ * \brief Add the values of an already converted array to a sketch
+ */
+static PyObject* fastnumbers_sketch_add(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("sketch_add");
+
+    PyObject* sketch = nullptr;
+    PyObject* values = nullptr;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("sketch_add", args, len_args, kwnames,
+                           "sketch", false, &sketch,
+                           "values", false, &values,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(values).run([&]() -> PyObject* {
+        sketch_add_impl(sketch, values);
+        Py_RETURN_NONE;
+    });
+}
+
+/**
+ * \brief Add the values of one sketch to another
+ */
+static PyObject* fastnumbers_sketch_merge(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("sketch_merge");
+
+    PyObject* sketch = nullptr;
+    PyObject* other = nullptr;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("sketch_merge", args, len_args, kwnames,
+                           "sketch", false, &sketch,
+                           "other", false, &other,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(other).run([&]() -> PyObject* {
+        sketch_merge_impl(sketch, other);
+        Py_RETURN_NONE;
     });
 }
 
 /**
- * \brief Quickly convert to a float, with error handling
+ * \brief Estimate quantiles of the values of a sketch
  */
-static PyObject* fastnumbers_try_float(
+static PyObject* fastnumbers_sketch_quantiles(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
-    PyObject* input = nullptr;
-    PyObject* inf = Selectors::ALLOWED;
-    PyObject* nan = Selectors::ALLOWED;
-    PyObject* on_fail = Selectors::INPUT;
-    PyObject* on_type_error = Selectors::RAISE;
-    bool allow_underscores = false;
-    PyObject* map = Py_False;
+    const FunctionTrace trace("sketch_quantiles");
+
+    PyObject* sketch = nullptr;
+    PyObject* quantiles = nullptr;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
     // clang-format off
-    if (fn_parse_arguments("try_float", args, len_args, kwnames,
-                           "x", false,  &input,
-                           "$inf", false, &inf,
-                           "$nan", false, &nan,
-                           "$on_fail", false, &on_fail,
-                           "$on_type_error", false, &on_type_error,
-                           "$allow_underscores", true, &allow_underscores,
-                           "$map", false, &map,
+    if (fn_parse_arguments("sketch_quantiles", args, len_args, kwnames,
+                           "sketch", false, &sketch,
+                           "quantiles", false, &quantiles,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
 
     // Execute main logic in an exception handler to convert C++ exceptions
-    return ExceptionHandler(input).run([&]() -> PyObject* {
-        // Use a lambda instead of the convert function directly so that the
-        // Implementation object stays in memory even if we return an iterator.
-        Implementation impl(UserType::FLOAT);
-        impl.set_fail_action(on_fail);
-        impl.set_type_error_action(on_type_error);
-        impl.set_inf_action(inf);
-        impl.set_nan_action(nan);
-        impl.set_underscores_allowed(allow_underscores);
-        auto convert = [impl = std::move(impl)](PyObject* x) -> PyObject* {
-            return impl.convert(x);
-        };
-        return choose_execution_scheme(input, convert, normalize_map(map));
+    return ExceptionHandler(quantiles).run([&]() -> PyObject* {
+        return sketch_quantiles_impl(sketch, quantiles);
     });
 }
 
 /**
- * \brief Quickly convert to an int, with error handling
+ * \brief Summarize the values of a sketch
  */
-static PyObject* fastnumbers_try_int(
+static PyObject* fastnumbers_sketch_summary(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
-    PyObject* input = nullptr;
-    PyObject* on_fail = Selectors::INPUT;
-    PyObject* on_type_error = Selectors::RAISE;
-    PyObject* pybase = nullptr;
-    bool allow_underscores = false;
-    PyObject* map = Py_False;
+    const FunctionTrace trace("sketch_summary");
+
+    PyObject* sketch = nullptr;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
     // clang-format off
-    if (fn_parse_arguments("try_int", args, len_args, kwnames,
-                           "x", false,  &input,
-                           "$on_fail", false, &on_fail,
-                           "$on_type_error", false, &on_type_error,
-                           "$base", false, &pybase,
-                           "$allow_underscores", true, &allow_underscores,
-                           "$map", false, &map,
+    if (fn_parse_arguments("sketch_summary", args, len_args, kwnames,
+                           "sketch", false, &sketch,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
 
     // Execute main logic in an exception handler to convert C++ exceptions
-    return ExceptionHandler(input).run([&]() -> PyObject* {
-        // Use a lambda instead of the convert function directly so that the
-        // Implementation object stays in memory even if we return an iterator.
-        Implementation impl(UserType::INT, assess_integer_base_input(pybase));
-        impl.set_fail_action(on_fail);
-        impl.set_type_error_action(on_type_error);
-        impl.set_unicode_allowed(); // determine from base
-        impl.set_underscores_allowed(allow_underscores);
-        auto convert = [impl = std::move(impl)](PyObject* x) -> PyObject* {
-            return impl.convert(x);
-        };
-        return choose_execution_scheme(input, convert, normalize_map(map));
+    return ExceptionHandler(sketch).run([&]() -> PyObject* {
+        return sketch_summary_impl(sketch);
     });
 }
 
 /**
- * \brief Quickly convert to an int (even if input is float), with error handling
+ * \brief Serialize a sketch to bytes
  */
-static PyObject* fastnumbers_try_forceint(
+static PyObject* fastnumbers_sketch_dumps(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
-    PyObject* input = nullptr;
-    PyObject* on_fail = Selectors::INPUT;
-    PyObject* on_type_error = Selectors::RAISE;
-    bool allow_underscores = false;
-    bool denoise = false;
-    PyObject* map = Py_False;
+    const FunctionTrace trace("sketch_dumps");
+
+    PyObject* sketch = nullptr;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
     // clang-format off
-    if (fn_parse_arguments("try_forceint", args, len_args, kwnames,
-                           "x", false,  &input,
-                           "$on_fail", false, &on_fail,
-                           "$on_type_error", false, &on_type_error,
-                           "$allow_underscores", true, &allow_underscores,
-                           "$map", false, &map,
-                           "$denoise", true, &denoise,
+    if (fn_parse_arguments("sketch_dumps", args, len_args, kwnames,
+                           "sketch", false, &sketch,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
 
     // Execute main logic in an exception handler to convert C++ exceptions
-    return ExceptionHandler(input).run([&]() -> PyObject* {
-        // Use a lambda instead of the convert function directly so that the
-        // Implementation object stays in memory even if we return an iterator.
-        Implementation impl(UserType::FORCEINT);
-        impl.set_fail_action(on_fail);
-        impl.set_type_error_action(on_type_error);
-        impl.set_denoise(denoise);
-        impl.set_underscores_allowed(allow_underscores);
-        auto convert = [impl = std::move(impl)](PyObject* x) -> PyObject* {
-            return impl.convert(x);
-        };
-        return choose_execution_scheme(input, convert, normalize_map(map));
+    return ExceptionHandler(sketch).run([&]() -> PyObject* {
+        return sketch_dumps_impl(sketch);
     });
 }
 
 /**
- * \brief Like try_*, but return in a memory buffer
+ * \brief Recreate a sketch from bytes
  */
-static PyObject* fastnumbers_array(
+static PyObject* fastnumbers_sketch_loads(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
-    PyObject* input = nullptr;
-    PyObject* output = nullptr;
-    PyObject* inf = Selectors::ALLOWED;
-    PyObject* nan = Selectors::ALLOWED;
-    PyObject* on_fail = Selectors::RAISE;
-    PyObject* on_overflow = Selectors::RAISE;
-    PyObject* on_type_error = Selectors::RAISE;
-    PyObject* pybase = nullptr;
-    bool allow_underscores = false;
+    const FunctionTrace trace("sketch_loads");
+
+    PyObject* data = nullptr;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
     // clang-format off
-    if (fn_parse_arguments("array", args, len_args, kwnames,
-                           "input", false,  &input,
-                           "output", false, &output,
-                           "$inf", false, &inf,
-                           "$nan", false, &nan,
-                           "$on_fail", false, &on_fail,
-                           "$on_overflow", false, &on_overflow,
-                           "$on_type_error", false, &on_type_error,
-                           "$base", false, &pybase,
-                           "$allow_underscores", true, &allow_underscores,
+    if (fn_parse_arguments("sketch_loads", args, len_args, kwnames,
+                           "data", false, &data,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
 
     // Execute main logic in an exception handler to convert C++ exceptions
-    return ExceptionHandler(input).run([&]() -> PyObject* {
-        array_impl(
-            input,
-            output,
-            inf,
-            nan,
-            on_fail,
-            on_overflow,
-            on_type_error,
-            allow_underscores,
-            assess_integer_base_input(pybase)
-        );
-
-        // No return value, need to return None
-        Py_RETURN_NONE;
+    return ExceptionHandler(data).run([&]() -> PyObject* {
+        return sketch_loads_impl(data);
     });
 }
 
@@ -391,11 +1101,17 @@ static PyObject* fastnumbers_check_real(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("check_real");
+
     PyObject* input = nullptr;
     PyObject* consider = Py_None;
     PyObject* inf = Selectors::NUMBER_ONLY;
     PyObject* nan = Selectors::NUMBER_ONLY;
     bool allow_underscores = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
@@ -406,6 +1122,10 @@ static PyObject* fastnumbers_check_real(
                            "$nan", false, &nan,
                            "$consider", false, &consider,
                            "$allow_underscores", true, &allow_underscores,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
@@ -417,6 +1137,9 @@ static PyObject* fastnumbers_check_real(
         impl.set_nan_allowed(nan);
         impl.set_consider(consider);
         impl.set_underscores_allowed(allow_underscores);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
         return impl.check(input);
     });
 }
@@ -428,12 +1151,18 @@ static PyObject* fastnumbers_check_float(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("check_float");
+
     PyObject* input = nullptr;
     PyObject* consider = Py_None;
     PyObject* inf = Selectors::NUMBER_ONLY;
     PyObject* nan = Selectors::NUMBER_ONLY;
     int strict = false;
     bool allow_underscores = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
@@ -445,6 +1174,10 @@ static PyObject* fastnumbers_check_float(
                            "$consider", false, &consider,
                            "$strict", true, &strict,
                            "$allow_underscores", true, &allow_underscores,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
@@ -457,6 +1190,9 @@ static PyObject* fastnumbers_check_float(
         impl.set_consider(consider);
         impl.set_strict(strict);
         impl.set_underscores_allowed(allow_underscores);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
         return impl.check(input);
     });
 }
@@ -468,10 +1204,16 @@ static PyObject* fastnumbers_check_int(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("check_int");
+
     PyObject* input = nullptr;
     PyObject* consider = Py_None;
     PyObject* pybase = nullptr;
     bool allow_underscores = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
@@ -481,6 +1223,10 @@ static PyObject* fastnumbers_check_int(
                            "$consider", false, &consider,
                            "$base", false, &pybase,
                            "$allow_underscores", true, &allow_underscores,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
@@ -490,6 +1236,9 @@ static PyObject* fastnumbers_check_int(
         Implementation impl(UserType::INT, assess_integer_base_input(pybase));
         impl.set_consider(consider);
         impl.set_underscores_allowed(allow_underscores);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
         return impl.check(input);
     });
 }
@@ -501,9 +1250,15 @@ static PyObject* fastnumbers_check_intlike(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("check_intlike");
+
     PyObject* input = nullptr;
     PyObject* consider = Py_None;
     bool allow_underscores = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
@@ -512,6 +1267,10 @@ static PyObject* fastnumbers_check_intlike(
                            "x", false,  &input,
                            "$consider", false, &consider,
                            "$allow_underscores", true, &allow_underscores,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
@@ -522,6 +1281,9 @@ static PyObject* fastnumbers_check_intlike(
         impl.set_consider(consider);
         impl.set_coerce(true);
         impl.set_underscores_allowed(allow_underscores);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
         return impl.check(input);
     });
 }
@@ -533,12 +1295,18 @@ static PyObject* fastnumbers_query_type(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("query_type");
+
     PyObject* input = nullptr;
     PyObject* allowed_types = nullptr;
     bool coerce = false;
     int allow_inf = false;
     int allow_nan = false;
     bool allow_underscores = false;
+    PyObject* decimal_point = nullptr;
+    PyObject* thousands = Py_None;
+    bool accounting = false;
+    PyObject* suffixes = Py_None;
 
     // Read the function arguments
     FN_PREPARE_ARGPARSER;
@@ -550,6 +1318,10 @@ static PyObject* fastnumbers_query_type(
                            "$coerce", true, &coerce,
                            "$allowed_types", false, &allowed_types,
                            "$allow_underscores", true, &allow_underscores,
+                           "$decimal_point", false, &decimal_point,
+                           "$thousands", false, &thousands,
+                           "$accounting", true, &accounting,
+                           "$suffixes", false, &suffixes,
                            nullptr, false, nullptr
         )) return nullptr;
     // clang-format on
@@ -566,6 +1338,9 @@ static PyObject* fastnumbers_query_type(
         impl.set_coerce(coerce);
         impl.set_allowed_types(allowed_types);
         impl.set_underscores_allowed(allow_underscores);
+        impl.set_number_format(
+            create_number_format(decimal_point, thousands, accounting, suffixes)
+        );
         return impl.query_type(input);
     });
 }
@@ -576,6 +1351,8 @@ static PyObject* fastnumbers_query_type(
 static PyObject*
 fastnumbers_float(PyObject* self, PyObject* const* args, Py_ssize_t len_args) noexcept
 {
+    const FunctionTrace trace("float");
+
     PyObject* input = nullptr;
 
     // Read the function argument - do not accept it as a keyword argument
@@ -608,6 +1385,8 @@ static PyObject* fastnumbers_int(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("int");
+
     PyObject* input = nullptr;
     PyObject* pybase = nullptr;
 
@@ -646,6 +1425,8 @@ static PyObject* fastnumbers_real(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("real");
+
     PyObject* input = nullptr;
     bool coerce = true;
     bool denoise = false;
@@ -682,6 +1463,8 @@ static PyObject* fastnumbers_fast_real(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("fast_real");
+
     PyObject* input = nullptr;
     PyObject* default_value = nullptr;
     PyObject* on_fail = nullptr;
@@ -730,6 +1513,8 @@ static PyObject* fastnumbers_fast_float(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("fast_float");
+
     PyObject* input = nullptr;
     PyObject* default_value = nullptr;
     PyObject* on_fail = nullptr;
@@ -775,6 +1560,8 @@ static PyObject* fastnumbers_fast_int(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("fast_int");
+
     PyObject* input = nullptr;
     PyObject* default_value = nullptr;
     PyObject* on_fail = nullptr;
@@ -817,6 +1604,8 @@ static PyObject* fastnumbers_fast_forceint(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("fast_forceint");
+
     PyObject* input = nullptr;
     PyObject* default_value = nullptr;
     PyObject* on_fail = nullptr;
@@ -856,6 +1645,8 @@ static PyObject* fastnumbers_isreal(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("isreal");
+
     PyObject* input = nullptr;
     int str_only = false;
     int num_only = false;
@@ -898,6 +1689,8 @@ static PyObject* fastnumbers_isfloat(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("isfloat");
+
     PyObject* input = nullptr;
     int str_only = false;
     int num_only = false;
@@ -940,6 +1733,8 @@ static PyObject* fastnumbers_isint(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("isint");
+
     PyObject* input = nullptr;
     PyObject* pybase = nullptr;
     int str_only = false;
@@ -977,6 +1772,8 @@ static PyObject* fastnumbers_isintlike(
     PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
 ) noexcept
 {
+    const FunctionTrace trace("isintlike");
+
     PyObject* input = nullptr;
     bool str_only = false;
     bool num_only = false;
@@ -1007,6 +1804,294 @@ static PyObject* fastnumbers_isintlike(
     });
 }
 
+/**
+ * \brief Report which CPU-specific kernel variant is in use
+ */
+static PyObject* fastnumbers_cpu_features(PyObject* self, PyObject* Py_UNUSED(args)) noexcept
+{
+    const FunctionTrace trace("cpu_features");
+
+    PyObject* features = PyDict_New();
+    if (features == nullptr) {
+        return nullptr;
+    }
+
+    // Add a key/value pair to the dict, stealing the reference to the value
+    auto add = [features](const char* key, PyObject* value) -> bool {
+        const bool ok
+            = value != nullptr && PyDict_SetItemString(features, key, value) == 0;
+        Py_XDECREF(value);
+        return ok;
+    };
+
+#ifdef FN_HAVE_MULTIVERSION
+    bool ok = add("multiversioned", PyBool_FromLong(true));
+#else
+    bool ok = add("multiversioned", PyBool_FromLong(false));
+#endif
+    ok = ok && add("variant", PyUnicode_FromString(active_cpu_variant()));
+
+#ifdef FN_HAVE_MULTIVERSION
+    // __builtin_cpu_supports only accepts string literals, so no loop
+    ok = ok && add("popcnt", PyBool_FromLong(__builtin_cpu_supports("popcnt")))
+        && add("sse4.2", PyBool_FromLong(__builtin_cpu_supports("sse4.2")))
+        && add("avx", PyBool_FromLong(__builtin_cpu_supports("avx")))
+        && add("avx2", PyBool_FromLong(__builtin_cpu_supports("avx2")))
+        && add("bmi", PyBool_FromLong(__builtin_cpu_supports("bmi")))
+        && add("bmi2", PyBool_FromLong(__builtin_cpu_supports("bmi2")))
+        && add("fma", PyBool_FromLong(__builtin_cpu_supports("fma")))
+        && add("avx512f", PyBool_FromLong(__builtin_cpu_supports("avx512f")));
+#endif
+
+    if (!ok) {
+        Py_DECREF(features);
+        return nullptr;
+    }
+    return features;
+}
+
+/**
+ * \brief Convert a limit given by the user to its stored representation
+ *
+ * \param name The name of the argument, for error messages
+ * \param value The value given by the user, where nullptr or None means
+ *              "follow the interpreter"
+ * \param limit Where to store the limit
+ * \return true on success, false with an error set on failure
+ */
+static bool read_limit(const char* name, PyObject* value, Py_ssize_t& limit) noexcept
+{
+    if (value == nullptr || value == Py_None) {
+        limit = -1;
+        return true;
+    }
+    if (!PyLong_Check(value)) {
+        PyErr_Format(
+            PyExc_TypeError,
+            "%s must be an int or None, not '%s'",
+            name,
+            Py_TYPE(value)->tp_name
+        );
+        return false;
+    }
+    const Py_ssize_t result = PyLong_AsSsize_t(value);
+    if (result == -1 && PyErr_Occurred()) {
+        return false;
+    }
+    if (result < 0) {
+        PyErr_Format(PyExc_ValueError, "%s must be >= 0 or None", name);
+        return false;
+    }
+    limit = result;
+    return true;
+}
+
+/**
+ * \brief Set the limits on the size of strings converted to Python int
+ */
+static PyObject* fastnumbers_set_conversion_limits(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("set_conversion_limits");
+
+    PyObject* max_digits = nullptr;
+    PyObject* max_exponent = nullptr;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("set_conversion_limits", args, len_args, kwnames,
+                           "$max_digits", false, &max_digits,
+                           "$max_exponent", false, &max_exponent,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Validate both before storing either so that a failure changes nothing
+    Py_ssize_t digits_limit = -1;
+    Py_ssize_t exponent_limit = -1;
+    if (!read_limit("max_digits", max_digits, digits_limit)
+        || !read_limit("max_exponent", max_exponent, exponent_limit)) {
+        return nullptr;
+    }
+    ConversionLimits::MAX_DIGITS = digits_limit;
+    ConversionLimits::MAX_EXPONENT = exponent_limit;
+    Py_RETURN_NONE;
+}
+
+/**
+ * \brief Report the limits on the size of strings converted to Python int
+ */
+static PyObject*
+fastnumbers_get_conversion_limits(PyObject* self, PyObject* Py_UNUSED(args)) noexcept
+{
+    const FunctionTrace trace("get_conversion_limits");
+
+    ConversionLimits::begin_call();
+    return Py_BuildValue(
+        "{s:n,s:n}",
+        "max_digits",
+        ConversionLimits::max_digits(),
+        "max_exponent",
+        ConversionLimits::max_exponent()
+    );
+}
+
+/**
+ * \brief Convert or collect the fields of records for convert_records
+ */
+static PyObject* fastnumbers_records(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("records");
+
+    PyObject* input = nullptr;
+    PyObject* fields = nullptr;
+    bool collect = false;
+    bool recurse = false;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("records", args, len_args, kwnames,
+                           "input", false, &input,
+                           "fields", false, &fields,
+                           "$collect", true, &collect,
+                           "$recurse", true, &recurse,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    // Execute main logic in an exception handler to convert C++ exceptions
+    return ExceptionHandler(input).run([&]() -> PyObject* {
+        return records_impl(input, fields, collect, recurse);
+    });
+}
+
+/**
+ * \brief Add one element of the input to a content hash
+ *
+ * Each element is preceded by a tag for its type and its length,
+ * so that e.g. "1" and 1, or ["12", "3"] and ["1", "23"], differ.
+ *
+ * \return true on success, false if the element's contents cannot be
+ *         hashed (with no error set), or false with an error set
+ */
+static bool hash_element(ContentHash& hash, PyObject* item) noexcept
+{
+    if (PyUnicode_CheckExact(item)) {
+        const auto kind = static_cast<unsigned char>(PyUnicode_KIND(item));
+        const Py_ssize_t len = PyUnicode_GET_LENGTH(item);
+        hash.update_value('s');
+        hash.update_value(kind);
+        hash.update_value(len);
+        hash.update(PyUnicode_DATA(item), static_cast<std::size_t>(len) * kind);
+    } else if (PyBytes_CheckExact(item) || PyByteArray_CheckExact(item)) {
+        const bool is_bytes = PyBytes_CheckExact(item);
+        const Py_ssize_t len = Py_SIZE(item);
+        hash.update_value(is_bytes ? 'b' : 'a');
+        hash.update_value(len);
+        hash.update(
+            is_bytes ? PyBytes_AS_STRING(item) : PyByteArray_AS_STRING(item),
+            static_cast<std::size_t>(len)
+        );
+    } else if (PyBool_Check(item)) {
+        hash.update_value(item == Py_True ? 'T' : 'F');
+    } else if (PyLong_CheckExact(item)) {
+        int overflow = 0;
+        const long long value = PyLong_AsLongLongAndOverflow(item, &overflow);
+        if (overflow == 0) {
+            hash.update_value('i');
+            hash.update_value(value);
+        } else {
+            // Huge integers are rare, so simply hash their digits
+            PyObject* digits = PyNumber_ToBase(item, 16);
+            if (digits == nullptr) {
+                return false;
+            }
+            hash.update_value('I');
+            const bool ok = hash_element(hash, digits);
+            Py_DECREF(digits);
+            return ok;
+        }
+    } else if (PyFloat_CheckExact(item)) {
+        hash.update_value('d');
+        hash.update_value(PyFloat_AS_DOUBLE(item));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief Hash the contents of a list or tuple for the try_array cache
+ */
+static PyObject* fastnumbers_content_hash(
+    PyObject* self, PyObject* const* args, Py_ssize_t len_args, PyObject* kwnames
+) noexcept
+{
+    const FunctionTrace trace("content_hash");
+
+    PyObject* input = nullptr;
+    PyObject* salt = nullptr;
+
+    // Read the function arguments
+    FN_PREPARE_ARGPARSER;
+    // clang-format off
+    if (fn_parse_arguments("content_hash", args, len_args, kwnames,
+                           "input", false, &input,
+                           "salt", false, &salt,
+                           nullptr, false, nullptr
+        )) return nullptr;
+    // clang-format on
+
+    if (!PyList_Check(input) && !PyTuple_Check(input)) {
+        PyErr_Format(
+            PyExc_TypeError,
+            "input must be a list or tuple, not '%s'",
+            Py_TYPE(input)->tp_name
+        );
+        return nullptr;
+    }
+
+    // The salt (e.g. the options of the conversion) is hashed first
+    ContentHash hash;
+    if (!hash_element(hash, salt)) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_TypeError, "salt must be a str or bytes");
+        }
+        return nullptr;
+    }
+
+    // Items are only borrowed and nothing is called, so the size is stable
+    const Py_ssize_t size = PySequence_Fast_GET_SIZE(input);
+    PyObject** items = PySequence_Fast_ITEMS(input);
+    hash.update_value(size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        if (!hash_element(hash, items[i])) {
+            if (PyErr_Occurred()) {
+                return nullptr;
+            }
+            Py_RETURN_NONE;
+        }
+    }
+
+    uint64_t high;
+    uint64_t low;
+    hash.digest(high, low);
+    char hex[33];
+    std::snprintf(
+        hex,
+        sizeof(hex),
+        "%016llx%016llx",
+        static_cast<unsigned long long>(high),
+        static_cast<unsigned long long>(low)
+    );
+    return PyUnicode_FromStringAndSize(hex, 32);
+}
+
 // Define the methods contained in this module
 static PyMethodDef FastnumbersMethods[] = {
     { "try_real",
@@ -1025,10 +2110,66 @@ static PyMethodDef FastnumbersMethods[] = {
       (PyCFunction)fastnumbers_try_forceint,
       METH_FASTCALL | METH_KEYWORDS,
       try_forceint__doc__ },
+    { "try_complex",
+      (PyCFunction)fastnumbers_try_complex,
+      METH_FASTCALL | METH_KEYWORDS,
+      try_complex__doc__ },
+    { "try_fraction",
+      (PyCFunction)fastnumbers_try_fraction,
+      METH_FASTCALL | METH_KEYWORDS,
+      try_fraction__doc__ },
+    { "try_decimal",
+      (PyCFunction)fastnumbers_try_decimal,
+      METH_FASTCALL | METH_KEYWORDS,
+      try_decimal__doc__ },
     { "array",
       (PyCFunction)fastnumbers_array,
       METH_FASTCALL | METH_KEYWORDS,
       "C-implementation of try_array" },
+    { "digitize",
+      (PyCFunction)fastnumbers_digitize,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of digitize_numeric" },
+    { "factorize",
+      (PyCFunction)fastnumbers_factorize,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of factorize_numeric" },
+    { "object_array",
+      (PyCFunction)fastnumbers_object_array,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of try_array for dtype object" },
+    { "sketch",
+      (PyCFunction)fastnumbers_sketch,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
+    { "sketch_update",
+      (PyCFunction)fastnumbers_sketch_update,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
+    { "sketch_add",
+      (PyCFunction)fastnumbers_sketch_add,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
+    { "sketch_merge",
+      (PyCFunction)fastnumbers_sketch_merge,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
+    { "sketch_quantiles",
+      (PyCFunction)fastnumbers_sketch_quantiles,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
+    { "sketch_summary",
+      (PyCFunction)fastnumbers_sketch_summary,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
+    { "sketch_dumps",
+      (PyCFunction)fastnumbers_sketch_dumps,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
+    { "sketch_loads",
+      (PyCFunction)fastnumbers_sketch_loads,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of NumericSketch" },
     { "check_real",
       (PyCFunction)fastnumbers_check_real,
       METH_FASTCALL | METH_KEYWORDS,
@@ -1090,6 +2231,26 @@ static PyMethodDef FastnumbersMethods[] = {
       (PyCFunction)fastnumbers_isintlike,
       METH_FASTCALL | METH_KEYWORDS,
       isintlike__doc__ },
+    { "cpu_features",
+      (PyCFunction)fastnumbers_cpu_features,
+      METH_NOARGS,
+      cpu_features__doc__ },
+    { "set_conversion_limits",
+      (PyCFunction)fastnumbers_set_conversion_limits,
+      METH_FASTCALL | METH_KEYWORDS,
+      set_conversion_limits__doc__ },
+    { "get_conversion_limits",
+      (PyCFunction)fastnumbers_get_conversion_limits,
+      METH_NOARGS,
+      get_conversion_limits__doc__ },
+    { "records",
+      (PyCFunction)fastnumbers_records,
+      METH_FASTCALL | METH_KEYWORDS,
+      "C-implementation of convert_records" },
+    { "content_hash",
+      (PyCFunction)fastnumbers_content_hash,
+      METH_FASTCALL | METH_KEYWORDS,
+      "Hash the contents of a list or tuple for the try_array cache" },
     { nullptr, nullptr, 0, nullptr } /* Sentinel */
 };
 
@@ -1115,6 +2276,9 @@ PyObject* Selectors::INPUT = nullptr;
 PyObject* Selectors::RAISE = nullptr;
 PyObject* Selectors::STRING_ONLY = nullptr;
 PyObject* Selectors::NUMBER_ONLY = nullptr;
+Py_ssize_t ConversionLimits::MAX_DIGITS = -1;
+Py_ssize_t ConversionLimits::MAX_EXPONENT = -1;
+Py_ssize_t ConversionLimits::INTERPRETER_MAX_STR_DIGITS = -1;
 
 // Actually create the module object itself
 PyMODINIT_FUNC PyInit_fastnumbers()
@@ -1,22 +1,36 @@
 /*
  * This file contains the high-level implementations for the Python-exposed functions
  */
+#include <cctype>
+#include <complex>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include <Python.h>
 
+#include "fastnumbers/bin_edges.hpp"
+#include "fastnumbers/compatibility.hpp"
 #include "fastnumbers/ctype_extractor.hpp"
 #include "fastnumbers/evaluator.hpp"
 #include "fastnumbers/exception.hpp"
 #include "fastnumbers/extractor.hpp"
+#include "fastnumbers/factorizer.hpp"
 #include "fastnumbers/implementation.hpp"
 #include "fastnumbers/iteration.hpp"
 #include "fastnumbers/parser.hpp"
 #include "fastnumbers/payload.hpp"
 #include "fastnumbers/resolver.hpp"
 #include "fastnumbers/selectors.hpp"
+#include "fastnumbers/sketch.hpp"
+#include "fastnumbers/tracing.hpp"
 #include "fastnumbers/user_options.hpp"
 
 PyObject* Implementation::convert(PyObject* input) const noexcept(false)
@@ -101,6 +115,278 @@ void Implementation::set_allowed_types(PyObject* val) noexcept(false)
     m_allowed_types = Selectors::incref(val);
 }
 
+/**
+ * \brief Read a single-character option as an ASCII character
+ * \param obj The Python object given by the user
+ * \param allow_space Whether a space is an acceptable character
+ * \return The character, or '\0' if it is not allowed
+ */
+static char read_format_character(PyObject* obj, const bool allow_space) noexcept
+{
+    if (!PyUnicode_Check(obj) || PyUnicode_GET_LENGTH(obj) != 1) {
+        return '\0';
+    }
+    const Py_UCS4 c = PyUnicode_READ_CHAR(obj, 0);
+    const bool ok = c == ' ' ? allow_space
+                             : (c < 128 && std::ispunct(static_cast<int>(c))
+                                && !is_sign(static_cast<char>(c)) && c != '(' && c != ')');
+    return ok ? static_cast<char>(c) : '\0';
+}
+
+/**
+ * \brief Add the suffixes of one of the built-in suffix sets to a table
+ * \param table The table to add to
+ * \param name The name of the set, "si", "iec" or "percent"
+ * \return false if the name is not of a built-in set
+ */
+static bool add_builtin_suffixes(SuffixTable& table, const std::string_view name)
+{
+    if (name == "si") {
+        constexpr const char* multiples[] = { "k", "M", "G", "T", "P", "E" };
+        constexpr const char* fractions[] = { "m", "u", "n" };
+        for (int32_t i = 0; i < 6; ++i) {
+            table.add(Suffix { multiples[i], 1, 0, 3 * (i + 1) });
+        }
+        for (int32_t i = 0; i < 3; ++i) {
+            table.add(Suffix { fractions[i], 1, 0, -3 * (i + 1) });
+        }
+    } else if (name == "iec") {
+        constexpr const char* prefixes[] = { "Ki", "Mi", "Gi", "Ti", "Pi", "Ei" };
+        for (uint32_t i = 0; i < 6; ++i) {
+            table.add(Suffix { prefixes[i], 1024, i + 1, 0 });
+            table.add(Suffix { std::string(prefixes[i]) + "B", 1024, i + 1, 0 });
+        }
+    } else if (name == "percent") {
+        table.add(Suffix { "%", 1, 0, -2 });
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/// The largest decimal exponent allowed in a user-given suffix multiplier
+static constexpr int64_t MAX_SUFFIX_POWER10 = 1000;
+
+/**
+ * \brief Read a user-given suffix multiplier into a Suffix
+ * \param text The suffix text
+ * \param value The multiplier, a positive int or float
+ * \throws fastnumbers_exception if the multiplier is not valid
+ */
+static Suffix read_suffix(const std::string& text, PyObject* value) noexcept(false)
+{
+    // Get the decimal representation of the multiplier.
+    std::string repr;
+    if (PyLong_CheckExact(value) || (PyLong_Check(value) && !PyBool_Check(value))) {
+        PyObject* str = PyObject_Str(value);
+        if (str == nullptr) {
+            throw exception_is_set();
+        }
+        repr = PyUnicode_AsUTF8(str);
+        Py_DECREF(str);
+    } else if (PyFloat_Check(value)) {
+        const double dval = PyFloat_AS_DOUBLE(value);
+        if (!std::isfinite(dval)) {
+            repr = "-";
+        } else {
+            char* str = PyOS_double_to_string(dval, 'r', 0, 0, nullptr);
+            if (str == nullptr) {
+                throw exception_is_set();
+            }
+            repr = str;
+            PyMem_Free(str);
+        }
+    } else {
+        PyErr_Format(
+            PyExc_TypeError,
+            "the multiplier for suffix '%s' must be an int or float, not %R",
+            text.c_str(),
+            value
+        );
+        throw exception_is_set();
+    }
+
+    // Split it into its significant digits and a power of ten.
+    std::string significand;
+    int64_t power10 = 0;
+    bool valid = repr.front() != '-';
+    bool after_point = false;
+    std::size_t i = 0;
+    for (; valid && i < repr.size() && repr[i] != 'e'; ++i) {
+        if (repr[i] == '.') {
+            after_point = true;
+            continue;
+        }
+        if (repr[i] != '0' || !significand.empty()) {
+            significand += repr[i];
+        }
+        power10 -= after_point ? 1 : 0;
+    }
+    if (i < repr.size()) {
+        power10 += std::strtol(repr.c_str() + i + 1, nullptr, 10);
+    }
+    while (!significand.empty() && significand.back() == '0') {
+        significand.pop_back();
+        power10 += 1;
+    }
+    valid = valid && !significand.empty() && significand.size() <= 9
+        && std::abs(power10) <= MAX_SUFFIX_POWER10;
+    if (!valid) {
+        throw fastnumbers_exception(
+            ("the multiplier for suffix '" + text
+             + "' must be positive and have at most 9 significant digits")
+                .c_str()
+        );
+    }
+
+    const uint32_t factor = static_cast<uint32_t>(std::stoul(significand));
+    return Suffix { text, factor, factor == 1 ? 0U : 1U, static_cast<int32_t>(power10) };
+}
+
+/**
+ * \brief Add user-given suffixes to a table
+ * \param table The table to add to
+ * \param suffixes A dict mapping suffix text to multiplier
+ * \throws fastnumbers_exception if a suffix is not valid
+ */
+static void add_user_suffixes(SuffixTable& table, PyObject* suffixes) noexcept(false)
+{
+    PyObject* key = nullptr;
+    PyObject* value = nullptr;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(suffixes, &pos, &key, &value)) {
+        if (!PyUnicode_Check(key)) {
+            PyErr_Format(PyExc_TypeError, "suffixes must be str, not %R", key);
+            throw exception_is_set();
+        }
+        const char* text = PyUnicode_AsUTF8(key);
+        if (text == nullptr) {
+            throw exception_is_set();
+        }
+
+        // The suffix must not be confused with part of a number.
+        bool valid = text[0] != '\0' && !is_sign(text[0]) && text[0] != '.';
+        for (const char* c = text; valid && *c != '\0'; ++c) {
+            const auto uc = static_cast<unsigned char>(*c);
+            valid = uc < 128 && std::isgraph(uc) && !std::isdigit(uc);
+        }
+        if (!valid) {
+            throw fastnumbers_exception(
+                ("suffix '" + std::string(text)
+                 + "' must be ASCII, must not be empty, must not contain digits or "
+                   "whitespace, and must not start with a sign or '.'")
+                    .c_str()
+            );
+        }
+        table.add(read_suffix(text, value));
+    }
+}
+
+/**
+ * \brief Create a table of suffixes from the option given by the user
+ * \param suffixes The name of a built-in set, a dict of suffix to multiplier,
+ *                 or a list or tuple of these
+ * \return The table, or nullptr if suffixes is None
+ * \throws fastnumbers_exception if the option is not valid
+ */
+static std::shared_ptr<const SuffixTable> create_suffix_table(PyObject* suffixes
+) noexcept(false)
+{
+    if (suffixes == nullptr || suffixes == Py_None) {
+        return nullptr;
+    }
+
+    // The built-in sets are cached since they are commonly used alone.
+    auto builtin = [](const char* name) {
+        auto table = std::make_shared<SuffixTable>();
+        add_builtin_suffixes(*table, name);
+        return std::shared_ptr<const SuffixTable>(table);
+    };
+    static const std::shared_ptr<const SuffixTable> si = builtin("si");
+    static const std::shared_ptr<const SuffixTable> iec = builtin("iec");
+    static const std::shared_ptr<const SuffixTable> percent = builtin("percent");
+
+    const bool is_sequence = PyList_Check(suffixes) || PyTuple_Check(suffixes);
+    if (!is_sequence && !PyUnicode_Check(suffixes) && !PyDict_Check(suffixes)) {
+        PyErr_Format(
+            PyExc_TypeError,
+            "suffixes must be a str, dict, or a list or tuple of these, not %R",
+            suffixes
+        );
+        throw exception_is_set();
+    }
+
+    auto table = std::make_shared<SuffixTable>();
+    const Py_ssize_t count = is_sequence ? PySequence_Fast_GET_SIZE(suffixes) : 1;
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        PyObject* item = is_sequence ? PySequence_Fast_GET_ITEM(suffixes, i) : suffixes;
+        if (PyDict_Check(item)) {
+            add_user_suffixes(*table, item);
+        } else if (PyUnicode_Check(item)) {
+            const char* name = PyUnicode_AsUTF8(item);
+            if (name == nullptr) {
+                throw exception_is_set();
+            }
+            if (!is_sequence) {
+                const std::string_view view(name);
+                if (view == "si") {
+                    return si;
+                } else if (view == "iec") {
+                    return iec;
+                } else if (view == "percent") {
+                    return percent;
+                }
+            }
+            if (!add_builtin_suffixes(*table, name)) {
+                throw fastnumbers_exception(
+                    "the names of the built-in suffixes are 'si', 'iec', and "
+                    "'percent'"
+                );
+            }
+        } else {
+            PyErr_Format(
+                PyExc_TypeError, "suffixes must contain only str or dict, not %R", item
+            );
+            throw exception_is_set();
+        }
+    }
+    return table->empty() ? nullptr : std::shared_ptr<const SuffixTable>(table);
+}
+
+NumberFormat create_number_format(
+    PyObject* decimal_point,
+    PyObject* thousands,
+    const bool accounting,
+    PyObject* suffixes
+) noexcept(false)
+{
+    NumberFormat format;
+    format.accounting = accounting;
+    format.suffixes = create_suffix_table(suffixes);
+    if (decimal_point != nullptr) {
+        format.decimal_point = read_format_character(decimal_point, false);
+        if (format.decimal_point == '\0') {
+            throw fastnumbers_exception(
+                "'decimal_point' must be a single ASCII punctuation character "
+                "other than a sign or parenthesis"
+            );
+        }
+    }
+    if (thousands != nullptr && thousands != Py_None) {
+        format.thousands = read_format_character(thousands, true);
+        if (format.thousands == '\0') {
+            throw fastnumbers_exception(
+                "'thousands' must be None or a single space or ASCII punctuation "
+                "character other than a sign or parenthesis"
+            );
+        }
+    }
+    if (format.thousands == format.decimal_point) {
+        throw fastnumbers_exception("'decimal_point' and 'thousands' must differ");
+    }
+    return format;
+}
+
 Payload Implementation::collect_payload(PyObject* obj) const noexcept(false)
 {
     Buffer buffer;
@@ -113,7 +399,7 @@ Payload Implementation::collect_payload(PyObject* obj) const noexcept(false)
         [this, obj](const auto& parser) -> Payload {
             return Evaluator<decltype(parser)>(obj, m_options, parser).as_type(m_ntype);
         },
-        extract_parser(obj, buffer, m_options)
+        extract_parser(obj, buffer, m_options, m_speculation)
     );
 }
 
@@ -225,6 +511,48 @@ PyObject* list_iteration_impl(
     return list_builder.get();
 }
 
+// Implementation for replacing the elements of a list with their conversions
+PyObject* inplace_iteration_impl(
+    PyObject* input, std::function<PyObject*(PyObject*)> convert
+) noexcept(false)
+{
+    if (!PyList_Check(input)) {
+        PyErr_Format(
+            PyExc_TypeError,
+            "map='inplace' requires a list, not '%.200s'",
+            Py_TYPE(input)->tp_name
+        );
+        throw exception_is_set();
+    }
+
+    // The size is checked on each iteration because a callable given by
+    // the user (e.g. for on_fail) could change the list. Each element is
+    // held while it is converted for the same reason.
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(input); ++i) {
+        PyObject* item = PyList_GET_ITEM(input, i);
+        Py_INCREF(item);
+        PyObject* result = nullptr;
+        try {
+            result = convert(item);
+        } catch (...) {
+            Py_DECREF(item);
+            throw;
+        }
+        Py_DECREF(item);
+        if (result == nullptr) {
+            throw exception_is_set();
+        }
+
+        // Steals the result and releases the original element
+        if (PyList_SetItem(input, i, result) != 0) {
+            throw exception_is_set();
+        }
+    }
+
+    Py_INCREF(input);
+    return input;
+}
+
 /**
  * \struct FastnumbersIterator
  * \brief Object containing the state of the fastnumbers iterator
@@ -367,174 +695,1521 @@ PyObject* iter_iteration_impl(
 }
 
 /**
- * \struct ArrayImpl
- * \brief Executor of array population, manages Python memory buffer
+ * \struct FastnumbersLazySequence
+ * \brief Object containing the state of the fastnumbers lazy sequence
+ *
+ * This is a PyObject "subclass" that converts the elements of a sequence
+ * only when they are accessed, and remembers each result so that it is
+ * converted at most once. The results may be any Python object (e.g. the
+ * input itself with the default on_fail), so they are cached as objects,
+ * and a slot that has not been converted yet is nullptr.
+ *
+ * It is written in a very C-like way because it has to interface with C-code.
  */
-struct ArrayImpl {
-    /// The input object as given by Python
-    PyObject* m_input;
+struct FastnumbersLazySequence {
+    // clang-format off
+    PyObject_HEAD
 
-    /// The output object, represented as a memory view buffer
-    Py_buffer& m_output;
+    /// The input as a list or tuple, from PySequence_Fast
+    PyObject* ls_input;
+    // clang-format on
 
-    /// The action to take if INF is found
-    PyObject* m_inf;
+    /// The number of elements, fixed when the sequence is created
+    Py_ssize_t ls_size;
 
-    /// The action to take if NaN is found
-    PyObject* m_nan;
+    /// The conversion of each element
+    Implementation* ls_impl;
 
-    /// The action to take if input is invalid
-    PyObject* m_on_fail;
+    /// The converted elements, or nullptr for those not yet converted
+    std::vector<PyObject*>* ls_cache;
 
-    /// The action to take if input overflows
-    PyObject* m_on_overflow;
+    /// The number of elements that have been converted
+    Py_ssize_t ls_converted;
 
-    /// The action to take if input is of incorrect type
-    PyObject* m_on_type_error;
+    /// The data exported with the buffer protocol, created when first requested
+    std::vector<char>* ls_export;
 
-    /// Whether or not to allow underscores in strings
-    bool m_allow_underscores;
+    /// The format of the exported data, "d" or "q"
+    char ls_format[2];
 
-    /// The base to use when parsing integers
-    int m_base;
+    /// The size of each exported element, in bytes
+    Py_ssize_t ls_itemsize;
 
-    /// Release the Python memoryview buffer
-    ~ArrayImpl() noexcept { PyBuffer_Release(&m_output); }
+    /// Deallocate the lazy sequence object
+    static void dealloc(FastnumbersLazySequence* ls) noexcept
+    {
+        PyObject_GC_UnTrack(ls);
+        for (PyObject* value : *ls->ls_cache) {
+            Py_XDECREF(value);
+        }
+        Py_DECREF(ls->ls_input);
+        delete ls->ls_impl;
+        delete ls->ls_cache;
+        delete ls->ls_export;
+        PyObject_GC_Del(ls);
+    }
 
-    /// Perform the actual array population logic
-    template <typename T>
-    void execute() noexcept(false)
+    /// Visit the Python objects held, for the garbage collector
+    static int
+    traverse(FastnumbersLazySequence* ls, visitproc visit, void* arg) noexcept
     {
-        UserOptions options;
-        options.set_base(m_base);
-        options.set_underscores_allowed(m_allow_underscores);
+        Py_VISIT(ls->ls_input);
+        for (PyObject* value : *ls->ls_cache) {
+            Py_VISIT(value);
+        }
+        return ls->ls_impl->traverse(visit, arg);
+    }
 
-        // Define how a Python object can be converted into a C number type
-        CTypeExtractor<T> extractor(options);
-        extractor.set_inf_replacement(m_inf);
-        extractor.set_nan_replacement(m_nan);
-        extractor.set_fail_replacement(m_on_fail);
-        extractor.set_overflow_replacement(m_on_overflow);
-        extractor.set_type_error_replacement(m_on_type_error);
+    /// Release the converted elements and the replacements, to break cycles
+    static int clear(FastnumbersLazySequence* ls) noexcept
+    {
+        for (PyObject*& value : *ls->ls_cache) {
+            Py_CLEAR(value);
+        }
+        ls->ls_converted = 0;
+        ls->ls_impl->clear();
+        return 0;
+    }
 
-        // Define how we convert each element of the iterable
-        IterableManager<T> iter_man(m_input, [&extractor](PyObject* x) -> T {
-            return extractor.extract_c_number(x);
-        });
+    /// Return the number of elements
+    static Py_ssize_t length(FastnumbersLazySequence* ls) noexcept
+    {
+        return ls->ls_size;
+    }
 
-        // Create a handler for inserting data into the output memory buffer
-        ArrayPopulator pop(m_output, iter_man.get_size());
+    /// Return the converted element at an index, converting it if needed
+    static PyObject* item(FastnumbersLazySequence* ls, Py_ssize_t index) noexcept
+    {
+        if (index < 0 || index >= ls->ls_size) {
+            PyErr_SetString(PyExc_IndexError, "lazy sequence index out of range");
+            return nullptr;
+        }
+
+        PyObject*& cached = (*ls->ls_cache)[static_cast<std::size_t>(index)];
+        if (cached == nullptr) {
+            // The input may be a list that has shrunk since we were created
+            if (index >= PySequence_Fast_GET_SIZE(ls->ls_input)) {
+                PyErr_SetString(
+                    PyExc_RuntimeError, "the input of the lazy sequence changed size"
+                );
+                return nullptr;
+            }
+
+            // Hold the element in case the conversion modifies the input
+            PyObject* element = PySequence_Fast_GET_ITEM(ls->ls_input, index);
+            Py_INCREF(element);
+            PyObject* result = ExceptionHandler(element).run([&]() -> PyObject* {
+                return ls->ls_impl->convert(element);
+            });
+            Py_DECREF(element);
+            if (result == nullptr) {
+                return nullptr;
+            }
 
-        // Iterate over the input data, convert it, and place it in the output
-        for (const auto& value : iter_man) {
-            pop.place_next(value);
+            // A callable replacement may have accessed this element re-entrantly
+            if (cached != nullptr) {
+                Py_DECREF(result);
+            } else {
+                cached = result;
+                ls->ls_converted += 1;
+            }
         }
+        Py_INCREF(cached);
+        return cached;
     }
-};
 
-/**
- * \brief Validate the selector is not a "yes, no, num, str, input" value
- * \param selector The python object to validate
- * \throws fastnumbers_exception if one of the four valid values
- */
-static inline void validate_not_allow_disallow_str_only_num_only_input(
-    const PyObject* selector
-) noexcept(false)
-{
-    const bool bad = selector == Selectors::ALLOWED || selector == Selectors::DISALLOWED
-        || selector == Selectors::NUMBER_ONLY || selector == Selectors::STRING_ONLY
-        || selector == Selectors::INPUT;
-    if (bad) {
-        throw fastnumbers_exception(
-            "values for 'on_fail', 'on_overflow', and 'on_type_error' cannot be "
-            "fastnumbers.ALLOWED, fastnumbers.DISALLOWED, fastnumbers.NUMBER_ONLY, "
-            "fastnumbers.STRING_ONLY, or fastnumbers.INPUT"
-        );
+    /// Return the converted element at an index or a list of a slice
+    static PyObject* subscript(FastnumbersLazySequence* ls, PyObject* key) noexcept
+    {
+        if (PyIndex_Check(key)) {
+            Py_ssize_t index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+            if (index == -1 && PyErr_Occurred()) {
+                return nullptr;
+            }
+            return item(ls, index < 0 ? index + ls->ls_size : index);
+        }
+        if (!PySlice_Check(key)) {
+            PyErr_Format(
+                PyExc_TypeError,
+                "lazy sequence indices must be integers or slices, not %.200s",
+                Py_TYPE(key)->tp_name
+            );
+            return nullptr;
+        }
+
+        Py_ssize_t start = 0;
+        Py_ssize_t stop = 0;
+        Py_ssize_t step = 0;
+        if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+            return nullptr;
+        }
+        const Py_ssize_t count
+            = PySlice_AdjustIndices(ls->ls_size, &start, &stop, step);
+        PyObject* list = PyList_New(count);
+        if (list == nullptr) {
+            return nullptr;
+        }
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            PyObject* value = item(ls, start + i * step);
+            if (value == nullptr) {
+                Py_DECREF(list);
+                return nullptr;
+            }
+            PyList_SET_ITEM(list, i, value);
+        }
+        return list;
     }
-}
 
-/**
- * \brief Validate the selector is not a "no, num, str, input" value
- * \param selector The python object to validate
- * \throws fastnumbers_exception if one of the four valid values
- */
-static inline void
-validate_not_disallow_str_only_num_only_input(const PyObject* selector) noexcept(false)
-{
-    const bool bad = selector == Selectors::DISALLOWED
-        || selector == Selectors::NUMBER_ONLY || selector == Selectors::STRING_ONLY
-        || selector == Selectors::INPUT || selector == Selectors::RAISE;
-    if (bad) {
-        throw fastnumbers_exception(
-            "values for 'inf' and 'nan' cannot be fastnumbers.DISALLOWED, "
-            "fastnumbers.NUMBER_ONLY, fastnumbers.STRING_ONLY, fastnumbers.INPUT "
-            "or fastnumbers.RAISE"
+    /**
+     * \brief Convert all elements into the exported buffer data
+     *
+     * If all elements are converted to int and fit in 64 bits the format
+     * is "q", otherwise if all are int or float it is "d".
+     *
+     * \return false with a Python exception set on failure, otherwise true
+     */
+    static bool create_export(FastnumbersLazySequence* ls) noexcept
+    {
+        bool all_int = true;
+        for (Py_ssize_t i = 0; i < ls->ls_size; ++i) {
+            PyObject* value = item(ls, i);
+            if (value == nullptr) {
+                return false;
+            }
+            // An int too wide for 64 bits can only be exported as a double
+            bool is_int = PyLong_Check(value);
+            if (is_int && all_int) {
+                int overflow = 0;
+                const long long ival = PyLong_AsLongLongAndOverflow(value, &overflow);
+                if (ival == -1 && PyErr_Occurred()) {
+                    Py_DECREF(value);
+                    return false;
+                }
+                is_int = overflow == 0;
+            }
+            const bool is_float = PyFloat_Check(value);
+            const bool is_number = PyLong_Check(value) || is_float;
+            Py_DECREF(value);
+            if (!is_number) {
+                PyErr_Format(
+                    PyExc_BufferError,
+                    "cannot export the lazy sequence because element %zd was "
+                    "converted to %.200R, which is not an int or float",
+                    i,
+                    (*ls->ls_cache)[static_cast<std::size_t>(i)]
+                );
+                return false;
+            }
+            all_int = all_int && is_int;
+        }
+
+        ls->ls_format[0] = all_int ? 'q' : 'd';
+        ls->ls_itemsize = all_int ? sizeof(long long) : sizeof(double);
+        auto data = std::make_unique<std::vector<char>>(
+            static_cast<std::size_t>(ls->ls_size * ls->ls_itemsize)
         );
+        for (Py_ssize_t i = 0; i < ls->ls_size; ++i) {
+            PyObject* value = (*ls->ls_cache)[static_cast<std::size_t>(i)];
+            char* dest = data->data() + i * ls->ls_itemsize;
+            if (all_int) {
+                const long long ival = PyLong_AsLongLong(value);
+                if (ival == -1 && PyErr_Occurred()) {
+                    return false;
+                }
+                std::memcpy(dest, &ival, sizeof(ival));
+            } else {
+                const double dval = PyFloat_AsDouble(value);
+                if (dval == -1.0 && PyErr_Occurred()) {
+                    return false;
+                }
+                std::memcpy(dest, &dval, sizeof(dval));
+            }
+        }
+        ls->ls_export = data.release();
+        return true;
     }
-}
-
-// Implementation for iterating over a collection to populate an array
-void array_impl(
-    PyObject* input,
-    PyObject* output,
-    PyObject* inf,
-    PyObject* nan,
-    PyObject* on_fail,
-    PyObject* on_overflow,
-    PyObject* on_type_error,
-    bool allow_underscores,
-    int base
-) noexcept(false)
-{
-    // Ensure the given parameters are valid.
-    validate_not_disallow_str_only_num_only_input(inf);
-    validate_not_disallow_str_only_num_only_input(nan);
-    validate_not_allow_disallow_str_only_num_only_input(on_fail);
-    validate_not_allow_disallow_str_only_num_only_input(on_overflow);
-    validate_not_allow_disallow_str_only_num_only_input(on_type_error);
 
-    // Extract the underlying buffer data from the output object
-    Py_buffer buf { nullptr, nullptr };
-    constexpr auto flags = PyBUF_WRITABLE | PyBUF_STRIDES | PyBUF_FORMAT;
-    if (PyObject_GetBuffer(output, &buf, flags) != 0) {
-        // This should be impossible to encounter because of guards in the python code
-        throw exception_is_set();
+    /// Export the converted elements with the buffer protocol
+    static int
+    get_buffer(FastnumbersLazySequence* ls, Py_buffer* view, int flags) noexcept
+    {
+        if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+            PyErr_SetString(PyExc_BufferError, "the lazy sequence is read-only");
+            return -1;
+        }
+        if (ls->ls_export == nullptr && !create_export(ls)) {
+            return -1;
+        }
+        view->buf = ls->ls_export->data();
+        view->obj = (PyObject*)ls;
+        Py_INCREF(view->obj);
+        view->len = ls->ls_size * ls->ls_itemsize;
+        view->itemsize = ls->ls_itemsize;
+        view->readonly = 1;
+        view->ndim = 1;
+        view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? ls->ls_format : nullptr;
+        view->shape = (flags & PyBUF_ND) == PyBUF_ND ? &ls->ls_size : nullptr;
+        view->strides
+            = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &ls->ls_itemsize : nullptr;
+        view->suboffsets = nullptr;
+        view->internal = nullptr;
+        return 0;
     }
 
-    // Pass on all arguments to the actual implementation
-    // NOTE: This will manage the buffer object for us
+    /// Report how much of the sequence has been converted
+    static PyObject* repr(FastnumbersLazySequence* ls) noexcept
+    {
+        return PyUnicode_FromFormat(
+            "<fastnumbers lazy sequence of %zd elements, %zd converted>",
+            ls->ls_size,
+            ls->ls_converted
+        );
+    }
+};
+
+/// The sequence methods of the fastnumbers lazy sequence
+static PySequenceMethods fastnumbers_lazy_sequence_as_sequence = {
+    (lenfunc)FastnumbersLazySequence::length, /* sq_length */
+    0, /* sq_concat */
+    0, /* sq_repeat */
+    (ssizeargfunc)FastnumbersLazySequence::item, /* sq_item */
+    0,
+};
+
+/// The mapping methods of the fastnumbers lazy sequence, for slicing
+static PyMappingMethods fastnumbers_lazy_sequence_as_mapping = {
+    (lenfunc)FastnumbersLazySequence::length, /* mp_length */
+    (binaryfunc)FastnumbersLazySequence::subscript, /* mp_subscript */
+    0, /* mp_ass_subscript */
+};
+
+/// The buffer methods of the fastnumbers lazy sequence
+static PyBufferProcs fastnumbers_lazy_sequence_as_buffer = {
+    (getbufferproc)FastnumbersLazySequence::get_buffer, /* bf_getbuffer */
+    0, /* bf_releasebuffer */
+};
+
+/// The fastnumbers lazy sequence type object definition
+PyTypeObject FastnumbersLazySequenceType = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0) "fastnumbers_lazy_sequence", /* tp_name */
+    sizeof(FastnumbersLazySequence), /* tp_basicsize */
+    0, /* tp_itemsize */
+    /* methods */
+    (destructor)FastnumbersLazySequence::dealloc, /* tp_dealloc */
+    0, /* tp_vectorcall_offset */
+    0, /* tp_getattr */
+    0, /* tp_setattr */
+    0, /* tp_as_async */
+    (reprfunc)FastnumbersLazySequence::repr, /* tp_repr */
+    0, /* tp_as_number */
+    &fastnumbers_lazy_sequence_as_sequence, /* tp_as_sequence */
+    &fastnumbers_lazy_sequence_as_mapping, /* tp_as_mapping */
+    0, /* tp_hash */
+    0, /* tp_call */
+    0, /* tp_str */
+    PyObject_GenericGetAttr, /* tp_getattro */
+    0, /* tp_setattro */
+    &fastnumbers_lazy_sequence_as_buffer, /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_SEQUENCE, /* tp_flags */
+    0, /* tp_doc */
+    (traverseproc)FastnumbersLazySequence::traverse, /* tp_traverse */
+    (inquiry)FastnumbersLazySequence::clear, /* tp_clear */
+    0,
+};
+
+// Implementation for converting a collection only as its elements are accessed
+PyObject* lazy_iteration_impl(PyObject* input, Implementation impl) noexcept(false)
+{
+    if (PyType_Ready(&FastnumbersLazySequenceType) < 0) {
+        throw exception_is_set();
+    }
+
+    // Hold the input as a list or tuple, collecting it first if needed
+    PyObject* sequence = PySequence_Fast(input, "lazy conversion requires an iterable");
+    if (sequence == nullptr) {
+        throw exception_is_set();
+    }
+
+    FastnumbersLazySequence* ls
+        = PyObject_GC_New(FastnumbersLazySequence, &FastnumbersLazySequenceType);
+    if (ls == nullptr) {
+        Py_DECREF(sequence);
+        throw exception_is_set();
+    }
+    ls->ls_input = sequence;
+    ls->ls_size = PySequence_Fast_GET_SIZE(sequence);
+    ls->ls_impl = new Implementation(std::move(impl));
+    ls->ls_cache = new std::vector<PyObject*>(static_cast<std::size_t>(ls->ls_size));
+    ls->ls_converted = 0;
+    ls->ls_export = nullptr;
+    ls->ls_format[0] = ls->ls_format[1] = '\0';
+    ls->ls_itemsize = 0;
+    PyObject_GC_Track(ls);
+
+    // Return our lazy sequence instance to Python-land
+    return (PyObject*)ls;
+}
+
+/**
+ * \struct FastnumbersConverter
+ * \brief Object holding the conversion function prepared by a try_* function
+ *
+ * This lets the options of a conversion be read once, after which the
+ * conversion can be applied many times from C++ with no call overhead,
+ * e.g. by records_impl(). It can also be called from Python.
+ *
+ * It is written in a very C-like way because it has to interface with C-code.
+ */
+struct FastnumbersConverter {
+    // clang-format off
+    PyObject_HEAD
+
+    /// The conversion of a value
+    Implementation* cv_impl;
+    // clang-format on
+
+    /// Deallocate the converter object
+    static void dealloc(FastnumbersConverter* cv) noexcept
+    {
+        PyObject_GC_UnTrack(cv);
+        delete cv->cv_impl;
+        PyObject_GC_Del(cv);
+    }
+
+    /// Visit the Python objects held, for the garbage collector
+    static int traverse(FastnumbersConverter* cv, visitproc visit, void* arg) noexcept
+    {
+        return cv->cv_impl->traverse(visit, arg);
+    }
+
+    /// Release the replacements, to break cycles
+    static int clear(FastnumbersConverter* cv) noexcept
+    {
+        cv->cv_impl->clear();
+        return 0;
+    }
+
+    /// Convert the single argument
+    static PyObject*
+    call(FastnumbersConverter* cv, PyObject* args, PyObject* kwargs) noexcept
+    {
+        PyObject* input = nullptr;
+        if (kwargs != nullptr && PyDict_GET_SIZE(kwargs) != 0) {
+            PyErr_SetString(PyExc_TypeError, "converter takes no keyword arguments");
+            return nullptr;
+        }
+        if (!PyArg_UnpackTuple(args, "converter", 1, 1, &input)) {
+            return nullptr;
+        }
+        return ExceptionHandler(input).run([&]() -> PyObject* {
+            return cv->cv_impl->convert(input);
+        });
+    }
+};
+
+/// The fastnumbers converter type object definition
+PyTypeObject FastnumbersConverterType = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0) "fastnumbers_converter", /* tp_name */
+    sizeof(FastnumbersConverter), /* tp_basicsize */
+    0, /* tp_itemsize */
+    /* methods */
+    (destructor)FastnumbersConverter::dealloc, /* tp_dealloc */
+    0, /* tp_vectorcall_offset */
+    0, /* tp_getattr */
+    0, /* tp_setattr */
+    0, /* tp_as_async */
+    0, /* tp_repr */
+    0, /* tp_as_number */
+    0, /* tp_as_sequence */
+    0, /* tp_as_mapping */
+    0, /* tp_hash */
+    (ternaryfunc)FastnumbersConverter::call, /* tp_call */
+    0, /* tp_str */
+    PyObject_GenericGetAttr, /* tp_getattro */
+    0, /* tp_setattro */
+    0, /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, /* tp_flags */
+    0, /* tp_doc */
+    (traverseproc)FastnumbersConverter::traverse, /* tp_traverse */
+    (inquiry)FastnumbersConverter::clear, /* tp_clear */
+    0,
+};
+
+// Implementation for preparing a conversion to be applied later
+PyObject* converter_impl(Implementation impl) noexcept(false)
+{
+    if (PyType_Ready(&FastnumbersConverterType) < 0) {
+        throw exception_is_set();
+    }
+    FastnumbersConverter* cv
+        = PyObject_GC_New(FastnumbersConverter, &FastnumbersConverterType);
+    if (cv == nullptr) {
+        throw exception_is_set();
+    }
+    cv->cv_impl = new Implementation(std::move(impl));
+    PyObject_GC_Track(cv);
+    return (PyObject*)cv;
+}
+
+/**
+ * \class RecordWalker
+ * \brief Visit the records (dicts) of a payload to convert or collect fields
+ *
+ * Without recursion, the payload must be a sequence of records. With
+ * recursion, every dict found by descending through dicts, lists, and
+ * tuples is a record, and records without any of the fields are skipped
+ * when collecting so that e.g. a nested metadata dict adds no row.
+ */
+class RecordWalker {
+public:
+    /**
+     * \brief Prepare to walk the records
+     * \param fields A dict of field name to converter, or a sequence of
+     *               field names if collecting
+     * \param collect Whether to collect the field values instead of converting
+     * \param recurse Whether to look for records inside of records and lists
+     */
+    RecordWalker(PyObject* fields, const bool collect, const bool recurse) noexcept(
+        false
+    )
+        : m_keys()
+        , m_converters()
+        , m_columns()
+        , m_collect(collect)
+        , m_recurse(recurse)
+    {
+        if (collect) {
+            PyObject* keys = PySequence_Fast(fields, "fields must be iterable");
+            if (keys == nullptr) {
+                throw exception_is_set();
+            }
+            for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(keys); ++i) {
+                add_key(PySequence_Fast_GET_ITEM(keys, i));
+                m_columns.push_back(PyList_New(0));
+                if (m_columns.back() == nullptr) {
+                    Py_DECREF(keys);
+                    throw exception_is_set();
+                }
+            }
+            Py_DECREF(keys);
+        } else {
+            if (!PyDict_Check(fields)) {
+                PyErr_SetString(PyExc_TypeError, "fields must be a dict");
+                throw exception_is_set();
+            }
+            Py_ssize_t pos = 0;
+            PyObject* key = nullptr;
+            PyObject* converter = nullptr;
+            while (PyDict_Next(fields, &pos, &key, &converter)) {
+                if (!PyObject_TypeCheck(converter, &FastnumbersConverterType)) {
+                    PyErr_SetString(
+                        PyExc_TypeError, "the values of fields must be converters"
+                    );
+                    throw exception_is_set();
+                }
+                add_key(key);
+                m_converters.push_back(
+                    reinterpret_cast<FastnumbersConverter*>(converter)->cv_impl
+                );
+            }
+        }
+    }
+
+    // Deleted
+    RecordWalker(const RecordWalker&) = delete;
+    RecordWalker(RecordWalker&&) = delete;
+    RecordWalker& operator=(const RecordWalker&) = delete;
+
+    /// Release the keys and any columns not taken
+    ~RecordWalker() noexcept
+    {
+        for (PyObject* key : m_keys) {
+            Py_DECREF(key);
+        }
+        for (PyObject* column : m_columns) {
+            Py_XDECREF(column);
+        }
+    }
+
+    /// Visit each record of the payload
+    void walk(PyObject* input) noexcept(false)
+    {
+        PyObject* records = PySequence_Fast(input, "records must be iterable");
+        if (records == nullptr) {
+            throw exception_is_set();
+        }
+        try {
+            // The size is checked each time since a callable could change it
+            for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(records); ++i) {
+                PyObject* record = PySequence_Fast_GET_ITEM(records, i);
+                if (m_recurse) {
+                    visit(record);
+                } else if (PyDict_Check(record)) {
+                    Py_INCREF(record);
+                    try {
+                        visit_record(record);
+                    } catch (...) {
+                        Py_DECREF(record);
+                        throw;
+                    }
+                    Py_DECREF(record);
+                } else {
+                    PyErr_Format(
+                        PyExc_TypeError,
+                        "records must be dicts, not '%.200s'",
+                        Py_TYPE(record)->tp_name
+                    );
+                    throw exception_is_set();
+                }
+            }
+        } catch (...) {
+            Py_DECREF(records);
+            throw;
+        }
+        Py_DECREF(records);
+    }
+
+    /// Return a new list of the collected columns, in the order of the fields
+    PyObject* columns() noexcept(false)
+    {
+        PyObject* result = PyList_New(static_cast<Py_ssize_t>(m_columns.size()));
+        if (result == nullptr) {
+            throw exception_is_set();
+        }
+        for (std::size_t i = 0; i < m_columns.size(); ++i) {
+            PyList_SET_ITEM(result, static_cast<Py_ssize_t>(i), m_columns[i]);
+            m_columns[i] = nullptr;
+        }
+        return result;
+    }
+
+private:
+    /// The field names, interned if they are strings
+    std::vector<PyObject*> m_keys;
+
+    /// The conversion of each field, if converting
+    std::vector<const Implementation*> m_converters;
+
+    /// The values of each field, if collecting
+    std::vector<PyObject*> m_columns;
+
+    /// Whether to collect the field values instead of converting
+    bool m_collect;
+
+    /// Whether to look for records inside of records and lists
+    bool m_recurse;
+
+private:
+    /// Store a new reference to a field name, interning a string so that
+    /// dict lookups can often succeed on identity alone
+    void add_key(PyObject* key) noexcept(false)
+    {
+        Py_INCREF(key);
+        if (PyUnicode_CheckExact(key)) {
+            PyUnicode_InternInPlace(&key);
+        } else if (PyObject_Hash(key) == -1) {
+            Py_DECREF(key);
+            throw exception_is_set();
+        }
+        m_keys.push_back(key);
+    }
+
+    /// Look for records inside an object of any type
+    void visit(PyObject* obj) noexcept(false)
+    {
+        const bool is_dict = PyDict_Check(obj);
+        if (!is_dict && !PyList_Check(obj) && !PyTuple_Check(obj)) {
+            return;
+        }
+        if (Py_EnterRecursiveCall(" while looking for records")) {
+            throw exception_is_set();
+        }
+        // Hold the object since converting can run arbitrary code
+        Py_INCREF(obj);
+        try {
+            if (is_dict) {
+                visit_record(obj);
+            } else {
+                for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(obj); ++i) {
+                    visit(PySequence_Fast_GET_ITEM(obj, i));
+                }
+            }
+        } catch (...) {
+            Py_DECREF(obj);
+            Py_LeaveRecursiveCall();
+            throw;
+        }
+        Py_DECREF(obj);
+        Py_LeaveRecursiveCall();
+    }
+
+    /// Convert or collect the fields of one record, then look inside it
+    void visit_record(PyObject* record) noexcept(false)
+    {
+        if (m_collect) {
+            collect_fields(record);
+        } else {
+            convert_fields(record);
+        }
+        if (m_recurse) {
+            visit_values(record);
+        }
+    }
+
+    /// Replace each field of the record with its conversion
+    void convert_fields(PyObject* record) noexcept(false)
+    {
+        for (std::size_t i = 0; i < m_keys.size(); ++i) {
+            PyObject* value = PyDict_GetItemWithError(record, m_keys[i]);
+            if (value == nullptr) {
+                if (PyErr_Occurred()) {
+                    throw exception_is_set();
+                }
+                continue;
+            }
+            Py_INCREF(value);
+            PyObject* result = nullptr;
+            try {
+                result = m_converters[i]->convert(value);
+            } catch (...) {
+                Py_DECREF(value);
+                throw;
+            }
+            Py_DECREF(value);
+            if (result == nullptr) {
+                throw exception_is_set();
+            }
+            const int status = PyDict_SetItem(record, m_keys[i], result);
+            Py_DECREF(result);
+            if (status != 0) {
+                throw exception_is_set();
+            }
+        }
+    }
+
+    /// Append each field of the record to its column, or None if it is missing
+    void collect_fields(PyObject* record) noexcept(false)
+    {
+        // When recursing, only dicts that have a field are records
+        bool found = !m_recurse;
+        for (std::size_t i = 0; !found && i < m_keys.size(); ++i) {
+            found = PyDict_GetItemWithError(record, m_keys[i]) != nullptr;
+            if (!found && PyErr_Occurred()) {
+                throw exception_is_set();
+            }
+        }
+        if (!found) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < m_keys.size(); ++i) {
+            PyObject* value = PyDict_GetItemWithError(record, m_keys[i]);
+            if (value == nullptr && PyErr_Occurred()) {
+                throw exception_is_set();
+            }
+            if (PyList_Append(m_columns[i], value == nullptr ? Py_None : value) != 0) {
+                throw exception_is_set();
+            }
+        }
+    }
+
+    /// Look for records in the values of a record
+    void visit_values(PyObject* record) noexcept(false)
+    {
+        // Collected first because converting could change the record
+        PyObject* values = PyDict_Values(record);
+        if (values == nullptr) {
+            throw exception_is_set();
+        }
+        try {
+            for (Py_ssize_t i = 0; i < PyList_GET_SIZE(values); ++i) {
+                visit(PyList_GET_ITEM(values, i));
+            }
+        } catch (...) {
+            Py_DECREF(values);
+            throw;
+        }
+        Py_DECREF(values);
+    }
+};
+
+// Implementation for converting or collecting the fields of records
+PyObject* records_impl(
+    PyObject* input, PyObject* fields, const bool collect, const bool recurse
+) noexcept(false)
+{
+    if (PyType_Ready(&FastnumbersConverterType) < 0) {
+        throw exception_is_set();
+    }
+    RecordWalker walker(fields, collect, recurse);
+    walker.walk(input);
+    if (collect) {
+        return walker.columns();
+    }
+    Py_RETURN_NONE;
+}
+
+/**
+ * \brief Find the memory of a writable one-dimensional numpy object array
+ *
+ * Object arrays cannot be exported with the buffer protocol, so this reads
+ * the array interface (__array_interface__), which describes the memory
+ * without needing the numpy headers.
+ *
+ * \param output The array object
+ * \param data Where to store the address of the first element
+ * \param length Where to store the number of elements
+ * \param stride Where to store the distance between elements, in bytes
+ * \throw exception_is_set If the object is not such an array
+ */
+static void object_array_memory(
+    PyObject* output, char*& data, Py_ssize_t& length, Py_ssize_t& stride
+) noexcept(false)
+{
+    PyObject* interface = PyObject_GetAttrString(output, "__array_interface__");
+    if (interface == nullptr) {
+        throw exception_is_set();
+    }
+
+    // Borrowed references to the parts of the interface that are needed
+    PyObject* typestr = PyDict_Check(interface)
+        ? PyDict_GetItemString(interface, "typestr")
+        : nullptr;
+    PyObject* shape = typestr == nullptr ? nullptr
+                                         : PyDict_GetItemString(interface, "shape");
+    PyObject* address = typestr == nullptr ? nullptr
+                                           : PyDict_GetItemString(interface, "data");
+    PyObject* strides = typestr == nullptr
+        ? nullptr
+        : PyDict_GetItemString(interface, "strides");
+
+    const bool valid = typestr != nullptr && PyUnicode_Check(typestr)
+        && PyUnicode_CompareWithASCIIString(typestr, "|O") == 0
+        && shape != nullptr && PyTuple_Check(shape) && PyTuple_GET_SIZE(shape) == 1
+        && address != nullptr && PyTuple_Check(address)
+        && PyTuple_GET_SIZE(address) == 2;
+    if (!valid) {
+        Py_DECREF(interface);
+        PyErr_SetString(
+            PyExc_TypeError, "output must be a one-dimensional array of dtype object"
+        );
+        throw exception_is_set();
+    }
+    if (PyObject_IsTrue(PyTuple_GET_ITEM(address, 1))) {
+        Py_DECREF(interface);
+        PyErr_SetString(PyExc_ValueError, "output array is read-only");
+        throw exception_is_set();
+    }
+
+    data = static_cast<char*>(PyLong_AsVoidPtr(PyTuple_GET_ITEM(address, 0)));
+    length = PyLong_AsSsize_t(PyTuple_GET_ITEM(shape, 0));
+    stride = strides == nullptr || strides == Py_None
+        ? static_cast<Py_ssize_t>(sizeof(PyObject*))
+        : PyLong_AsSsize_t(PyTuple_GetItem(strides, 0));
+    Py_DECREF(interface);
+    if (PyErr_Occurred()) {
+        throw exception_is_set();
+    }
+}
+
+// Implementation for iterating over a collection to populate an object array
+void object_array_impl(
+    PyObject* input, PyObject* output, PyObject* converter, const bool consume
+) noexcept(false)
+{
+    if (PyType_Ready(&FastnumbersConverterType) < 0) {
+        throw exception_is_set();
+    }
+    if (!PyObject_TypeCheck(converter, &FastnumbersConverterType)) {
+        PyErr_SetString(PyExc_TypeError, "converter must be a converter");
+        throw exception_is_set();
+    }
+    if (consume && !PyList_Check(input)) {
+        PyErr_Format(
+            PyExc_TypeError,
+            "consume=True requires the input to be a list, not '%.200s'",
+            Py_TYPE(input)->tp_name
+        );
+        throw exception_is_set();
+    }
+
+    char* data = nullptr;
+    Py_ssize_t length = 0;
+    Py_ssize_t stride = 0;
+    object_array_memory(output, data, length, stride);
+
+    const Implementation* impl
+        = reinterpret_cast<FastnumbersConverter*>(converter)->cv_impl;
+    IterableManager<PyObject*> iter_man(input, [impl](PyObject* x) -> PyObject* {
+        return impl->convert(x);
+    });
+    const Py_ssize_t size = iter_man.get_size();
+    if (size != length) {
+        PyErr_SetString(PyExc_ValueError, "input/output must be of equal size");
+        throw exception_is_set();
+    }
+    FN_TRACE2(array__start, size, "O");
+
+    // Each result is stored directly, releasing what the slot held before.
+    // Storing past the end is impossible even if the input changes size,
+    // since the iteration stops at the size measured above.
+    Py_ssize_t index = 0;
+    for (PyObject* value : iter_man) {
+        if (value == nullptr) {
+            throw exception_is_set();
+        }
+        if (index == size) {
+            Py_DECREF(value);
+            break;
+        }
+        PyObject** slot = reinterpret_cast<PyObject**>(data + index * stride);
+        PyObject* previous = *slot;
+        *slot = value;
+        Py_XDECREF(previous);
+        if (consume && index < PyList_GET_SIZE(input)) {
+            PyObject* item = PyList_GET_ITEM(input, index);
+            Py_INCREF(Py_None);
+            PyList_SET_ITEM(input, index, Py_None);
+            Py_DECREF(item);
+        }
+        index += 1;
+    }
+    if (consume && PyList_SetSlice(input, 0, PyList_GET_SIZE(input), nullptr) != 0) {
+        throw exception_is_set();
+    }
+    FN_TRACE2(array__end, size, "O");
+}
+
+/**
+ * \struct ArrayImpl
+ * \brief Executor of array population, manages Python memory buffer
+ */
+struct ArrayImpl {
+    /// The input object as given by Python
+    PyObject* m_input;
+
+    /// The output object, represented as a memory view buffer
+    Py_buffer& m_output;
+
+    /// The action to take if INF is found
+    PyObject* m_inf;
+
+    /// The action to take if NaN is found
+    PyObject* m_nan;
+
+    /// The action to take if input is invalid
+    PyObject* m_on_fail;
+
+    /// The action to take if input overflows
+    PyObject* m_on_overflow;
+
+    /// The action to take if input is of incorrect type
+    PyObject* m_on_type_error;
+
+    /// Whether or not to allow underscores in strings
+    bool m_allow_underscores;
+
+    /// Whether or not to allow hexadecimal floats in strings
+    bool m_allow_hex_float;
+
+    /// Whether or not to allow rational numbers like "3/4" in strings
+    bool m_allow_fraction;
+
+    /// Whether or not strings are trusted to be valid numbers
+    bool m_assume_valid;
+
+    /// Whether or not to release the elements of the input list as they are used
+    bool m_consume;
+
+    /// The base to use when parsing integers
+    int m_base;
+
+    /// The locale-style format in which strings are written
+    const NumberFormat& m_number_format;
+
+    /// The number of elements after which factorize() checks if values repeat
+    static constexpr Py_ssize_t FACTORIZE_SAMPLE_SIZE = 1 << 14;
+
+    /// Release the Python memoryview buffer
+    ~ArrayImpl() noexcept { PyBuffer_Release(&m_output); }
+
+    /// Perform the actual array population logic
+    template <typename T>
+    void execute() noexcept(false)
+    {
+        // Define how a Python object can be converted into a C number type
+        const UserOptions options = user_options();
+        CTypeExtractor<T> extractor(options);
+        set_replacements(extractor);
+
+        // Define how we convert each element of the iterable - each is
+        // stored in "value" (or "error") and the iteration gives the status
+        T value {};
+        ErrorType error = ErrorType::BAD_VALUE;
+        bool defer = true;
+        IterableManager<bool> iter_man(m_input, [&](PyObject* x) -> bool {
+            if (!defer) {
+                value = convert_now(extractor, x);
+                return true;
+            }
+            return extractor.extract_c_number(x, value, error);
+        });
+
+        // Create a handler for inserting data into the output memory buffer
+        const Py_ssize_t size = iter_man.get_size();
+        ArrayPopulator pop(m_output, size);
+        FN_TRACE2(array__start, size, m_output.format);
+
+        // Iterate over the input data, convert it, and place it in the output.
+        // Elements that failed are only noted here and replaced afterwards,
+        // so that this loop is just parsing and storing. This is only done
+        // if every replacement is a constant, since callables must be called
+        // (and may raise) in the order of the elements, and if the input can
+        // be looked up again by position, which for other sequences (e.g. a
+        // pandas Series, which is indexed by label) it cannot. Otherwise,
+        // each replacement is made as soon as its element is seen.
+        // When consuming, each element of the input is released once its
+        // value is placed, unless it may still be given to a replacement.
+        defer = iter_man.is_fast_sequence() && !extractor.has_callable_replacement();
+        std::vector<std::pair<Py_ssize_t, ErrorType>> failures;
+        for (const bool success : iter_man) {
+            if (success) {
+                if (m_consume && !extractor.may_be_replaced(value)) {
+                    release_input(pop.index());
+                }
+                pop.place_next(value);
+            } else {
+                failures.emplace_back(pop.index(), error);
+                pop.place_next(T());
+            }
+        }
+
+        // Replace NaN and INF in bulk, then the elements that failed
+        auto get_item = [&iter_man](const Py_ssize_t index) -> PyObject* {
+            return iter_man.get_item(index);
+        };
+        if (defer) {
+            extractor.replace_nan_and_inf(pop.data<T>(), size, pop.stride(), get_item);
+        }
+        for (const auto& [index, err] : failures) {
+            PyObject* item = get_item(index);
+            try {
+                pop.at<T>(index) = extractor.replace_error(err, item);
+            } catch (...) {
+                Py_DECREF(item);
+                throw;
+            }
+            Py_DECREF(item);
+        }
+        if (m_consume && PyList_SetSlice(m_input, 0, size, nullptr) != 0) {
+            throw exception_is_set();
+        }
+        FN_TRACE2(array__end, size, m_output.format);
+    }
+
+    /**
+     * \brief Convert each element, and place the code of its value in the output
+     *
+     * Values are numbered in order of first appearance. Unlike execute(),
+     * each replacement is made as soon as its element is seen, because the
+     * code of the value must be known right away.
+     *
+     * A hash table only pays off if values repeat, and sorting is faster
+     * if nearly all are distinct. So if most of the first elements are
+     * distinct, numbering stops and all values are placed in a bytearray
+     * instead, for the caller to sort. It is only allocated at that point.
+     *
+     * \return A tuple of a bytearray of the distinct values as C numbers in
+     *         code order and True, or of a bytearray of all values and False
+     */
+    template <typename T, typename Code>
+    PyObject* factorize() noexcept(false)
+    {
+        const UserOptions options = user_options();
+        CTypeExtractor<T> extractor(options);
+        set_replacements(extractor);
+
+        Factorizer<T> factorizer;
+        bool numbering = true;
+        T value {};
+        IterableManager<Code> iter_man(m_input, [&](PyObject* x) -> Code {
+            value = convert_now(extractor, x);
+            return numbering ? static_cast<Code>(factorizer.code(value)) : Code();
+        });
+
+        const Py_ssize_t size = iter_man.get_size();
+        ArrayPopulator pop(m_output, size);
+        std::unique_ptr<PyObject, decltype(&Py_DecRef)> all_values(nullptr, &Py_DecRef);
+        T* all_data = nullptr;
+        Py_ssize_t nvalues = 0;
+        FN_TRACE2(array__start, size, m_output.format);
+        for (const Code code : iter_man) {
+            if (!numbering) {
+                all_data[nvalues++] = value;
+                continue;
+            }
+            pop.place_next(code);
+            const std::vector<T>& uniques = factorizer.uniques();
+            const auto distinct = static_cast<Py_ssize_t>(uniques.size());
+            if (pop.index() == FACTORIZE_SAMPLE_SIZE
+                && 2 * distinct > FACTORIZE_SAMPLE_SIZE) {
+                numbering = false;
+                all_values.reset(PyByteArray_FromStringAndSize(
+                    nullptr, size * static_cast<Py_ssize_t>(sizeof(T))
+                ));
+                if (all_values == nullptr) {
+                    throw exception_is_set();
+                }
+                char* data = PyByteArray_AS_STRING(all_values.get());
+                all_data = reinterpret_cast<T*>(data);
+                for (Py_ssize_t i = 0; i < pop.index(); ++i) {
+                    all_data[nvalues++] = uniques[pop.at<Code>(i)];
+                }
+            }
+        }
+        FN_TRACE2(array__end, size, m_output.format);
+
+        if (!numbering) {
+            return Py_BuildValue("(NO)", all_values.release(), Py_False);
+        }
+        const std::vector<T>& uniques = factorizer.uniques();
+        PyObject* distinct = PyByteArray_FromStringAndSize(
+            reinterpret_cast<const char*>(uniques.data()),
+            static_cast<Py_ssize_t>(uniques.size() * sizeof(T))
+        );
+        return distinct == nullptr ? nullptr
+                                   : Py_BuildValue("(NO)", distinct, Py_True);
+    }
+
+    /**
+     * \brief Convert each element, and place the number of its bin in the output
+     *
+     * As in factorize(), each replacement is made as soon as its element
+     * is seen, because the bin of the value must be known right away.
+     *
+     * \param edges The bin edges
+     * \param counts If true, the output instead has one element per bin,
+     *               and the number of elements in each bin is placed there
+     */
+    template <typename Index>
+    void digitize(const BinEdges& edges, const bool counts) noexcept(false)
+    {
+        const UserOptions options = user_options();
+        CTypeExtractor<double> extractor(options);
+        set_replacements(extractor);
+
+        auto locate = [&](PyObject* x) -> std::size_t {
+            return edges.locate(convert_now(extractor, x));
+        };
+        IterableManager<std::size_t> iter_man(m_input, locate);
+
+        // Counting needs no size, so an iterator is not collected into a list
+        if (counts) {
+            std::vector<Index> totals(edges.bins(), 0);
+            for (const std::size_t bin : iter_man) {
+                totals[bin] += 1;
+            }
+            ArrayPopulator pop(m_output, static_cast<Py_ssize_t>(totals.size()));
+            for (const Index total : totals) {
+                pop.place_next(total);
+            }
+            return;
+        }
+
+        const Py_ssize_t size = iter_man.get_size();
+        ArrayPopulator pop(m_output, size);
+        FN_TRACE2(array__start, size, m_output.format);
+        for (const std::size_t bin : iter_man) {
+            pop.place_next(static_cast<Index>(bin));
+        }
+        FN_TRACE2(array__end, size, m_output.format);
+    }
+
+    /**
+     * \brief Convert each element to a double, and add it to a sketch
+     *
+     * As in factorize(), each replacement is made as soon as its element
+     * is seen. There is no output buffer, and the input may be an iterator.
+     *
+     * \param sketch The sketch to which to add the values
+     */
+    void sketch(NumericSketch& sketch) noexcept(false)
+    {
+        const UserOptions options = user_options();
+        CTypeExtractor<double> extractor(options);
+        set_replacements(extractor);
+
+        IterableManager<double> iter_man(m_input, [&](PyObject* x) -> double {
+            return convert_now(extractor, x);
+        });
+        for (const double value : iter_man) {
+            sketch.add(value);
+        }
+    }
+
+private:
+    /// Convert an element, making any replacement right away
+    template <typename T>
+    static T convert_now(CTypeExtractor<T>& extractor, PyObject* x) noexcept(false)
+    {
+        T value {};
+        ErrorType error = ErrorType::BAD_VALUE;
+        if (!extractor.extract_c_number(x, value, error)) {
+            return extractor.replace_error(error, x);
+        } else if (extractor.may_be_replaced(value)) {
+            auto get_item = [x](const Py_ssize_t) -> PyObject* {
+                Py_INCREF(x);
+                return x;
+            };
+            extractor.replace_nan_and_inf(&value, 1, 1, get_item);
+        }
+        return value;
+    }
+
+    /// The options for parsing strings
+    UserOptions user_options() const noexcept
+    {
+        UserOptions options;
+        options.set_base(m_base);
+        options.set_underscores_allowed(m_allow_underscores);
+        options.set_hex_float_allowed(m_allow_hex_float);
+        options.set_fraction_allowed(m_allow_fraction);
+        options.set_assume_valid(m_assume_valid);
+        options.set_number_format(m_number_format);
+        return options;
+    }
+
+    /// Tell the extractor what to do with values that cannot be stored as is
+    template <typename T>
+    void set_replacements(CTypeExtractor<T>& extractor) const noexcept(false)
+    {
+        extractor.set_inf_replacement(m_inf);
+        extractor.set_nan_replacement(m_nan);
+        extractor.set_fail_replacement(m_on_fail);
+        extractor.set_overflow_replacement(m_on_overflow);
+        extractor.set_type_error_replacement(m_on_type_error);
+    }
+
+    /// Replace an element of the input list with None, releasing the original
+    void release_input(const Py_ssize_t index) noexcept
+    {
+        PyObject* item = PyList_GET_ITEM(m_input, index);
+        Py_INCREF(Py_None);
+        PyList_SET_ITEM(m_input, index, Py_None);
+        Py_DECREF(item);
+    }
+};
+
+/**
+ * \brief Validate the selector is not a "yes, no, num, str, input" value
+ * \param selector The python object to validate
+ * \throws fastnumbers_exception if one of the four valid values
+ */
+static inline void validate_not_allow_disallow_str_only_num_only_input(
+    const PyObject* selector
+) noexcept(false)
+{
+    const bool bad = selector == Selectors::ALLOWED || selector == Selectors::DISALLOWED
+        || selector == Selectors::NUMBER_ONLY || selector == Selectors::STRING_ONLY
+        || selector == Selectors::INPUT;
+    if (bad) {
+        throw fastnumbers_exception(
+            "values for 'on_fail', 'on_overflow', and 'on_type_error' cannot be "
+            "fastnumbers.ALLOWED, fastnumbers.DISALLOWED, fastnumbers.NUMBER_ONLY, "
+            "fastnumbers.STRING_ONLY, or fastnumbers.INPUT"
+        );
+    }
+}
+
+/**
+ * \brief Validate the selector is not a "no, num, str, input" value
+ * \param selector The python object to validate
+ * \throws fastnumbers_exception if one of the four valid values
+ */
+static inline void
+validate_not_disallow_str_only_num_only_input(const PyObject* selector) noexcept(false)
+{
+    const bool bad = selector == Selectors::DISALLOWED
+        || selector == Selectors::NUMBER_ONLY || selector == Selectors::STRING_ONLY
+        || selector == Selectors::INPUT || selector == Selectors::RAISE;
+    if (bad) {
+        throw fastnumbers_exception(
+            "values for 'inf' and 'nan' cannot be fastnumbers.DISALLOWED, "
+            "fastnumbers.NUMBER_ONLY, fastnumbers.STRING_ONLY, fastnumbers.INPUT "
+            "or fastnumbers.RAISE"
+        );
+    }
+}
+
+/**
+ * \brief Call a function with a value of the C number type of a buffer format
+ *
+ * \param format The buffer format, as in the struct module
+ * \param function A generic function whose argument gives the C number type
+ * \return false if the format is not one that arrays can be populated with
+ */
+template <typename Function>
+static bool visit_format(const std::string_view format, const Function& function)
+{
+    // Attempt to order this if-branch by anticipated frequency of use
+    if (format == "d") {
+        function(double());
+    } else if (format == "l") {
+        function(static_cast<signed long>(0));
+    } else if (format == "q") {
+        function(static_cast<signed long long>(0));
+    } else if (format == "i") {
+        function(static_cast<signed int>(0));
+    } else if (format == "f") {
+        function(float());
+    } else if (format == "L") {
+        function(static_cast<unsigned long>(0));
+    } else if (format == "Q") {
+        function(static_cast<unsigned long long>(0));
+    } else if (format == "I") {
+        function(static_cast<unsigned int>(0));
+    } else if (format == "h") {
+        function(static_cast<signed short>(0));
+    } else if (format == "b") {
+        function(static_cast<signed char>(0));
+    } else if (format == "H") {
+        function(static_cast<unsigned short>(0));
+    } else if (format == "B") {
+        function(static_cast<unsigned char>(0));
+    } else if (format == "Zd") {
+        function(std::complex<double>());
+    } else if (format == "Zf") {
+        function(std::complex<float>());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Implementation for iterating over a collection to populate an array
+void array_impl(
+    PyObject* input,
+    PyObject* output,
+    PyObject* inf,
+    PyObject* nan,
+    PyObject* on_fail,
+    PyObject* on_overflow,
+    PyObject* on_type_error,
+    bool allow_underscores,
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    bool consume,
+    int base,
+    const NumberFormat& number_format
+) noexcept(false)
+{
+    // Ensure the given parameters are valid.
+    validate_not_disallow_str_only_num_only_input(inf);
+    validate_not_disallow_str_only_num_only_input(nan);
+    validate_not_allow_disallow_str_only_num_only_input(on_fail);
+    validate_not_allow_disallow_str_only_num_only_input(on_overflow);
+    validate_not_allow_disallow_str_only_num_only_input(on_type_error);
+    if (consume && !PyList_Check(input)) {
+        PyErr_Format(
+            PyExc_TypeError,
+            "consume=True requires the input to be a list, not '%.200s'",
+            Py_TYPE(input)->tp_name
+        );
+        throw exception_is_set();
+    }
+
+    // Extract the underlying buffer data from the output object
+    Py_buffer buf { nullptr, nullptr };
+    constexpr auto flags = PyBUF_WRITABLE | PyBUF_STRIDES | PyBUF_FORMAT;
+    if (PyObject_GetBuffer(output, &buf, flags) != 0) {
+        // This should be impossible to encounter because of guards in the python code
+        throw exception_is_set();
+    }
+
+    // Pass on all arguments to the actual implementation
+    // NOTE: This will manage the buffer object for us
     ArrayImpl impl {
         input, buf, inf, nan, on_fail, on_overflow, on_type_error, allow_underscores,
-        base,
+        allow_hex_float, allow_fraction, assume_valid, consume, base, number_format,
     };
 
     // Use the format to determine the code path to execute
-    // Attempt to order this if-branch by anticipated frequency of use
     const std::string_view format(buf.format == nullptr ? "<NULL>" : buf.format);
-    if (format == "d") {
-        return impl.execute<double>();
-    } else if (format == "l") {
-        return impl.execute<signed long>();
-    } else if (format == "q") {
-        return impl.execute<signed long long>();
-    } else if (format == "i") {
-        return impl.execute<signed int>();
-    } else if (format == "f") {
-        return impl.execute<float>();
-    } else if (format == "L") {
-        return impl.execute<unsigned long>();
-    } else if (format == "Q") {
-        return impl.execute<unsigned long long>();
-    } else if (format == "I") {
-        return impl.execute<unsigned int>();
-    } else if (format == "h") {
-        return impl.execute<signed short>();
-    } else if (format == "b") {
-        return impl.execute<signed char>();
-    } else if (format == "H") {
-        return impl.execute<unsigned short>();
-    } else if (format == "B") {
-        return impl.execute<unsigned char>();
+    const bool known = visit_format(format, [&impl](auto tag) {
+        impl.execute<decltype(tag)>();
+    });
+    if (known) {
+        return;
+    }
+
+    // This should be impossible to encounter because of guards in the python code
+    PyErr_Format(
+        PyExc_TypeError,
+        "Unknown buffer format '%s' for object '%.200R'",
+        buf.format,
+        output
+    );
+    throw exception_is_set();
+}
+
+// Implementation for numbering the distinct values of a collection
+PyObject* factorize_impl(
+    PyObject* input,
+    PyObject* codes,
+    PyObject* values,
+    PyObject* inf,
+    PyObject* nan,
+    PyObject* on_fail,
+    PyObject* on_overflow,
+    PyObject* on_type_error,
+    bool allow_underscores,
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    int base,
+    const NumberFormat& number_format
+) noexcept(false)
+{
+    // Ensure the given parameters are valid.
+    validate_not_disallow_str_only_num_only_input(inf);
+    validate_not_disallow_str_only_num_only_input(nan);
+    validate_not_allow_disallow_str_only_num_only_input(on_fail);
+    validate_not_allow_disallow_str_only_num_only_input(on_overflow);
+    validate_not_allow_disallow_str_only_num_only_input(on_type_error);
+
+    // The values buffer (only read for its type) is released here, the codes
+    // buffer by the implementation
+    Py_buffer value_buf { nullptr, nullptr };
+    if (PyObject_GetBuffer(values, &value_buf, PyBUF_FORMAT) != 0) {
+        throw exception_is_set();
+    }
+    const std::unique_ptr<Py_buffer, decltype(&PyBuffer_Release)> value_guard(
+        &value_buf, &PyBuffer_Release
+    );
+    Py_buffer buf { nullptr, nullptr };
+    constexpr auto flags = PyBUF_WRITABLE | PyBUF_STRIDES | PyBUF_FORMAT;
+    if (PyObject_GetBuffer(codes, &buf, flags) != 0) {
+        throw exception_is_set();
+    }
+    ArrayImpl impl {
+        input, buf, inf, nan, on_fail, on_overflow, on_type_error, allow_underscores,
+        allow_hex_float, allow_fraction, assume_valid, false, base, number_format,
+    };
+
+    // Choose the code path by the type of the values and of the codes
+    const char* value_format = value_buf.format;
+    const std::string_view format(value_format == nullptr ? "<NULL>" : value_format);
+    const std::string_view codes_format(buf.format == nullptr ? "<NULL>" : buf.format);
+    PyObject* result = nullptr;
+    const bool known = visit_format(format, [&](auto tag) {
+        using T = decltype(tag);
+        if (codes_format == "i") {
+            result = impl.factorize<T, signed int>();
+        } else if (codes_format == "l") {
+            result = impl.factorize<T, signed long>();
+        } else if (codes_format == "q") {
+            result = impl.factorize<T, signed long long>();
+        } else {
+            PyErr_Format(
+                PyExc_TypeError, "Unknown buffer format '%s' for codes", buf.format
+            );
+            throw exception_is_set();
+        }
+    });
+    if (known) {
+        return result;
+    }
+
+    // This should be impossible to encounter because of guards in the python code
+    PyErr_Format(
+        PyExc_TypeError,
+        "Unknown buffer format '%s' for object '%.200R'",
+        value_buf.format,
+        values
+    );
+    throw exception_is_set();
+}
+
+// Implementation for locating the values of a collection among bin edges
+void digitize_impl(
+    PyObject* input,
+    PyObject* output,
+    PyObject* edges,
+    bool right,
+    bool counts,
+    PyObject* inf,
+    PyObject* nan,
+    PyObject* on_fail,
+    PyObject* on_type_error,
+    bool allow_underscores,
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    const NumberFormat& number_format
+) noexcept(false)
+{
+    // Ensure the given parameters are valid.
+    validate_not_disallow_str_only_num_only_input(inf);
+    validate_not_disallow_str_only_num_only_input(nan);
+    validate_not_allow_disallow_str_only_num_only_input(on_fail);
+    validate_not_allow_disallow_str_only_num_only_input(on_type_error);
+
+    // Copy the edges, which must be a contiguous array of double
+    Py_buffer edge_buf { nullptr, nullptr };
+    constexpr auto edge_flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+    if (PyObject_GetBuffer(edges, &edge_buf, edge_flags) != 0) {
+        throw exception_is_set();
+    }
+    const bool valid = edge_buf.ndim == 1 && edge_buf.format != nullptr
+        && std::string_view(edge_buf.format) == "d";
+    std::vector<double> edge_values;
+    if (valid) {
+        const auto* edge_data = static_cast<const double*>(edge_buf.buf);
+        edge_values.assign(edge_data, edge_data + edge_buf.shape[0]);
+    }
+    PyBuffer_Release(&edge_buf);
+    if (!valid) {
+        // This should be impossible to encounter because of guards in the python code
+        PyErr_SetString(PyExc_TypeError, "edges must be a 1D array of float64");
+        throw exception_is_set();
+    }
+    const BinEdges bin_edges(std::move(edge_values), right);
+
+    Py_buffer buf { nullptr, nullptr };
+    constexpr auto flags = PyBUF_WRITABLE | PyBUF_STRIDES | PyBUF_FORMAT;
+    if (PyObject_GetBuffer(output, &buf, flags) != 0) {
+        throw exception_is_set();
+    }
+    ArrayImpl impl {
+        input,
+        buf,
+        inf,
+        nan,
+        on_fail,
+        Selectors::RAISE,
+        on_type_error,
+        allow_underscores,
+        allow_hex_float,
+        allow_fraction,
+        assume_valid,
+        false,
+        std::numeric_limits<int>::min(),
+        number_format,
+    };
+
+    // Only integer outputs can hold bins or counts
+    const std::string_view format(buf.format == nullptr ? "<NULL>" : buf.format);
+    bool integral = false;
+    visit_format(format, [&](auto tag) {
+        using T = decltype(tag);
+        if constexpr (std::is_integral_v<T>) {
+            integral = true;
+            impl.digitize<T>(bin_edges, counts);
+        }
+    });
+    if (integral) {
+        return;
     }
 
     // This should be impossible to encounter because of guards in the python code
@@ -545,4 +2220,304 @@ void array_impl(
         output
     );
     throw exception_is_set();
+}
+
+/**
+ * \struct FastnumbersSketch
+ * \brief Object holding a NumericSketch, which Python passes back to the sketch_*
+ *        functions
+ *
+ * It is written in a very C-like way because it has to interface with C-code.
+ */
+struct FastnumbersSketch {
+    // clang-format off
+    PyObject_HEAD
+
+    /// The sketch
+    NumericSketch* sk_sketch;
+    // clang-format on
+
+    /// Deallocate the sketch object
+    static void dealloc(FastnumbersSketch* sk) noexcept
+    {
+        delete sk->sk_sketch;
+        PyObject_Free(sk);
+    }
+};
+
+/// The fastnumbers sketch type object definition
+PyTypeObject FastnumbersSketchType = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0) "fastnumbers_sketch", /* tp_name */
+    sizeof(FastnumbersSketch), /* tp_basicsize */
+    0, /* tp_itemsize */
+    /* methods */
+    (destructor)FastnumbersSketch::dealloc, /* tp_dealloc */
+    0, /* tp_vectorcall_offset */
+    0, /* tp_getattr */
+    0, /* tp_setattr */
+    0, /* tp_as_async */
+    0, /* tp_repr */
+    0, /* tp_as_number */
+    0, /* tp_as_sequence */
+    0, /* tp_as_mapping */
+    0, /* tp_hash */
+    0, /* tp_call */
+    0, /* tp_str */
+    PyObject_GenericGetAttr, /* tp_getattro */
+    0, /* tp_setattro */
+    0, /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT, /* tp_flags */
+    0, /* tp_doc */
+    0,
+};
+
+/// Give a sketch to a new Python sketch object
+static PyObject* wrap_sketch(std::unique_ptr<NumericSketch> sketch) noexcept(false)
+{
+    if (PyType_Ready(&FastnumbersSketchType) < 0) {
+        throw exception_is_set();
+    }
+    FastnumbersSketch* sk = PyObject_New(FastnumbersSketch, &FastnumbersSketchType);
+    if (sk == nullptr) {
+        throw exception_is_set();
+    }
+    sk->sk_sketch = sketch.release();
+    return (PyObject*)sk;
+}
+
+/// Get the sketch of a Python sketch object
+static NumericSketch& unwrap_sketch(PyObject* obj) noexcept(false)
+{
+    if (PyType_Ready(&FastnumbersSketchType) < 0) {
+        throw exception_is_set();
+    }
+    if (!PyObject_TypeCheck(obj, &FastnumbersSketchType)) {
+        PyErr_SetString(PyExc_TypeError, "sketch must be a sketch");
+        throw exception_is_set();
+    }
+    return *reinterpret_cast<FastnumbersSketch*>(obj)->sk_sketch;
+}
+
+/// Read an integer argument that must be within a range
+static Py_ssize_t read_bounded_int(
+    PyObject* obj, const char* name, const Py_ssize_t low, const Py_ssize_t high
+) noexcept(false)
+{
+    const Py_ssize_t value = PyNumber_AsSsize_t(obj, PyExc_OverflowError);
+    if (value == -1 && PyErr_Occurred()) {
+        throw exception_is_set();
+    }
+    if (value < low || value > high) {
+        PyErr_Format(
+            PyExc_ValueError, "%s must be between %zd and %zd", name, low, high
+        );
+        throw exception_is_set();
+    }
+    return value;
+}
+
+// Implementation for creating an empty sketch
+PyObject* sketch_impl(PyObject* k, PyObject* precision) noexcept(false)
+{
+    constexpr auto min_k = static_cast<Py_ssize_t>(KllSketch::MIN_K);
+    constexpr auto max_k = static_cast<Py_ssize_t>(KllSketch::MAX_K);
+    const Py_ssize_t size = read_bounded_int(k, "k", min_k, max_k);
+    const Py_ssize_t bits = read_bounded_int(
+        precision, "precision", HyperLogLog::MIN_PRECISION, HyperLogLog::MAX_PRECISION
+    );
+    return wrap_sketch(std::make_unique<NumericSketch>(
+        static_cast<std::size_t>(size), static_cast<int>(bits)
+    ));
+}
+
+// Implementation for adding the values of a collection to a sketch
+void sketch_update_impl(
+    PyObject* sketch,
+    PyObject* input,
+    PyObject* inf,
+    PyObject* nan,
+    PyObject* on_fail,
+    PyObject* on_type_error,
+    bool allow_underscores,
+    bool allow_hex_float,
+    bool allow_fraction,
+    bool assume_valid,
+    const NumberFormat& number_format
+) noexcept(false)
+{
+    // Ensure the given parameters are valid.
+    validate_not_disallow_str_only_num_only_input(inf);
+    validate_not_disallow_str_only_num_only_input(nan);
+    validate_not_allow_disallow_str_only_num_only_input(on_fail);
+    validate_not_allow_disallow_str_only_num_only_input(on_type_error);
+    NumericSketch& target = unwrap_sketch(sketch);
+
+    // No output buffer is needed, and releasing an empty one does nothing
+    Py_buffer unused { nullptr, nullptr };
+    ArrayImpl impl {
+        input,
+        unused,
+        inf,
+        nan,
+        on_fail,
+        Selectors::RAISE,
+        on_type_error,
+        allow_underscores,
+        allow_hex_float,
+        allow_fraction,
+        assume_valid,
+        false,
+        std::numeric_limits<int>::min(),
+        number_format,
+    };
+    impl.sketch(target);
+}
+
+// Implementation for adding the values of an already converted array to a sketch
+void sketch_add_impl(PyObject* sketch, PyObject* values) noexcept(false)
+{
+    NumericSketch& target = unwrap_sketch(sketch);
+    Py_buffer buf { nullptr, nullptr };
+    if (PyObject_GetBuffer(values, &buf, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+        throw exception_is_set();
+    }
+    const std::unique_ptr<Py_buffer, decltype(&PyBuffer_Release)> guard(
+        &buf, &PyBuffer_Release
+    );
+    if (buf.ndim != 1) {
+        PyErr_SetString(PyExc_ValueError, "values must be one-dimensional");
+        throw exception_is_set();
+    }
+
+    const std::string_view format(buf.format == nullptr ? "<NULL>" : buf.format);
+    const auto* data = static_cast<const char*>(buf.buf);
+    const bool known = visit_format(format, [&](auto tag) {
+        using T = decltype(tag);
+        if constexpr (is_complex_v<T>) {
+            PyErr_SetString(PyExc_TypeError, "complex values cannot be sketched");
+            throw exception_is_set();
+        } else {
+            for (Py_ssize_t i = 0; i < buf.shape[0]; ++i) {
+                T value;
+                std::memcpy(&value, data + i * buf.strides[0], sizeof(T));
+                target.add(static_cast<double>(value));
+            }
+        }
+    });
+    if (!known) {
+        PyErr_Format(
+            PyExc_TypeError, "Unknown buffer format '%s' for values", buf.format
+        );
+        throw exception_is_set();
+    }
+}
+
+// Implementation for adding the values of one sketch to another
+void sketch_merge_impl(PyObject* sketch, PyObject* other) noexcept(false)
+{
+    NumericSketch& target = unwrap_sketch(sketch);
+    const NumericSketch& source = unwrap_sketch(other);
+
+    // Merging a sketch into itself would read the values it is adding to
+    if (&target == &source) {
+        const NumericSketch copy(source);
+        target.merge(copy);
+    } else if (!target.merge(source)) {
+        PyErr_SetString(
+            PyExc_ValueError, "cannot merge sketches of different precision"
+        );
+        throw exception_is_set();
+    }
+}
+
+// Implementation for estimating quantiles of the values in a sketch
+PyObject*
+sketch_quantiles_impl(PyObject* sketch, PyObject* quantiles) noexcept(false)
+{
+    const NumericSketch& source = unwrap_sketch(sketch);
+    PyObject* sequence = PySequence_Fast(quantiles, "quantiles must be a sequence");
+    if (sequence == nullptr) {
+        throw exception_is_set();
+    }
+    const Py_ssize_t length = PySequence_Fast_GET_SIZE(sequence);
+    std::vector<double> fractions(static_cast<std::size_t>(length));
+    for (Py_ssize_t i = 0; i < length; ++i) {
+        const double fraction
+            = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, i));
+        if (fraction == -1.0 && PyErr_Occurred()) {
+            Py_DECREF(sequence);
+            throw exception_is_set();
+        }
+        if (!(fraction >= 0.0 && fraction <= 1.0)) {
+            Py_DECREF(sequence);
+            PyErr_SetString(PyExc_ValueError, "quantiles must be between 0 and 1");
+            throw exception_is_set();
+        }
+        fractions[static_cast<std::size_t>(i)] = fraction;
+    }
+    Py_DECREF(sequence);
+
+    const std::vector<double> values = source.quantiles(fractions);
+    PyObject* result = PyList_New(length);
+    if (result == nullptr) {
+        throw exception_is_set();
+    }
+    for (Py_ssize_t i = 0; i < length; ++i) {
+        PyObject* value = PyFloat_FromDouble(values[static_cast<std::size_t>(i)]);
+        if (value == nullptr) {
+            Py_DECREF(result);
+            throw exception_is_set();
+        }
+        PyList_SET_ITEM(result, i, value);
+    }
+    return result;
+}
+
+// Implementation for summarizing the values in a sketch
+PyObject* sketch_summary_impl(PyObject* sketch) noexcept(false)
+{
+    const NumericSketch& source = unwrap_sketch(sketch);
+    PyObject* result = Py_BuildValue(
+        "(KKddd)",
+        static_cast<unsigned long long>(source.count()),
+        static_cast<unsigned long long>(source.nan_count()),
+        source.min(),
+        source.max(),
+        source.distinct()
+    );
+    if (result == nullptr) {
+        throw exception_is_set();
+    }
+    return result;
+}
+
+// Implementation for serializing a sketch
+PyObject* sketch_dumps_impl(PyObject* sketch) noexcept(false)
+{
+    const std::string data = unwrap_sketch(sketch).serialize();
+    PyObject* result
+        = PyBytes_FromStringAndSize(data.data(), static_cast<Py_ssize_t>(data.size()));
+    if (result == nullptr) {
+        throw exception_is_set();
+    }
+    return result;
+}
+
+// Implementation for deserializing a sketch
+PyObject* sketch_loads_impl(PyObject* data) noexcept(false)
+{
+    Py_buffer buf { nullptr, nullptr };
+    if (PyObject_GetBuffer(data, &buf, PyBUF_C_CONTIGUOUS) != 0) {
+        throw exception_is_set();
+    }
+    const std::string_view bytes(
+        static_cast<const char*>(buf.buf), static_cast<std::size_t>(buf.len)
+    );
+    std::unique_ptr<NumericSketch> sketch = NumericSketch::deserialize(bytes);
+    PyBuffer_Release(&buf);
+    if (sketch == nullptr) {
+        PyErr_SetString(PyExc_ValueError, "data is not a serialized sketch");
+        throw exception_is_set();
+    }
+    return wrap_sketch(std::move(sketch));
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <type_traits>
 
@@ -7,6 +10,8 @@
 
 #include "fastnumbers/buffer.hpp"
 #include "fastnumbers/c_str_parsing.hpp"
+#include "fastnumbers/conversion_limits.hpp"
+#include "fastnumbers/exception.hpp"
 #include "fastnumbers/helpers.hpp"
 #include "fastnumbers/parser/base.hpp"
 #include "fastnumbers/parser/character.hpp"
@@ -14,6 +19,7 @@
 #include "fastnumbers/parser/unicode.hpp"
 #include "fastnumbers/payload.hpp"
 #include "fastnumbers/third_party/ipow.hpp"
+#include "fastnumbers/tracing.hpp"
 #include "fastnumbers/user_options.hpp"
 
 // C++ version of https://docs.python.org/3/library/math.html#math.ulp
@@ -45,6 +51,27 @@ static PyObject* parse_long_helper(
         // and set the exponent character to '\0' so that Python can parse it.
         Buffer buffer(start, length_to_end);
         buffer.mark_integer_end();
+        FN_TRACE1(bigint__fallback, buffer.length());
+        return PyLong_FromString(buffer.start(), nullptr, 10);
+    }
+}
+
+// Parse a sequence of decimal digits as a Python long
+static PyObject* digits_as_pylong(const char* start, const char* end)
+{
+    const std::size_t length = static_cast<std::size_t>(end - start);
+    if (length < overflow_cutoff<uint64_t>()) {
+        bool error = false;
+        bool overflow = false;
+        return pyobject_from_int(
+            length ? parse_int<uint64_t>(start, end, 10, error, overflow) : 0ULL
+        );
+    } else {
+        // Python needs a nul-terminated string
+        Buffer buffer(length + 1);
+        std::memcpy(buffer.start(), start, length);
+        buffer.start()[length] = '\0';
+        FN_TRACE1(bigint__fallback, length);
         return PyLong_FromString(buffer.start(), nullptr, 10);
     }
 }
@@ -56,6 +83,8 @@ static PyObject* exponent_creation_helper(const uint32_t exp_val)
     if (exp_val < overflow_cutoff<uint64_t>()) {
         return pyobject_from_int(ipow::ipow(10ULL, exp_val));
     } else {
+        // 10 ** exp_val has one more digit than the exponent
+        FN_TRACE1(bigint__fallback, static_cast<std::size_t>(exp_val) + 1);
         PyObject* py_expon = pyobject_from_int(10);
         PyObject* py_exp_component = pyobject_from_int(exp_val);
         in_place_pow(py_expon, py_exp_component);
@@ -133,6 +162,17 @@ PyObject* Parser::float_as_int_without_noise(
     const StringChecker& checker, const bool is_negative
 ) noexcept
 {
+    // The digits and exponent have already been measured, so refusing numbers
+    // that are too big for the big-integer arithmetic below is O(1).
+    // Numbers small enough for the C++ fast path need not be checked.
+    if (checker.digit_length() >= overflow_cutoff<uint64_t>()
+        || checker.exponent_value() >= overflow_cutoff<uint64_t>()) {
+        if (!ConversionLimits::digits_allowed(checker.digit_length())
+            || !ConversionLimits::exponent_allowed(checker.exponent_value())) {
+            return nullptr;
+        }
+    }
+
     PyObject* py_integer = nullptr;
 
     // As a special case, if the number of digits in the integer and decimal
@@ -270,6 +310,34 @@ PyObject* Parser::float_as_int_without_noise(
     return do_negative(py_integer, is_negative);
 }
 
+PyObject* Parser::fraction_type() noexcept
+{
+    static PyObject* fraction = nullptr;
+    if (fraction == nullptr) {
+        PyObject* module = PyImport_ImportModule("fractions");
+        if (module == nullptr) {
+            return nullptr;
+        }
+        fraction = PyObject_GetAttrString(module, "Fraction");
+        Py_DECREF(module);
+    }
+    return fraction;
+}
+
+PyObject* Parser::decimal_type() noexcept
+{
+    static PyObject* decimal = nullptr;
+    if (decimal == nullptr) {
+        PyObject* module = PyImport_ImportModule("decimal");
+        if (module == nullptr) {
+            return nullptr;
+        }
+        decimal = PyObject_GetAttrString(module, "Decimal");
+        Py_DECREF(module);
+    }
+    return decimal;
+}
+
 /**
  * \brief Remove whitespace at the end of a string
  *
@@ -300,6 +368,16 @@ CharacterParser::CharacterParser(
     , m_end_orig(str + len)
     , m_str_len(0)
 {
+    // Trusted strings have no whitespace and at most one sign
+    if (options.assume_valid()) {
+        if (len > 0 && is_sign(*m_start)) {
+            set_negative(*m_start == '-');
+            m_start += 1;
+        }
+        m_str_len = static_cast<std::size_t>(m_end_orig - m_start);
+        return;
+    }
+
     // Store the end point of the character array
     const char* end = m_end_orig;
 
@@ -341,6 +419,9 @@ RawPayload<PyObject*> CharacterParser::as_pyint() const noexcept(false)
     // return an error.
     // The only thing special handling we need is underscores or base prefixes
     // with negative signs that caused overflow.
+    if (trusted_base10_int(overflow_cutoff<int64_t>())) {
+        return pyobject_from_int(parse_int_unchecked<int64_t>(signed_start(), end()));
+    }
     bool error;
     bool overflow;
     int64_t result = parse_int<int64_t>(
@@ -348,9 +429,11 @@ RawPayload<PyObject*> CharacterParser::as_pyint() const noexcept(false)
     );
     const bool underscore_error = error && has_valid_underscores();
     const bool prefix_overflow = overflow && has_base_prefix(m_start, m_str_len);
+    std::size_t underscores = 0;
     if (underscore_error || prefix_overflow) {
         Buffer buffer(signed_start(), signed_len());
         buffer.remove_valid_underscores(options().get_base() != 10);
+        underscores = signed_len() - buffer.length();
         int base = options().get_base();
         if (base == 0) {
             base = detect_base(buffer.start(), buffer.end());
@@ -369,6 +452,15 @@ RawPayload<PyObject*> CharacterParser::as_pyint() const noexcept(false)
     // whitespace) No need to do input validation with the second argument because we
     // already know the input is valid from above. Return the value without checking
     // python's error state.
+    // Python only limits the number of digits for bases that are
+    // not a power of two; only base-10 is limited here.
+    // Any underscores were counted when they were removed above.
+    if (options().get_base() == 10) {
+        if (!ConversionLimits::digits_allowed(m_str_len - underscores)) {
+            return nullptr;
+        }
+    }
+    FN_TRACE1(bigint__fallback, m_str_len);
     return PyLong_FromString(m_start_orig, nullptr, options().get_base());
 }
 
@@ -409,8 +501,19 @@ RawPayload<PyObject*> CharacterParser::as_pyfloat(
                 }
             },
 
-            // If the payload contained an error, pass the error along
-            [](const ErrorType err) -> RawPayload<PyObject*> {
+            // If the payload contained an error, pass the error along.
+            // Only a hexadecimal float or a rational number can overflow, and
+            // like float.fromhex() or int division that raises an OverflowError.
+            [this](const ErrorType err) -> RawPayload<PyObject*> {
+                if (err == ErrorType::OVERFLOW_) {
+                    PyErr_SetString(
+                        PyExc_OverflowError,
+                        has_hex_prefix(m_start, m_str_len)
+                            ? "hexadecimal value too large to represent as a float"
+                            : "integer division result too large for a float"
+                    );
+                    return nullptr;
+                }
                 return err;
             },
         },
@@ -418,6 +521,271 @@ RawPayload<PyObject*> CharacterParser::as_pyfloat(
     );
 }
 
+RawPayload<PyObject*> CharacterParser::as_pycomplex() const noexcept(false)
+{
+    return std::visit(
+        overloaded {
+            [](const std::complex<double> result) -> RawPayload<PyObject*> {
+                return PyComplex_FromDoubles(result.real(), result.imag());
+            },
+            [](const ErrorType err) -> RawPayload<PyObject*> {
+                return err;
+            },
+        },
+        as_number<std::complex<double>>()
+    );
+}
+
+RawPayload<PyObject*> CharacterParser::as_pyfraction() const noexcept(false)
+{
+    PyObject* fraction = Parser::fraction_type();
+    if (fraction == nullptr) {
+        return nullptr;
+    }
+
+    // A rational number gives the numerator and denominator directly.
+    // Otherwise, a decimal number is converted exactly, like Fraction(str).
+    PyObject* numerator = nullptr;
+    PyObject* denominator = nullptr;
+    RationalParts parts;
+    Buffer buffer;
+    if (read_rational_parts(parts, buffer)) {
+        if (!rational_as_pylongs(parts, numerator, denominator)) {
+            return nullptr;
+        }
+    } else {
+        StringChecker checker(m_start, end(), 10);
+        if (checker.is_invalid() && has_valid_underscores()) {
+            buffer.copy(m_start, m_str_len);
+            buffer.remove_valid_underscores();
+            checker = StringChecker(buffer.start(), buffer.end(), 10);
+        }
+        if (checker.is_invalid()) {
+            return ErrorType::BAD_VALUE;
+        }
+        if (!decimal_as_pylongs(checker, numerator, denominator)) {
+            return nullptr;
+        }
+    }
+
+    // Calling Fraction with two ints skips its string parsing. Like
+    // Fraction("1/0"), a zero denominator raises ZeroDivisionError.
+    numerator = do_negative(numerator, is_negative());
+    PyObject* result = numerator == nullptr
+        ? nullptr
+        : PyObject_CallFunctionObjArgs(fraction, numerator, denominator, nullptr);
+    Py_XDECREF(numerator);
+    Py_DECREF(denominator);
+    return result;
+}
+
+RawPayload<PyObject*> CharacterParser::as_pydecimal() const noexcept(false)
+{
+    PyObject* decimal = Parser::decimal_type();
+    if (decimal == nullptr) {
+        return nullptr;
+    }
+
+    // Validate here so Decimal only sees well-formed numbers
+    // (NaN and infinity have already been handled). The signaling NaN
+    // only exists for Decimal, so it is passed along as-is.
+    const char* start = signed_start();
+    std::size_t length = signed_len();
+    StringChecker checker(m_start, end(), 10);
+    Buffer buffer;
+    if (checker.is_invalid() && has_valid_underscores()) {
+        buffer.copy(start, length);
+        buffer.remove_valid_underscores();
+        start = buffer.start();
+        length = buffer.length();
+        checker = StringChecker(start + static_cast<int>(is_negative()), buffer.end(), 10);
+    }
+    if (checker.is_invalid() && !quick_detect_signaling_nan(m_start, m_str_len)) {
+        return ErrorType::BAD_VALUE;
+    }
+
+    // Decimal has no C API, so it must parse the text again (it is called
+    // with vectorcall to skip building an argument tuple). Integers that
+    // fit in int64 are given as an int instead, except for a negative zero
+    // whose sign only the text keeps.
+    PyObject* value = nullptr;
+    constexpr uint32_t cutoff = overflow_cutoff<int64_t>();
+    int64_t integer = 0;
+    if (checker.is_integer() && checker.digit_length() < cutoff) {
+        bool error = false;
+        bool overflow = false;
+        integer = parse_int<int64_t>(start, start + length, 10, error, overflow);
+    }
+    if (integer != 0) {
+        value = pyobject_from_int(integer);
+    } else {
+        value = PyUnicode_FromStringAndSize(start, static_cast<Py_ssize_t>(length));
+    }
+    if (value == nullptr) {
+        return nullptr;
+    }
+    PyObject* result = PyObject_Vectorcall(decimal, &value, 1, nullptr);
+    Py_DECREF(value);
+    return result;
+}
+
+bool CharacterParser::rational_as_pylongs(
+    const RationalParts& parts, PyObject*& numerator, PyObject*& denominator
+) noexcept
+{
+    numerator = denominator = nullptr;
+    const std::size_t ndigits = static_cast<std::size_t>(std::max(
+        { parts.whole_end - parts.whole,
+          parts.numerator_end - parts.numerator,
+          parts.denominator_end - parts.denominator }
+    ));
+    if (!ConversionLimits::digits_allowed(ndigits)) {
+        return false;
+    }
+
+    numerator = digits_as_pylong(parts.numerator, parts.numerator_end);
+    denominator = digits_as_pylong(parts.denominator, parts.denominator_end);
+    if (numerator != nullptr && denominator != nullptr && parts.whole != parts.whole_end) {
+        // Fold the whole part into the numerator
+        PyObject* whole = digits_as_pylong(parts.whole, parts.whole_end);
+        if (whole != nullptr) {
+            in_place_multiply(whole, denominator);
+        }
+        if (whole != nullptr) {
+            in_place_add(numerator, whole);
+            Py_DECREF(whole);
+        } else {
+            Py_CLEAR(numerator);
+        }
+    }
+    if (numerator == nullptr || denominator == nullptr) {
+        Py_CLEAR(numerator);
+        Py_CLEAR(denominator);
+        return false;
+    }
+    return true;
+}
+
+RawPayload<double>
+CharacterParser::rational_as_double(const RationalParts& parts, const bool narrow)
+    noexcept(false)
+{
+    FN_TRACE1(bigint__fallback, parts.denominator_end - parts.whole);
+    PyObject* numerator = nullptr;
+    PyObject* denominator = nullptr;
+    PyObject* quotient = nullptr;
+    int direction = 0;
+    if (rational_as_pylongs(parts, numerator, denominator)) {
+        quotient = PyNumber_TrueDivide(numerator, denominator);
+        if (quotient != nullptr && narrow
+            && is_halfway_between_floats(PyFloat_AS_DOUBLE(quotient))) {
+            direction = compare_to_quotient(quotient, numerator, denominator);
+            if (direction == -2) {
+                Py_CLEAR(quotient);
+            }
+        }
+        Py_DECREF(numerator);
+        Py_DECREF(denominator);
+    }
+
+    if (quotient == nullptr) {
+        // Too many digits or a zero denominator is a bad value, not an overflow
+        if (PyErr_ExceptionMatches(PyExc_OverflowError)) {
+            PyErr_Clear();
+            return ErrorType::OVERFLOW_;
+        } else if (PyErr_ExceptionMatches(PyExc_ValueError)
+                   || PyErr_ExceptionMatches(PyExc_ZeroDivisionError)) {
+            PyErr_Clear();
+            return ErrorType::BAD_VALUE;
+        }
+        throw exception_is_set();
+    }
+    const double result = PyFloat_AsDouble(quotient);
+    Py_DECREF(quotient);
+    if (direction != 0) {
+        return std::nextafter(
+            result, direction > 0 ? 0.0 : std::numeric_limits<double>::infinity()
+        );
+    }
+    return result;
+}
+
+int CharacterParser::compare_to_quotient(
+    PyObject* value, PyObject* numerator, PyObject* denominator
+) noexcept
+{
+    // The float is exactly a / b, so compare a * denominator with b * numerator
+    PyObject* ratio = PyObject_CallMethod(value, "as_integer_ratio", nullptr);
+    if (ratio == nullptr) {
+        return -2;
+    }
+    PyObject* scaled_value = PyNumber_Multiply(PyTuple_GET_ITEM(ratio, 0), denominator);
+    PyObject* scaled_exact = PyNumber_Multiply(PyTuple_GET_ITEM(ratio, 1), numerator);
+    Py_DECREF(ratio);
+    int result = -2;
+    if (scaled_value != nullptr && scaled_exact != nullptr) {
+        const int greater = PyObject_RichCompareBool(scaled_value, scaled_exact, Py_GT);
+        const int less = greater == 0
+            ? PyObject_RichCompareBool(scaled_value, scaled_exact, Py_LT)
+            : 0;
+        if (greater >= 0 && less >= 0) {
+            result = greater - less;
+        }
+    }
+    Py_XDECREF(scaled_value);
+    Py_XDECREF(scaled_exact);
+    return result;
+}
+
+bool CharacterParser::decimal_as_pylongs(
+    const StringChecker& checker, PyObject*& numerator, PyObject*& denominator
+) noexcept(false)
+{
+    numerator = denominator = nullptr;
+    if (!ConversionLimits::digits_allowed(checker.digit_length())
+        || !ConversionLimits::exponent_allowed(checker.exponent_value())) {
+        return false;
+    }
+
+    // The numerator is all the digits, ignoring the decimal point
+    Buffer digits(checker.digit_length());
+    std::memcpy(digits.start(), checker.integer_start(), checker.integer_length());
+    std::memcpy(
+        digits.start() + checker.integer_length(),
+        checker.decimal_start(),
+        checker.decimal_length()
+    );
+    numerator = digits_as_pylong(digits.start(), digits.end());
+
+    // The power of ten left after the decimal digits scales
+    // either the numerator or the denominator
+    const int64_t exponent = checker.is_exponent_negative()
+        ? -static_cast<int64_t>(checker.exponent_value())
+        : static_cast<int64_t>(checker.exponent_value());
+    const int64_t scale = exponent - static_cast<int64_t>(checker.decimal_length());
+    PyObject* power = exponent_creation_helper(
+        static_cast<uint32_t>(scale < 0 ? -scale : scale)
+    );
+    if (numerator == nullptr || power == nullptr) {
+        Py_CLEAR(numerator);
+        Py_XDECREF(power);
+        return false;
+    }
+    if (scale < 0) {
+        denominator = power;
+    } else {
+        in_place_multiply(numerator, power);
+        Py_DECREF(power);
+        denominator = pyobject_from_int(1L);
+    }
+    if (numerator == nullptr || denominator == nullptr) {
+        Py_CLEAR(numerator);
+        Py_CLEAR(denominator);
+        return false;
+    }
+    return true;
+}
+
 NumberFlags CharacterParser::get_number_type() const noexcept
 {
     // If this value is cached, use that instead of re-calculating
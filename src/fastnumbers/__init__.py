@@ -2,6 +2,13 @@
 
 from __future__ import annotations
 
+import builtins
+import collections.abc
+import itertools
+import math
+import os
+import struct
+import tempfile
 from typing import TYPE_CHECKING
 
 try:
@@ -21,11 +28,13 @@ from .fastnumbers import (
     check_int,
     check_intlike,
     check_real,
+    cpu_features,
     fast_float,
     fast_forceint,
     fast_int,
     fast_real,
     float,
+    get_conversion_limits,
     int,
     isfloat,
     isint,
@@ -33,14 +42,57 @@ from .fastnumbers import (
     isreal,
     query_type,
     real,
+    set_conversion_limits,
+    try_complex,
+    try_decimal,
     try_float,
     try_forceint,
+    try_fraction,
     try_int,
     try_real,
 )
 from .fastnumbers import (
     array as _array,
 )
+from .fastnumbers import (
+    content_hash as _content_hash,
+)
+from .fastnumbers import (
+    digitize as _digitize,
+)
+from .fastnumbers import (
+    factorize as _factorize,
+)
+from .fastnumbers import (
+    object_array as _object_array,
+)
+from .fastnumbers import (
+    records as _records,
+)
+from .fastnumbers import (
+    sketch as _sketch,
+)
+from .fastnumbers import (
+    sketch_add as _sketch_add,
+)
+from .fastnumbers import (
+    sketch_dumps as _sketch_dumps,
+)
+from .fastnumbers import (
+    sketch_loads as _sketch_loads,
+)
+from .fastnumbers import (
+    sketch_merge as _sketch_merge,
+)
+from .fastnumbers import (
+    sketch_quantiles as _sketch_quantiles,
+)
+from .fastnumbers import (
+    sketch_summary as _sketch_summary,
+)
+from .fastnumbers import (
+    sketch_update as _sketch_update,
+)
 
 try:
     import numpy as np
@@ -59,18 +111,24 @@ else:
         np.uint64,
         np.float32,
         np.float64,
+        np.complex64,
+        np.complex128,
     }
 
 # Hide all type checking code at runtime behind this gate
 if TYPE_CHECKING:
     import array
-    from collections.abc import Iterable
-    from typing import Any, Callable, NewType, TypeVar, overload
+    from collections.abc import Iterable, Sequence
+    from typing import Any, BinaryIO, Callable, Literal, NewType, TypeVar, overload
 
     IntT = TypeVar("IntT", np.int_)
     FloatT = TypeVar("FloatT", np.float64)
+    ComplexT = TypeVar("ComplexT", np.complex128)
     CallToInt = Callable[[Any], int]
     CallToFloat = Callable[[Any], float]
+    CallToComplex = Callable[[Any], complex]
+    SuffixSet = Literal["si", "iec", "percent"] | dict[str, int | float]
+    SuffixesType = SuffixSet | list[SuffixSet] | tuple[SuffixSet, ...] | None
     ALLOWED_T = NewType("ALLOWED_T", object)
     RAISE_T = NewType("RAISE_T", object)
 
@@ -95,6 +153,7 @@ if TYPE_CHECKING:
         output: None = None,
         *,
         dtype: IntT,
+        cache_dir: str | os.PathLike[str] | None = None,
         inf: ALLOWED_T | int | CallToInt = ALLOWED,
         nan: ALLOWED_T | int | CallToInt = ALLOWED,
         on_fail: RAISE_T | int | CallToInt = RAISE,
@@ -102,6 +161,15 @@ if TYPE_CHECKING:
         on_type_error: RAISE_T | int | CallToInt = RAISE,
         base: int = 10,
         allow_underscores: bool = False,
+        allow_hex_float: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        sketch: NumericSketch | None = None,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
     ) -> np.ndarray[IntT]: ...
 
     @overload
@@ -110,6 +178,7 @@ if TYPE_CHECKING:
         output: None = None,
         *,
         dtype: FloatT = np.float64,
+        cache_dir: str | os.PathLike[str] | None = None,
         inf: ALLOWED_T | int | float | CallToInt | CallToFloat = ALLOWED,
         nan: ALLOWED_T | int | float | CallToInt | CallToFloat = ALLOWED,
         on_fail: RAISE_T | int | float | CallToInt | CallToFloat = RAISE,
@@ -117,8 +186,55 @@ if TYPE_CHECKING:
         on_type_error: RAISE_T | int | float | CallToInt | CallToFloat = RAISE,
         base: int = 10,
         allow_underscores: bool = False,
+        allow_hex_float: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        sketch: NumericSketch | None = None,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
     ) -> np.ndarray[FloatT]: ...
 
+    @overload
+    def try_array(
+        input: Iterable[Any],
+        output: None = None,
+        *,
+        dtype: ComplexT,
+        cache_dir: str | os.PathLike[str] | None = None,
+        inf: ALLOWED_T | complex | CallToComplex = ALLOWED,
+        nan: ALLOWED_T | complex | CallToComplex = ALLOWED,
+        on_fail: RAISE_T | complex | CallToComplex = RAISE,
+        on_overflow: RAISE_T | complex | CallToComplex = RAISE,
+        on_type_error: RAISE_T | complex | CallToComplex = RAISE,
+        allow_underscores: bool = False,
+        consume: bool = False,
+    ) -> np.ndarray[ComplexT]: ...
+
+    @overload
+    def try_array(
+        input: Iterable[Any],
+        output: None = None,
+        *,
+        dtype: type[object],
+        inf: Any = ALLOWED,
+        nan: Any = ALLOWED,
+        on_fail: Any = RAISE,
+        on_type_error: Any = RAISE,
+        coerce: bool = True,
+        denoise: bool = False,
+        allow_underscores: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
+    ) -> np.ndarray[Any]: ...
+
     @overload
     def try_array(
         input: Iterable[Any],
@@ -131,6 +247,15 @@ if TYPE_CHECKING:
         on_type_error: RAISE_T | int | CallToInt = RAISE,
         base: int = 10,
         allow_underscores: bool = False,
+        allow_hex_float: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        sketch: NumericSketch | None = None,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
     ) -> None: ...
 
     @overload
@@ -145,6 +270,29 @@ if TYPE_CHECKING:
         on_type_error: RAISE_T | int | float | CallToInt | CallToFloat = RAISE,
         base: int = 10,
         allow_underscores: bool = False,
+        allow_hex_float: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        sketch: NumericSketch | None = None,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
+    ) -> None: ...
+
+    @overload
+    def try_array(
+        input: Iterable[Any],
+        output: np.ndarray[ComplexT],
+        *,
+        inf: ALLOWED_T | complex | CallToComplex = ALLOWED,
+        nan: ALLOWED_T | complex | CallToComplex = ALLOWED,
+        on_fail: RAISE_T | complex | CallToComplex = RAISE,
+        on_overflow: RAISE_T | complex | CallToComplex = RAISE,
+        on_type_error: RAISE_T | complex | CallToComplex = RAISE,
+        allow_underscores: bool = False,
+        consume: bool = False,
     ) -> None: ...
 
     @overload
@@ -159,6 +307,15 @@ if TYPE_CHECKING:
         on_type_error: RAISE_T | int | CallToInt = RAISE,
         base: int = 10,
         allow_underscores: bool = False,
+        allow_hex_float: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        sketch: NumericSketch | None = None,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
     ) -> None: ...
 
     @overload
@@ -173,10 +330,56 @@ if TYPE_CHECKING:
         on_type_error: RAISE_T | int | float | CallToInt | CallToFloat = RAISE,
         base: int = 10,
         allow_underscores: bool = False,
+        allow_hex_float: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        sketch: NumericSketch | None = None,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
+    ) -> None: ...
+
+    @overload
+    def try_array(
+        input: Iterable[Any],
+        output: str | os.PathLike[str] | BinaryIO,
+        *,
+        dtype: IntT | FloatT | ComplexT = np.float64,
+        file_format: Literal["npy", "raw"] = "npy",
+        chunk_size: int = 65536,
+        inf: ALLOWED_T | complex | CallToComplex = ALLOWED,
+        nan: ALLOWED_T | complex | CallToComplex = ALLOWED,
+        on_fail: RAISE_T | complex | CallToComplex = RAISE,
+        on_overflow: RAISE_T | complex | CallToComplex = RAISE,
+        on_type_error: RAISE_T | complex | CallToComplex = RAISE,
+        base: int = 10,
+        allow_underscores: bool = False,
+        allow_hex_float: bool = False,
+        allow_fraction: bool = False,
+        assume_valid: bool = False,
+        consume: bool = False,
+        sketch: NumericSketch | None = None,
+        decimal_point: str = ".",
+        thousands: str | None = None,
+        accounting: bool = False,
+        suffixes: SuffixesType = None,
     ) -> None: ...
 
 
-def try_array(input, output=None, *, dtype=None, **kwargs):  # noqa: A002, D417
+def try_array(  # noqa: A002, D417
+    input,
+    output=None,
+    *,
+    dtype=None,
+    file_format="npy",
+    chunk_size=65536,
+    cache_dir=None,
+    consume=False,
+    sketch=None,
+    **kwargs,
+):
     r"""
     Quickly convert an iterable's contents into an array.
 
@@ -188,18 +391,81 @@ def try_array(input, output=None, *, dtype=None, **kwargs):  # noqa: A002, D417
     Parameters
     ----------
     input
-        The iterable of values to convert into an array.
+        The iterable of values to convert into an array. A dictionary-encoded
+        input (a ``pandas.Categorical``, a ``pandas.Series`` of category
+        *dtype*, or a ``pyarrow.DictionaryArray`` or ``pyarrow.ChunkedArray``
+        of them) is converted by converting each distinct value only once and
+        gathering the results by index, so that the time depends on the number
+        of distinct values rather than the length. A missing value is converted
+        as NaN (as when iterating over a ``pandas.Categorical``), and any
+        callables given as options are called once per distinct value.
     output : optional
         If specified, it is an already existing array object that will contain
         the converted data. It must be of the same length as the input, and
         must be one-dimensional (though a 1D slice of a multi-dimensional array
-        is allowed). ``numpy.ndarray`` and ``array.array`` types are allowed.
+        is allowed). ``numpy.ndarray`` and ``array.array`` types are allowed,
+        as is any other writable object that supports the buffer protocol,
+        such as ``mmap.mmap``.
         If *None*, a ``numpy.ndarray`` will be created for you and will be
-        returned as the return value.
+        returned as the return value. It may also be a file path or a binary
+        file object, to which the converted data is written as described by
+        ``file_format``; the input is then converted ``chunk_size`` elements at
+        a time, so memory use does not grow with the size of the input, and
+        the input may be an iterator of unknown length. A buffer with a
+        ``write`` method, such as ``mmap.mmap``, is filled in place and not
+        treated as a file.
     dtype : optional
         If ``output`` is *None*, this specifies the *dtype* of the returned
         ``ndarray``. The default is ``np.float64``. The *dtype* must be of
-        integral or float type. Ignored if ``output`` is not *None*.
+        integral, float, complex, or object type. Ignored if ``output`` is not
+        *None*. Strings are parsed as by :func:`try_complex` for a complex
+        *dtype*. For an *object* *dtype*, each element is the *int* or *float*
+        that :func:`try_real` returns, so e.g. big integers are exact, and the
+        options are those of :func:`try_real` (except that ``on_fail`` still
+        defaults to *RAISE*, and ``on_overflow`` is ignored). Also used if
+        ``output`` is a file, which cannot have an *object* *dtype*.
+    file_format : str, optional
+        If ``output`` is a file, ``'npy'`` writes a NumPy ``.npy`` file that
+        can be read with ``numpy.load``, including with ``mmap_mode``, and
+        ``'raw'`` writes only the values in native byte order, as
+        ``numpy.ndarray.tofile`` does. To write a ``.npy`` file for an input
+        whose length is not known, the file must be seekable, since the
+        header is rewritten once the length is known. If the input gives a
+        different number of elements than its length, a *ValueError* is
+        raised. If conversion fails, the file is left incomplete. The default
+        is ``'npy'``.
+    chunk_size : int, optional
+        If ``output`` is a file, the number of elements converted and
+        written at a time. The default is 65536.
+    cache_dir : str or path-like, optional
+        If given, the returned array is cached in a ``.npy`` file in this
+        directory (which is created if needed), named by a hash of the
+        contents of the input, the *dtype*, and the other options. The next
+        call with the same input and options hashes the input instead of
+        converting it, and returns the cached array memory-mapped in
+        copy-on-write mode, so changes to it are not written to the file.
+        Elements must be *str*, *bytes*, *bytearray*, *int*, or *float*
+        (not subclasses) to be hashed, and none of the options may be
+        callable; otherwise the input is simply converted and nothing is
+        cached. Only allowed if ``output`` is *None*. The hash is fast but
+        not cryptographic, so do not share a cache directory with untrusted
+        writers. The default is *None*, meaning no cache.
+    consume : bool, optional
+        If *True*, the input must be a *list* that the caller no longer needs.
+        Each of its elements is released as soon as it is converted, and the
+        list is left empty, so the input and the output do not both have to
+        fit in memory at once. If an error is raised, some elements of the list
+        may have been replaced with *None*. If ``output`` is *None*, an input
+        with no length is always converted this way, since it is first copied
+        into a list. The default is *False*.
+    sketch : NumericSketch, optional
+        If given, the converted values are also added to this
+        :class:`NumericSketch`, read from the output as C numbers so that
+        nothing is converted twice. This is much faster than a separate
+        :meth:`NumericSketch.update`. Values are added only once all are
+        converted (or, for a file, each chunk once it is converted), so
+        nothing is added if an error is raised. The *dtype* must be integral
+        or float. The default is *None*.
     inf : optional
         Control how INF is interpreted/handled. The default is *ALLOWED*, which
         indicates that both the string \"inf\" or the float INF are accepted.
@@ -233,6 +499,43 @@ def try_array(input, output=None, *, dtype=None, **kwargs):  # noqa: A002, D417
         or *float* (see PEP 515 for details on what is and is not allowed). You can
         enable that behavior by setting this option to *True* - the default is
         *False*.
+    allow_hex_float : bool, optional
+        If *True*, a string starting with ``'0x'`` (after the sign) is a
+        hexadecimal float as accepted by *float.fromhex*, e.g. ``'0x1.8p+3'``,
+        and is converted exactly. Only used if the *dtype* is a float type. A
+        value too large for the *dtype* is handled by ``on_overflow``. The
+        default is *False*.
+    allow_fraction : bool, optional
+        If *True*, a string may also be a rational number, either ``'3/4'`` or
+        a mixed number like ``'1 3/4'``, and is converted to the nearest value
+        of the *dtype*. Only used if the *dtype* is a float type. A zero
+        denominator is invalid. The default is *False*.
+    assume_valid : bool, optional
+        If *True*, strings are trusted to be valid numbers with no whitespace,
+        such as data written by another program, so the whitespace is not
+        stripped and integers are converted with no validation at all. The
+        value stored for a string that is not a valid number is unspecified
+        (but memory is never read out of bounds). The default is *False*.
+    decimal_point : str, optional
+        The character that separates the integer and decimal parts of a number
+        in a string, e.g. ``','`` for ``'1234,56'``. The default is ``'.'``.
+    thousands : str or None, optional
+        The character that groups the integer digits of a number in a string by
+        thousands, e.g. ``','`` for ``'1,234.56'``. A string with separators
+        that do not divide the integer digits into groups of three is invalid.
+        The default is *None*, meaning no separator is allowed.
+    accounting : bool, optional
+        If *True*, a number in a string that is enclosed in parentheses is
+        negative, e.g. ``'(1,234.50)'``. The default is *False*.
+    suffixes : str, dict, list, or None, optional
+        Unit suffixes that may follow a number in a string, which then is
+        multiplied by the suffix's multiplier, e.g. ``'1.5k'`` is 1500. Give the
+        name of a built-in set - ``'si'`` (k, M, G, T, P, E, m, u, n),
+        ``'iec'`` (Ki, Mi, ... Ei, and KiB, MiB, ... EiB), or ``'percent'``
+        (%) - or a dict of suffix to multiplier, or a list of these. The
+        scaling is exact, so a value is accepted for an integer array if it
+        is integral after scaling. Only base-10 numbers may have a suffix.
+        The default is *None*.
 
     Returns
     -------
@@ -254,6 +557,13 @@ def try_array(input, output=None, *, dtype=None, **kwargs):  # noqa: A002, D417
         If ``on_fail`` is set to *RAISE* and a triggering event is set.
     TypeError
         If ``output`` is given and it is of an invalid type (including data type).
+    ValueError
+        If ``file_format`` or ``chunk_size`` is not valid, or the length of the
+        input is needed but not known.
+    ValueError
+        If ``cache_dir`` is given and ``output`` is not *None*.
+    TypeError
+        If ``consume`` is *True* and the input is not a *list*.
     RuntimeError
         If ``output`` is not *None* but *numpy* is not installed.
     TypeError
@@ -278,8 +588,34 @@ def try_array(input, output=None, *, dtype=None, **kwargs):  # noqa: A002, D417
         >>> try_array(["5", "3", "8"], output=output)
         >>> np.array_equal(output, np.array([5, 3, 8], dtype=np.int32))
         True
+        >>> import io
+        >>> sink = io.BytesIO()
+        >>> try_array(iter(["5", "3", "8"]), sink, dtype=np.int16, file_format="raw")
+        >>> sink.getvalue() == np.array([5, 3, 8], dtype=np.int16).tobytes()
+        True
 
     """
+    if consume and not isinstance(input, list):
+        msg = f"consume=True requires the input to be a list, not {type(input)}"
+        raise TypeError(msg)
+
+    if sketch is not None:
+        _check_sketch(sketch, output, dtype)
+
+    # A cached result is reused if the input and options were seen before.
+    if cache_dir is not None:
+        result = _try_array_cached(input, output, dtype, cache_dir, consume, kwargs)
+        if sketch is not None:
+            _sketch_add(sketch._sketch, result)
+        return result
+
+    # A file path or file object is written in chunks.
+    if _is_file(output):
+        _try_array_to_file(
+            input, output, dtype, file_format, chunk_size, consume, sketch, kwargs
+        )
+        return None
+
     # If output is not provided, we construct a numpy array of the same length
     # as the input into which the C++ function can populate the output.
     if output is None:
@@ -296,30 +632,44 @@ def try_array(input, output=None, *, dtype=None, **kwargs):  # noqa: A002, D417
         try:
             length = len(input)
         except TypeError:
+            # Nothing else refers to this copy, so it can be consumed.
             input = list(input)  # noqa: A001
             length = len(input)
+            consume = True
         output = np.empty(length, dtype=dtype or np.float64)
     else:
         return_output = False
 
         # Let's be conservative about what we feed to the C++ code.
         try:
-            if output.dtype.type not in _allowed_dtypes:
+            if output.dtype.type not in _allowed_dtypes | {np.object_}:
                 raise TypeError(
                     "The only supported numpy dtypes for output are: "
                     + ", ".join(sorted([x.__name__ for x in _allowed_dtypes]))
-                    + f" not {output.dtype.name}"
+                    + f", object_ not {output.dtype.name}"
                 )
         except AttributeError:
-            if not hasattr(output, "typecode"):
+            if not hasattr(output, "typecode") and not _is_buffer(output):
                 msg = (
-                    "Only numpy ndarray and array.array types for output are "
-                    f"supported, not {type(output)}"
+                    "Only numpy ndarray, array.array, and other buffer types "
+                    f"for output are supported, not {type(output)}"
                 )
                 raise TypeError(msg) from None
 
-    # Call the C++ extension
-    _array(input, output, **kwargs)
+    # Call the C++ extension. Objects are stored as try_real would return
+    # them, with the defaults of try_array.
+    chunks = _dictionary_chunks(input) if has_numpy else None
+    if chunks is not None:
+        _try_array_dictionary(chunks, output, kwargs)
+    elif has_numpy and isinstance(output, np.ndarray) and output.dtype.hasobject:
+        options = {"on_fail": RAISE, **kwargs}
+        options.pop("on_overflow", None)
+        converter = try_real(None, map="converter", **options)
+        _object_array(input, output, converter, consume=consume)
+    else:
+        _array(input, output, consume=consume, **kwargs)
+    if sketch is not None:
+        _sketch_add(sketch._sketch, output)
 
     # If no output value was given on calling, we return the output as a return value.
     if return_output:
@@ -327,6 +677,914 @@ def try_array(input, output=None, *, dtype=None, **kwargs):  # noqa: A002, D417
     return None
 
 
+def _is_buffer(output: Any) -> bool:
+    """Whether the output supports the buffer protocol."""
+    try:
+        memoryview(output).release()
+    except TypeError:
+        return False
+    return True
+
+
+def _is_file(output: Any) -> bool:
+    """Whether the output is a file path or a file object, not a buffer."""
+    if isinstance(output, (str, os.PathLike)):
+        return True
+    # A buffer that can also be written to like a file (e.g. an mmap) is
+    # filled in place like any other buffer.
+    return hasattr(output, "write") and not _is_buffer(output)
+
+
+def _check_sketch(sketch: Any, output: Any, dtype: Any) -> None:
+    """Raise if the values placed in the output cannot be added to the sketch."""
+    if not isinstance(sketch, NumericSketch):
+        msg = f"sketch must be a NumericSketch, not {type(sketch).__name__}"
+        raise TypeError(msg)
+    if hasattr(output, "typecode"):
+        kind = "f" if output.typecode in "fd" else "i"
+    elif hasattr(output, "dtype"):
+        kind = output.dtype.kind
+    elif has_numpy:
+        kind = np.dtype(dtype or np.float64).kind
+    else:
+        return
+    if kind not in "iuf":
+        msg = "sketch can only be used with an integral or float dtype"
+        raise TypeError(msg)
+
+
+def _dictionary_chunks(input: Any) -> list[tuple[list[Any], Any]] | None:  # noqa: A002
+    """
+    Split a dictionary-encoded input into its distinct values and indices.
+
+    Returns a list of (values, indices) pairs, one per chunk of the input,
+    where missing values have the index -1. Returns *None* if the input is
+    not dictionary-encoded.
+    """
+    # A pandas Series of category dtype wraps a Categorical.
+    if getattr(getattr(input, "dtype", None), "name", None) == "category":
+        input = input.array  # noqa: A001
+    if hasattr(input, "categories") and hasattr(input, "codes"):
+        return [(input.categories.tolist(), np.asarray(input.codes))]
+    if hasattr(input, "dictionary") and hasattr(input, "indices"):
+        indices = input.indices
+        if indices.null_count:
+            indices = indices.fill_null(-1)
+        return [(input.dictionary.to_pylist(), indices.to_numpy())]
+    if hasattr(input, "chunks"):
+        pairs = []
+        for chunk in input.chunks:
+            encoded = _dictionary_chunks(chunk)
+            if encoded is None:
+                return None
+            pairs.extend(encoded)
+        return pairs or None
+    return None
+
+
+def _try_array_dictionary(
+    chunks: list[tuple[list[Any], Any]], output: Any, kwargs: dict[str, Any]
+) -> None:
+    """Convert the distinct values of each chunk, then gather by index."""
+    target = np.asarray(output)
+    if len(target) != sum(len(indices) for _, indices in chunks):
+        msg = "input/output must be of equal size"
+        raise ValueError(msg)
+
+    # The dtype of the output was already checked, so an equivalent dtype
+    # that numpy names differently (e.g. longlong for array.array("q")) is
+    # given straight to the C++ code. Only objects need try_array.
+    def convert(values: list[Any], out: Any) -> None:
+        if target.dtype.hasobject:
+            try_array(values, out, **kwargs)
+        else:
+            _array(values, out, **kwargs)
+
+    start = 0
+    for values, indices in chunks:
+        stop = start + len(indices)
+        # Missing values are NaN, as when iterating over a Categorical, and
+        # are converted last, where the index -1 wraps to.
+        if (indices < 0).any():
+            values = [*values, math.nan]
+        converted = np.empty(len(values), dtype=target.dtype)
+        try:
+            convert(values, converted)
+        except (ValueError, TypeError, OverflowError):
+            # Only the values that are used may cause an error, and the
+            # error must name the first of them.
+            used = [values[i] for i in indices.tolist()]
+            convert(used, target[start:stop])
+        else:
+            np.take(converted, indices, out=target[start:stop], mode="wrap")
+        start = stop
+
+
+# The number of digits reserved for the length in a .npy header, so that
+# the header can be rewritten in place once the length is known.
+_NPY_LENGTH_DIGITS = 20
+
+
+def _npy_header(dtype: Any, length: int) -> bytes:
+    """Create a version 1.0 .npy header for a 1D array."""
+    header = (
+        f"{{'descr': {dtype.str!r}, 'fortran_order': False, 'shape': ({length},), }}"
+    )
+    header += " " * (_NPY_LENGTH_DIGITS - len(str(length)))
+    # The magic string, version, and header length take 10 bytes, and the
+    # whole header must end in a newline and be a multiple of 64 bytes.
+    header += " " * (-(10 + len(header) + 1) % 64) + "\n"
+    return b"\x93NUMPY\x01\x00" + struct.pack("<H", len(header)) + header.encode()
+
+
+def _try_array_to_file(  # noqa: PLR0913
+    input: Any,  # noqa: A002
+    output: Any,
+    dtype: Any,
+    file_format: str,
+    chunk_size: int,
+    consume: bool,
+    sketch: NumericSketch | None,
+    kwargs: dict[str, Any],
+) -> None:
+    """Convert the input in chunks and write each to a file."""
+    if file_format not in ("npy", "raw"):
+        msg = f"file_format must be 'npy' or 'raw', not {file_format!r}"
+        raise ValueError(msg)
+    if not isinstance(chunk_size, builtins.int) or chunk_size < 1:
+        msg = f"chunk_size must be a positive int, not {chunk_size!r}"
+        raise ValueError(msg)
+    if not has_numpy:
+        msg = (
+            "To use fastnumbers.try_array with a file requires numpy "
+            "to also be installed"
+        )
+        raise RuntimeError(msg)
+    dtype = np.dtype(dtype or np.float64)
+    if dtype.type not in _allowed_dtypes:
+        raise TypeError(
+            "The only supported numpy dtypes for output are: "
+            + ", ".join(sorted([x.__name__ for x in _allowed_dtypes]))
+            + f" not {dtype.name}"
+        )
+
+    try:
+        length = len(input)
+    except TypeError:
+        length = None
+
+    if isinstance(output, (str, os.PathLike)):
+        sink = open(output, "wb")  # noqa: SIM115
+    else:
+        sink = output
+    try:
+        # The header is written first with the length if known, otherwise
+        # with a zero length that is replaced at the end.
+        if file_format == "npy":
+            if length is None and not sink.seekable():
+                msg = (
+                    "to write a .npy file, the input must have a length "
+                    "or the file must be seekable"
+                )
+                raise ValueError(msg)
+            start = sink.tell() if length is None else 0
+            sink.write(_npy_header(dtype, length or 0))
+
+        # Each chunk is converted into the same staging buffer and written.
+        staging = np.empty(chunk_size, dtype=dtype)
+        iterator = iter(input)
+        written = 0
+        while chunk := list(itertools.islice(iterator, chunk_size)):
+            view = staging[: len(chunk)]
+            _array(chunk, view, consume=True, **kwargs)
+            sink.write(memoryview(view).cast("B"))
+            if sketch is not None:
+                _sketch_add(sketch._sketch, view)
+            # Release the chunk from the input without changing its length.
+            if consume:
+                input[written : written + len(view)] = itertools.repeat(None, len(view))
+            written += len(view)
+
+        # A header with the wrong length would make a corrupt file.
+        if file_format == "npy" and length is not None and written != length:
+            msg = (
+                f"the input has a length of {length} but {written} elements "
+                "were converted"
+            )
+            raise ValueError(msg)
+        if file_format == "npy" and length is None:
+            end = sink.tell()
+            sink.seek(start)
+            sink.write(_npy_header(dtype, written))
+            sink.seek(end)
+        if consume:
+            input.clear()
+    finally:
+        if sink is not output:
+            sink.close()
+
+
+# The selectors by name, since their repr changes from run to run.
+_selector_names = {
+    "ALLOWED": ALLOWED,
+    "DISALLOWED": DISALLOWED,
+    "INPUT": INPUT,
+    "RAISE": RAISE,
+    "STRING_ONLY": STRING_ONLY,
+    "NUMBER_ONLY": NUMBER_ONLY,
+}
+
+
+def _cache_key(
+    input: Any,  # noqa: A002
+    dtype: Any,
+    kwargs: dict[str, Any],
+) -> str | None:
+    """Hash the input and options, or return None if they cannot be hashed."""
+    options = []
+    for name, value in sorted(kwargs.items()):
+        if callable(value):
+            return None
+        for selector_name, selector in _selector_names.items():
+            if value is selector:
+                value = selector_name  # noqa: PLW2901
+                break
+        options.append(f"{name}={value!r}")
+    # The conversion limits decide which long strings are converted at all.
+    limits = sorted(get_conversion_limits().items())
+    salt = f"{__version__}|{dtype.str}|{','.join(options)}|{limits}"
+    return _content_hash(input, salt)
+
+
+def _try_array_cached(
+    input: Any,  # noqa: A002
+    output: Any,
+    dtype: Any,
+    cache_dir: str | os.PathLike[str],
+    consume: bool,
+    kwargs: dict[str, Any],
+) -> Any:
+    """Convert into an ndarray, reusing a result cached on disk."""
+    if output is not None:
+        msg = "cache_dir can only be used if output is None"
+        raise ValueError(msg)
+    if not has_numpy:
+        msg = (
+            "To use fastnumbers.try_array without an explict "
+            "output requires numpy to also be installed"
+        )
+        raise RuntimeError(msg)
+    dtype = np.dtype(dtype or np.float64)
+    if not isinstance(input, (list, tuple)):
+        input = list(input)  # noqa: A001
+
+    # An empty file cannot be memory-mapped, and there is nothing to save.
+    # Objects could only be saved with pickle, which is not memory-mapped.
+    cacheable = input and not dtype.hasobject
+    key = _cache_key(input, dtype, kwargs) if cacheable else None
+    if key is None:
+        return try_array(input, dtype=dtype, consume=consume, **kwargs)
+
+    path = os.path.join(cache_dir, key + ".npy")
+    try:
+        result = np.load(path, mmap_mode="c")
+    except (OSError, ValueError):
+        pass
+    else:
+        if result.dtype == dtype and result.shape == (len(input),):
+            if consume:
+                input.clear()
+            return result
+
+    # Write to a temporary file first so no reader sees a partial file.
+    result = try_array(input, dtype=dtype, consume=consume, **kwargs)
+    os.makedirs(cache_dir, exist_ok=True)
+    fd, temporary = tempfile.mkstemp(suffix=".tmp", dir=cache_dir)
+    try:
+        with os.fdopen(fd, "wb") as sink:
+            np.save(sink, result)
+        os.replace(temporary, path)
+    except BaseException:
+        os.unlink(temporary)
+        raise
+    return result
+
+
+# The conversion functions by the name of their kind, for lazy() and
+# convert_records().
+_conversion_kinds = {
+    "real": try_real,
+    "float": try_float,
+    "int": try_int,
+    "forceint": try_forceint,
+    "complex": try_complex,
+    "fraction": try_fraction,
+    "decimal": try_decimal,
+}
+
+
+def lazy(input: Iterable[Any], kind: str, **kwargs: Any) -> Sequence[Any]:  # noqa: A002, D417
+    r"""
+    Create a sequence that converts the elements of the input only when accessed.
+
+    This is useful when a large collection is converted only to read a small,
+    data-dependent part of it. Each element is converted the first time it is
+    accessed, by indexing, slicing, or iteration, and the result is kept so
+    that it is never converted again. The options are prepared only once when
+    the sequence is created, so each access costs about as much as converting
+    the element with ``map=True``.
+
+    Parameters
+    ----------
+    input
+        The sequence of values to convert. Any other iterable is first
+        collected into a list. A list must not change size while the
+        sequence is in use.
+    kind : str
+        The conversion to use - one of ``'real'``, ``'float'``, ``'int'``,
+        ``'forceint'``, ``'complex'``, ``'fraction'``, or ``'decimal'``, for
+        :func:`try_real`, :func:`try_float`, :func:`try_int`, and so on.
+    \*\*kwargs
+        The options of the conversion function, e.g. ``on_fail``. The ``map``
+        option is not allowed.
+
+    Returns
+    -------
+    Sequence
+        A read-only sequence of the converted values, of the same length as the
+        input. A slice of it is a *list*. It supports the buffer protocol if all
+        values convert to *int* that fit in 64 bits (exported as ``'q'``) or to
+        *int* or *float* (exported as ``'d'``), so it can be given to e.g.
+        ``numpy.asarray`` or ``memoryview``; this converts every element.
+
+    Raises
+    ------
+    ValueError
+        If `kind` is not valid.
+    TypeError
+        If ``map`` is given.
+
+    Examples
+    --------
+        >>> from fastnumbers import lazy
+        >>> values = lazy(["5", "3.5", "oops", "8"], "float", on_fail=float("nan"))
+        >>> len(values)
+        4
+        >>> values[1]
+        3.5
+        >>> values
+        <fastnumbers lazy sequence of 4 elements, 1 converted>
+        >>> values[-2:]
+        [nan, 8.0]
+
+    """
+    if "map" in kwargs:
+        msg = "lazy() got an unexpected keyword argument 'map'"
+        raise TypeError(msg)
+    return _conversion_for(kind)(input, map="lazy", **kwargs)
+
+
+# The lazy sequence is implemented in C, so it is made a Sequence by registration.
+collections.abc.Sequence.register(type(try_float((), map="lazy")))
+
+
+def _conversion_for(kind: str) -> Callable[..., Any]:
+    """Return the conversion function of a kind, or raise a ValueError."""
+    try:
+        return _conversion_kinds[kind]
+    except (KeyError, TypeError):
+        msg = "kind must be one of " + ", ".join(repr(x) for x in _conversion_kinds)
+        raise ValueError(msg) from None
+
+
+# The dtypes of the arrays filled by convert_records(), by the name of the kind.
+_record_dtypes = {
+    "real": "float64",
+    "float": "float64",
+    "int": "int64",
+    "complex": "complex128",
+}
+
+
+def convert_records(  # noqa: D417
+    records: Iterable[Any],
+    fields: dict[Any, Any],
+    *,
+    arrays: bool = False,
+    recurse: bool = False,
+    sketches: dict[Any, NumericSketch] | None = None,
+    **kwargs: Any,
+) -> dict[Any, Any] | None:
+    r"""
+    Convert the fields of a collection of records, such as a JSON payload.
+
+    Each record is a *dict*, and each of the given fields of each record is
+    converted, all in one pass over the records that is done in C++. This is
+    much faster than looping over the records in Python to call a conversion
+    function for each field.
+
+    Parameters
+    ----------
+    records
+        The records to convert, e.g. a *list* of *dict*. Any other iterable
+        is first collected into a list.
+    fields : dict
+        The fields to convert, as a *dict* of the field name to the kind of
+        conversion - one of ``'real'``, ``'float'``, ``'int'``,
+        ``'forceint'``, ``'complex'``, ``'fraction'``, or ``'decimal'``, for
+        :func:`try_real`, :func:`try_float`, :func:`try_int`, and so on.
+        If ``arrays`` is *True*, the kind may instead be a *numpy* dtype, as
+        for :func:`try_array`, and ``'forceint'``, ``'fraction'``, and
+        ``'decimal'`` are not allowed.
+    arrays : bool, optional
+        If *False*, each field of each record is replaced with its converted
+        value, and a record that does not have a field is left as it is. If
+        *True*, the records are not changed, and the values of each field are
+        instead converted into a *numpy* array with :func:`try_array`, in which
+        a missing field is handled as *None* would be, by ``on_type_error``.
+        ``'real'`` and ``'float'`` fill a *float64* array, ``'int'`` an *int64*
+        array, and ``'complex'`` a *complex128* array. The default is *False*.
+    recurse : bool, optional
+        If *True*, records are also looked for inside of records and inside
+        of *list* and *tuple* values, at any depth, so e.g. the ``"items"``
+        of an order are converted too. When ``arrays`` is *True*, only the
+        *dict* objects that have at least one of the fields are records. The
+        default is *False*.
+    sketches : dict, optional
+        A *dict* of field names to a :class:`NumericSketch`, to which the
+        array of each of those fields is added as it is made, as with the
+        ``sketch`` option of :func:`try_array`. Only allowed if ``arrays`` is
+        *True*. The default is *None*.
+    \*\*kwargs
+        The options of the conversion functions, e.g. ``on_fail``, which are
+        used for all fields, or the options of :func:`try_array` if ``arrays``
+        is *True*. The ``map`` and ``sketch`` options are not allowed.
+
+    Returns
+    -------
+    dict or None
+        If ``arrays`` is *True*, a *dict* of each field name to its array,
+        otherwise *None*.
+
+    Raises
+    ------
+    ValueError
+        If the kind of a field is not valid, or ``sketches`` is given without
+        ``arrays``.
+    TypeError
+        If a record is not a *dict* and ``recurse`` is *False*, or an option is
+        not valid for a conversion function.
+
+    Examples
+    --------
+        >>> from fastnumbers import convert_records
+        >>> records = [{"id": "a", "price": "1.50", "qty": "3"}, {"price": "2"}]
+        >>> convert_records(records, {"price": "float", "qty": "int"})
+        >>> records
+        [{'id': 'a', 'price': 1.5, 'qty': 3}, {'price': 2.0}]
+        >>> columns = convert_records(
+        ...     [{"qty": "3"}, {"qty": "4"}], {"qty": "int"}, arrays=True
+        ... )
+        >>> columns["qty"].tolist()
+        [3, 4]
+
+    """
+    for option in ("map", "sketch"):
+        if option in kwargs:
+            msg = f"convert_records() got an unexpected keyword argument {option!r}"
+            raise TypeError(msg)
+    if sketches is None:
+        sketches = {}
+    elif not arrays:
+        msg = "sketches can only be used if arrays is True"
+        raise ValueError(msg)
+
+    if not arrays:
+        converters = {
+            name: _conversion_for(kind)(None, map="converter", **kwargs)
+            for name, kind in fields.items()
+        }
+        _records(records, converters, recurse=recurse)
+        return None
+
+    dtypes: dict[Any, Any] = {}
+    for name, kind in fields.items():
+        if isinstance(kind, str):
+            try:
+                dtypes[name] = _record_dtypes[kind]
+            except KeyError:
+                kinds = ", ".join(repr(x) for x in _record_dtypes)
+                msg = f"with arrays=True, kind must be a dtype or one of {kinds}"
+                raise ValueError(msg) from None
+        else:
+            dtypes[name] = kind
+    columns = _records(records, tuple(dtypes), collect=True, recurse=recurse)
+    return {
+        name: try_array(
+            column, dtype=dtype, consume=True, sketch=sketches.get(name), **kwargs
+        )
+        for (name, dtype), column in zip(dtypes.items(), columns)
+    }
+
+
+def factorize_numeric(  # noqa: D417
+    input: Iterable[Any],  # noqa: A002
+    dtype: Any = None,
+    *,
+    sort: bool = False,
+    codes_dtype: Any = None,
+    **kwargs: Any,
+) -> tuple[Any, Any]:
+    r"""
+    Convert an iterable into numbers, and number its distinct values.
+
+    This gives the same result as ``np.unique(try_array(input, dtype=dtype),
+    return_inverse=True)``, but each element is looked up in a hash table as
+    soon as it is converted, in one pass in C++, instead of the whole array
+    being sorted afterwards. This is much faster for columns with few distinct
+    values, such as categories or codes that happen to be numbers.
+
+    Parameters
+    ----------
+    input
+        The iterable of values to convert.
+    dtype : optional
+        The *dtype* of the values, as for :func:`try_array`. The default is
+        ``np.float64``.
+    sort : bool, optional
+        If *True*, the distinct values are in sorted order, like
+        ``np.unique``. If *False*, they are in the order in which they first
+        appear. The default is *False*.
+    codes_dtype : optional
+        The *dtype* of the codes, either ``np.int32`` or ``np.int64``. The
+        default is ``np.intp``.
+    \*\*kwargs
+        The options of :func:`try_array`, e.g. ``on_fail``, which are applied
+        before the values are compared. ``consume`` is not allowed.
+
+    Returns
+    -------
+    tuple
+        The distinct values as a ``numpy.ndarray`` of ``dtype``, and the codes
+        as a ``numpy.ndarray`` of ``codes_dtype``, in which each element is the
+        index of the value of the element of the input in the distinct values.
+        All NaN are one value, as are ``0.0`` and ``-0.0``.
+
+    Raises
+    ------
+    TypeError
+        If a *dtype* is not supported, or as for :func:`try_array`.
+    ValueError
+        As for :func:`try_array`.
+    OverflowError
+        As for :func:`try_array`.
+
+    Examples
+    --------
+        >>> from fastnumbers import factorize_numeric
+        >>> import numpy as np
+        >>> values, codes = factorize_numeric(["3", "1", "3.0", "2"])
+        >>> values.tolist(), codes.tolist()
+        ([3.0, 1.0, 2.0], [0, 1, 0, 2])
+        >>> values, codes = factorize_numeric(["3", "1", "3"], np.int64, sort=True)
+        >>> values.tolist(), codes.tolist()
+        ([1, 3], [1, 0, 1])
+
+    """
+    if not has_numpy:
+        msg = "To use fastnumbers.factorize_numeric requires numpy to be installed"
+        raise RuntimeError(msg)
+    dtype = np.dtype(dtype or np.float64)
+    if dtype.type not in _allowed_dtypes:
+        raise TypeError(
+            "The only supported numpy dtypes for values are: "
+            + ", ".join(sorted([x.__name__ for x in _allowed_dtypes]))
+            + f" not {dtype.name}"
+        )
+    codes_dtype = np.dtype(codes_dtype or np.intp)
+    if codes_dtype.type not in (np.int32, np.int64):
+        msg = f"codes_dtype must be int32 or int64, not {codes_dtype.name}"
+        raise TypeError(msg)
+
+    try:
+        length = len(input)
+    except TypeError:
+        input = list(input)  # noqa: A001
+        length = len(input)
+    codes = np.empty(length, dtype=codes_dtype)
+    data, numbered = _factorize(input, codes, np.empty(0, dtype=dtype), **kwargs)
+
+    # If most values were distinct, all values were returned to be sorted
+    # instead, and first appearance has to be recovered from the sort.
+    if not numbered:
+        values = np.frombuffer(data, dtype=dtype)
+        uniques, inverse = np.unique(values, return_inverse=True, equal_nan=True)
+        codes = inverse.astype(codes_dtype, copy=False).reshape(-1)
+        if sort:
+            return uniques, codes
+        first = np.full(len(uniques), length)
+        np.minimum.at(first, codes, np.arange(length))
+        order = np.argsort(first)
+        uniques = uniques[order]
+    else:
+        uniques = np.frombuffer(data, dtype=dtype)
+        if not sort:
+            return uniques, codes
+        order = np.argsort(uniques)
+        uniques = uniques[order]
+
+    # Only the distinct values are reordered, and the codes are renumbered.
+    ranks = np.empty(len(order), dtype=codes_dtype)
+    ranks[order] = np.arange(len(order), dtype=codes_dtype)
+    np.take(ranks, codes, out=codes)
+    return uniques, codes
+
+
+def digitize_numeric(  # noqa: D417
+    input: Iterable[Any],  # noqa: A002
+    edges: Iterable[Any],
+    *,
+    right: bool = False,
+    counts: bool = False,
+    dtype: Any = None,
+    **kwargs: Any,
+) -> Any:
+    r"""
+    Convert an iterable into numbers, and find the bin of each among bin edges.
+
+    This gives the same result as ``np.digitize(try_array(input), edges,
+    right)``, except for NaN, but each element is placed in its bin as soon as
+    it is converted, in one pass in C++, without an intermediate array of
+    values. If only the number of elements in each bin is needed, not even
+    the array of bins is created.
+
+    Parameters
+    ----------
+    input
+        The iterable of values to convert. Each is converted as
+        :func:`try_array` would to ``np.float64``.
+    edges
+        The bin edges, which must be sorted in increasing order. With *n*
+        edges there are *n + 2* bins: bin *i* (for *0 <= i <= n*) holds the
+        values from ``edges[i - 1]`` up to but not including ``edges[i]``,
+        and bin *n + 1* holds NaN and the elements that could not be
+        converted.
+    right : bool, optional
+        If *True*, a value equal to an edge belongs to the bin below the
+        edge instead of the bin above it. The default is *False*.
+    counts : bool, optional
+        If *True*, return the number of elements in each bin instead of the
+        bin of each element. The input may then be an iterator of any length,
+        as it is not collected into a list. The default is *False*.
+    dtype : optional
+        The *dtype* of the bins, an integer type that must be able to hold
+        *n + 1*. The default is the smallest of ``np.uint8``, ``np.uint16``,
+        and ``np.uint32`` that can. Ignored if ``counts`` is *True*.
+    \*\*kwargs
+        The options of :func:`try_array`, e.g. ``inf`` or ``allow_underscores``.
+        ``on_fail`` and ``on_type_error`` default to NaN, which places the
+        element in the last bin, but may be e.g. ``RAISE`` or a callable.
+        ``on_overflow``, ``base``, and ``consume`` are not allowed.
+
+    Returns
+    -------
+    numpy.ndarray
+        The bin of each element as an array of ``dtype``, or if ``counts`` is
+        *True*, the number of elements in each bin as an array of *n + 2*
+        ``np.int64``.
+
+    Raises
+    ------
+    ValueError
+        If the edges are not sorted, or ``dtype`` cannot hold all bins.
+    TypeError
+        If ``dtype`` is not an integer type, or as for :func:`try_array`.
+
+    Examples
+    --------
+        >>> from fastnumbers import digitize_numeric
+        >>> values = ["0.5", "1", "7", "x", "-3"]
+        >>> digitize_numeric(values, [0, 1, 5]).tolist()
+        [1, 2, 3, 4, 0]
+        >>> digitize_numeric(values, [0, 1, 5], right=True).tolist()
+        [1, 1, 3, 4, 0]
+        >>> digitize_numeric(iter(values), [0, 1, 5], counts=True).tolist()
+        [1, 1, 1, 1, 1]
+
+    """
+    if not has_numpy:
+        msg = "To use fastnumbers.digitize_numeric requires numpy to be installed"
+        raise RuntimeError(msg)
+    edges = np.ascontiguousarray(edges, dtype=np.float64)
+    if edges.ndim != 1:
+        msg = "edges must be one-dimensional"
+        raise ValueError(msg)
+    if np.isnan(edges).any() or (edges[1:] < edges[:-1]).any():
+        msg = "edges must be sorted in increasing order"
+        raise ValueError(msg)
+    options = {"on_fail": math.nan, "on_type_error": math.nan, **kwargs}
+    bins = len(edges) + 2
+
+    if counts:
+        output = np.zeros(bins, dtype=np.int64)
+        _digitize(input, output, edges, right=right, counts=True, **options)
+        return output
+
+    if dtype is None:
+        dtype = np.uint8 if bins <= 256 else np.uint16 if bins <= 65536 else np.uint32
+    dtype = np.dtype(dtype)
+    if dtype.kind not in "iu" or dtype.type not in _allowed_dtypes:
+        msg = f"dtype must be an integer type, not {dtype.name}"
+        raise TypeError(msg)
+    if np.iinfo(dtype).max < bins - 1:
+        msg = f"dtype {dtype.name} cannot hold the numbers of {bins} bins"
+        raise ValueError(msg)
+    try:
+        length = len(input)
+    except TypeError:
+        input = list(input)  # noqa: A001
+        length = len(input)
+    output = np.empty(length, dtype=dtype)
+    _digitize(input, output, edges, right=right, **options)
+    return output
+
+
+class NumericSketch:
+    r"""
+    A mergeable summary of numbers that estimates quantiles and distinct counts.
+
+    With :meth:`update`, each value is converted as :func:`try_array` would to
+    ``np.float64`` and added to the sketch as soon as it is parsed in C++, so
+    no list or array of the values is ever created. This is a separate pass
+    over the input, so to also get the array, pass the sketch as the ``sketch``
+    option of :func:`try_array` (or ``sketches`` of :func:`convert_records`)
+    instead, which adds the values already converted into the array without
+    parsing them again. The sketch keeps the exact count, NaN count, minimum,
+    and maximum, a KLL sketch to estimate quantiles, and a HyperLogLog
+    estimator to count distinct values, in a fixed few tens of kilobytes no
+    matter how many values are added.
+
+    Sketches of separate chunks of data can be combined with :meth:`merge`,
+    and a sketch can be stored or sent to another process as bytes with
+    :meth:`to_bytes` and :meth:`from_bytes` (or :mod:`pickle`). Values are
+    converted while holding the GIL, so to use threads give each thread its
+    own sketch and merge them at the end. numpy is not needed.
+
+    Parameters
+    ----------
+    k : int, optional
+        The size of the quantile sketch, between 8 and 65535. The rank of an
+        estimated quantile is typically within about ``1.7 / k`` of the
+        requested fraction. The default is 200, i.e. within about 1%.
+    precision : int, optional
+        The base 2 logarithm of the number of registers of the distinct
+        count estimator, between 4 and 18. The relative error of
+        :meth:`distinct` is about ``1.04 / sqrt(2 ** precision)``. The default
+        is 14, i.e. about 0.8%. Only sketches of equal precision can be merged.
+
+    Raises
+    ------
+    ValueError
+        If ``k`` or ``precision`` is out of range.
+
+    Examples
+    --------
+        >>> from fastnumbers import NumericSketch
+        >>> sketch = NumericSketch()
+        >>> sketch.update(["5", "1", "x", "3.5"])
+        >>> sketch.update(iter([2, 4.0, "nan"]))
+        >>> sketch.count, sketch.nan_count, sketch.min, sketch.max
+        (5, 2, 1.0, 5.0)
+        >>> sketch.quantile(0.5)
+        3.5
+        >>> sketch.quantile([0.25, 0.75])
+        [2.0, 4.0]
+        >>> round(sketch.distinct())
+        5
+
+    """
+
+    __slots__ = ("_sketch",)
+
+    def __init__(self, k: int = 200, precision: int = 14) -> None:
+        self._sketch = _sketch(k, precision)
+
+    def update(self, input: Iterable[Any], **kwargs: Any) -> None:  # noqa: A002, D417
+        r"""
+        Convert the values of an iterable into numbers and add them.
+
+        This is a conversion pass of its own. If the values are also needed
+        as an array, use the ``sketch`` option of :func:`try_array`, which is
+        much faster than converting the input twice.
+
+        Parameters
+        ----------
+        input
+            The iterable of values to add, which may be an iterator of any
+            length. Each is converted as :func:`try_array` would to
+            ``np.float64``.
+        \*\*kwargs
+            The options of :func:`try_array`, e.g. ``inf`` or
+            ``allow_underscores``. ``on_fail`` and ``on_type_error`` default
+            to NaN, so that elements that cannot be converted are counted in
+            :attr:`nan_count`, but may be e.g. ``RAISE`` or a callable.
+            ``on_overflow``, ``base``, and ``consume`` are not allowed.
+
+        """
+        options = {"on_fail": math.nan, "on_type_error": math.nan, **kwargs}
+        _sketch_update(self._sketch, input, **options)
+
+    def merge(self, other: NumericSketch) -> None:
+        """
+        Add the values of another sketch, e.g. of another chunk of the data.
+
+        Raises
+        ------
+        ValueError
+            If the sketches do not have the same ``precision``.
+
+        """
+        if not isinstance(other, NumericSketch):
+            msg = f"other must be a NumericSketch, not {type(other).__name__}"
+            raise TypeError(msg)
+        _sketch_merge(self._sketch, other._sketch)
+
+    def quantile(self, q: Any) -> Any:
+        """
+        Estimate a quantile, or a list of quantiles, of the values.
+
+        The quantile of a fraction *q* is the smallest value such that at least
+        a fraction *q* of the values are less than or equal to it, like
+        ``np.quantile(..., method="inverted_cdf")``. It is exact while fewer
+        than about ``k`` values have been added, and at 0 and 1, which are
+        the minimum and maximum. With no values, it is NaN.
+
+        Raises
+        ------
+        ValueError
+            If a fraction is not between 0 and 1.
+
+        """
+        try:
+            fractions = list(q)
+        except TypeError:
+            return _sketch_quantiles(self._sketch, [q])[0]
+        return _sketch_quantiles(self._sketch, fractions)
+
+    def distinct(self) -> builtins.float:
+        """Estimate the number of distinct values, not counting NaN."""
+        return _sketch_summary(self._sketch)[4]
+
+    @property
+    def count(self) -> builtins.int:
+        """The number of values added that are not NaN."""
+        return _sketch_summary(self._sketch)[0]
+
+    @property
+    def nan_count(self) -> builtins.int:
+        """The number of values added that are NaN or could not be converted."""
+        return _sketch_summary(self._sketch)[1]
+
+    @property
+    def min(self) -> builtins.float:
+        """The smallest value, or NaN if there are none."""
+        return _sketch_summary(self._sketch)[2]
+
+    @property
+    def max(self) -> builtins.float:
+        """The largest value, or NaN if there are none."""
+        return _sketch_summary(self._sketch)[3]
+
+    def to_bytes(self) -> bytes:
+        """Serialize the sketch, in the same format on all platforms."""
+        return _sketch_dumps(self._sketch)
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> NumericSketch:
+        """
+        Recreate a sketch serialized with :meth:`to_bytes`.
+
+        Raises
+        ------
+        ValueError
+            If the data is not a serialized sketch.
+
+        """
+        sketch = cls.__new__(cls)
+        sketch._sketch = _sketch_loads(data)
+        return sketch
+
+    def __reduce__(self) -> tuple[Any, ...]:
+        return (type(self).from_bytes, (self.to_bytes(),))
+
+    def __repr__(self) -> str:
+        count, nan_count, low, high, _ = _sketch_summary(self._sketch)
+        return (
+            f"{type(self).__name__}(count={count}, nan_count={nan_count}, "
+            f"min={low!r}, max={high!r})"
+        )
+
+
 __all__ = [
     "ALLOWED",
     "DISALLOWED",
@@ -334,26 +1592,37 @@ __all__ = [
     "NUMBER_ONLY",
     "RAISE",
     "STRING_ONLY",
+    "NumericSketch",
     "__version__",
     "check_float",
     "check_int",
     "check_intlike",
     "check_real",
+    "convert_records",
+    "cpu_features",
+    "digitize_numeric",
     "fast_float",
     "fast_forceint",
     "fast_int",
     "fast_real",
+    "factorize_numeric",
     "float",
+    "get_conversion_limits",
     "int",
     "isfloat",
     "isint",
     "isintlike",
     "isreal",
+    "lazy",
     "query_type",
     "real",
+    "set_conversion_limits",
     "try_array",
+    "try_complex",
+    "try_decimal",
     "try_float",
     "try_forceint",
+    "try_fraction",
     "try_int",
     "try_real",
 ]
@@ -1,6 +1,8 @@
 from builtins import float as pyfloat
 from builtins import int as pyint
 from collections.abc import Iterable, Iterator, Sequence
+from decimal import Decimal
+from fractions import Fraction
 from typing import (
     Any,
     Callable,
@@ -24,6 +26,9 @@ class HasInt(Protocol):
 class ItWillFloat(Protocol):
     def __float__(self) -> pyfloat: ...
 
+class ItWillComplex(Protocol):
+    def __complex__(self) -> complex: ...
+
 InputType: TypeAlias = (
     pyint
     | pyfloat
@@ -39,6 +44,11 @@ AnyInputType = TypeVar("AnyInputType")
 QueryInputType = TypeVar("QueryInputType")
 
 NumInputType = TypeVar("NumInputType", pyint, pyfloat, ItWillFloat, HasIndex, HasInt)
+ComplexInputType = TypeVar(
+    "ComplexInputType", complex, pyint, pyfloat, ItWillComplex, ItWillFloat, HasIndex
+)
+FractionInputType = TypeVar("FractionInputType", Fraction, pyint, pyfloat, Decimal)
+DecimalInputType = TypeVar("DecimalInputType", Decimal, pyint, pyfloat, ItWillFloat)
 StrInputType = TypeVar("StrInputType", str, bytes, bytearray | memoryview[pyint])
 IntBaseType = TypeVar("IntBaseType", pyint, HasIndex)
 
@@ -46,6 +56,8 @@ ConsiderType: TypeAlias = STRING_ONLY_T | NUMBER_ONLY_T | None
 InfNanCheckType: TypeAlias = STRING_ONLY_T | NUMBER_ONLY_T | ALLOWED_T | DISALLOWED_T
 TrySelectorsType: TypeAlias = ALLOWED_T | INPUT_T | RAISE_T
 FloatInt: TypeAlias = pyfloat | pyint
+SuffixSet: TypeAlias = Literal["si", "iec", "percent"] | dict[str, pyint | pyfloat]
+SuffixesType: TypeAlias = SuffixSet | list[SuffixSet] | tuple[SuffixSet, ...] | None
 
 # Try real
 @overload
@@ -59,6 +71,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint: ...
 @overload
@@ -72,6 +90,12 @@ def try_real(
     coerce: Literal[False],
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyfloat: ...
 @overload
@@ -85,6 +109,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> FloatInt: ...
 @overload
@@ -104,6 +134,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> FloatInt | StrInputType: ...
 @overload
@@ -117,6 +153,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> FloatInt: ...
 @overload
@@ -130,6 +172,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -143,6 +191,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -156,6 +210,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> FloatInt: ...
 @overload
@@ -169,6 +229,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -182,7 +248,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint]: ...
 @overload
 def try_real(
@@ -195,7 +267,13 @@ def try_real(
     coerce: Literal[False],
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyfloat]: ...
 @overload
 def try_real(
@@ -208,7 +286,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[FloatInt]: ...
 @overload
 def try_real(
@@ -227,7 +311,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[FloatInt | StrInputType]: ...
 @overload
 def try_real(
@@ -240,7 +330,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[FloatInt]: ...
 @overload
 def try_real(
@@ -253,7 +349,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_real(
@@ -266,7 +368,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_real(
@@ -279,7 +387,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[FloatInt]: ...
 @overload
 def try_real(
@@ -292,7 +406,13 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_real(
@@ -305,6 +425,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint]: ...
 @overload
@@ -318,6 +444,12 @@ def try_real(
     coerce: Literal[False],
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyfloat]: ...
 @overload
@@ -331,6 +463,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[FloatInt]: ...
 @overload
@@ -350,6 +488,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[FloatInt | StrInputType]: ...
 @overload
@@ -363,6 +507,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[FloatInt]: ...
 @overload
@@ -376,6 +526,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 @overload
@@ -389,6 +545,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 @overload
@@ -402,6 +564,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[FloatInt]: ...
 @overload
@@ -415,6 +583,12 @@ def try_real(
     coerce: bool = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 
@@ -428,6 +602,13 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyfloat: ...
 @overload
@@ -445,6 +626,13 @@ def try_float(
     on_fail: INPUT_T = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyfloat | StrInputType: ...
 @overload
@@ -456,6 +644,13 @@ def try_float(
     on_fail: RAISE_T | pyfloat | Callable[[StrInputType], pyfloat],
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyfloat: ...
 @overload
@@ -467,6 +662,13 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -478,6 +680,13 @@ def try_float(
     on_fail: Any,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -489,6 +698,13 @@ def try_float(
     on_fail: RAISE_T | pyfloat | Callable[[AnyInputType], pyfloat],
     on_type_error: pyfloat | Callable[[AnyInputType], pyfloat],
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyfloat: ...
 @overload
@@ -500,6 +716,13 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -511,7 +734,14 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyfloat]: ...
 @overload
 def try_float(
@@ -528,7 +758,14 @@ def try_float(
     on_fail: INPUT_T = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyfloat | StrInputType]: ...
 @overload
 def try_float(
@@ -539,7 +776,14 @@ def try_float(
     on_fail: RAISE_T | pyfloat | Callable[[StrInputType], pyfloat],
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyfloat]: ...
 @overload
 def try_float(
@@ -550,7 +794,14 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_float(
@@ -561,7 +812,14 @@ def try_float(
     on_fail: Any,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_float(
@@ -572,7 +830,14 @@ def try_float(
     on_fail: RAISE_T | pyfloat | Callable[[AnyInputType], pyfloat],
     on_type_error: pyfloat | Callable[[AnyInputType], pyfloat],
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyfloat]: ...
 @overload
 def try_float(
@@ -583,7 +848,14 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any,
     allow_underscores: bool = ...,
-    map: type[list],
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_float(
@@ -594,6 +866,13 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyfloat]: ...
 @overload
@@ -611,6 +890,13 @@ def try_float(
     on_fail: INPUT_T = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyfloat | StrInputType]: ...
 @overload
@@ -622,6 +908,13 @@ def try_float(
     on_fail: RAISE_T | pyfloat | Callable[[StrInputType], pyfloat],
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyfloat]: ...
 @overload
@@ -633,6 +926,13 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 @overload
@@ -644,6 +944,13 @@ def try_float(
     on_fail: Any,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 @overload
@@ -655,6 +962,13 @@ def try_float(
     on_fail: RAISE_T | pyfloat | Callable[[AnyInputType], pyfloat],
     on_type_error: pyfloat | Callable[[AnyInputType], pyfloat],
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyfloat]: ...
 @overload
@@ -666,6 +980,13 @@ def try_float(
     on_fail: Any = ...,
     on_type_error: Any,
     allow_underscores: bool = ...,
+    allow_hex_float: bool = ...,
+    allow_fraction: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 
@@ -677,6 +998,11 @@ def try_int(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint: ...
 @overload
@@ -687,6 +1013,11 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint | StrInputType: ...
 @overload
@@ -697,6 +1028,11 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint: ...
 @overload
@@ -707,6 +1043,11 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -717,6 +1058,11 @@ def try_int(
     on_type_error: pyint | Callable[[AnyInputType], pyint],
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint: ...
 @overload
@@ -727,6 +1073,11 @@ def try_int(
     on_type_error: Any,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -736,7 +1087,12 @@ def try_int(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint]: ...
 @overload
 def try_int(
@@ -746,7 +1102,12 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint | StrInputType]: ...
 @overload
 def try_int(
@@ -756,7 +1117,12 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint]: ...
 @overload
 def try_int(
@@ -766,7 +1132,12 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_int(
@@ -776,7 +1147,12 @@ def try_int(
     on_type_error: pyint | Callable[[AnyInputType], pyint],
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint]: ...
 @overload
 def try_int(
@@ -786,7 +1162,12 @@ def try_int(
     on_type_error: Any,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_int(
@@ -795,6 +1176,11 @@ def try_int(
     on_fail: Any = ...,
     on_type_error: Any = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint]: ...
 @overload
@@ -805,6 +1191,11 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint | StrInputType]: ...
 @overload
@@ -815,6 +1206,11 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint]: ...
 @overload
@@ -825,6 +1221,11 @@ def try_int(
     on_type_error: Any = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 @overload
@@ -835,6 +1236,11 @@ def try_int(
     on_type_error: pyint | Callable[[AnyInputType], pyint],
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint]: ...
 @overload
@@ -845,6 +1251,11 @@ def try_int(
     on_type_error: Any,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 
@@ -857,6 +1268,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint: ...
 @overload
@@ -867,6 +1283,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint | StrInputType: ...
 @overload
@@ -877,6 +1298,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint: ...
 @overload
@@ -887,6 +1313,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -897,6 +1328,11 @@ def try_forceint(
     on_type_error: pyint | Callable[[AnyInputType], pyint],
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> pyint: ...
 @overload
@@ -907,6 +1343,11 @@ def try_forceint(
     on_type_error: Any,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[False] = ...,
 ) -> Any: ...
 @overload
@@ -917,7 +1358,12 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint]: ...
 @overload
 def try_forceint(
@@ -927,7 +1373,12 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint | StrInputType]: ...
 @overload
 def try_forceint(
@@ -937,7 +1388,12 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint]: ...
 @overload
 def try_forceint(
@@ -947,7 +1403,12 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_forceint(
@@ -957,7 +1418,12 @@ def try_forceint(
     on_type_error: pyint | Callable[[AnyInputType], pyint],
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[pyint]: ...
 @overload
 def try_forceint(
@@ -967,7 +1433,12 @@ def try_forceint(
     on_type_error: Any,
     denoise: bool = ...,
     allow_underscores: bool = ...,
-    map: type[list],
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
 ) -> list[Any]: ...
 @overload
 def try_forceint(
@@ -977,6 +1448,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint]: ...
 @overload
@@ -987,6 +1463,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint | StrInputType]: ...
 @overload
@@ -997,6 +1478,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint]: ...
 @overload
@@ -1007,6 +1493,11 @@ def try_forceint(
     on_type_error: Any = ...,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 @overload
@@ -1017,6 +1508,11 @@ def try_forceint(
     on_type_error: pyint | Callable[[AnyInputType], pyint],
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
     map: Literal[True],
 ) -> Iterator[pyint]: ...
 @overload
@@ -1027,6 +1523,611 @@ def try_forceint(
     on_type_error: Any,
     denoise: bool = ...,
     allow_underscores: bool = ...,
+    assume_valid: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[True],
+) -> Iterator[Any]: ...
+
+# Try complex
+@overload
+def try_complex(
+    x: ComplexInputType,
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> complex: ...
+@overload
+def try_complex(
+    x: StrInputType,
+    *,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> complex | StrInputType: ...
+@overload
+def try_complex(
+    x: StrInputType,
+    *,
+    on_fail: RAISE_T | complex | Callable[[StrInputType], complex],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> complex: ...
+@overload
+def try_complex(
+    x: StrInputType,
+    *,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Any: ...
+@overload
+def try_complex(
+    x: AnyInputType,
+    *,
+    on_fail: RAISE_T | complex | Callable[[AnyInputType], complex],
+    on_type_error: complex | Callable[[AnyInputType], complex],
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> complex: ...
+@overload
+def try_complex(
+    x: Any,
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Any: ...
+@overload
+def try_complex(
+    x: Iterable[ComplexInputType],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[complex]: ...
+@overload
+def try_complex(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[complex | StrInputType]: ...
+@overload
+def try_complex(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: RAISE_T | complex | Callable[[StrInputType], complex],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[complex]: ...
+@overload
+def try_complex(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Any]: ...
+@overload
+def try_complex(
+    x: Iterable[AnyInputType],
+    *,
+    on_fail: RAISE_T | complex | Callable[[AnyInputType], complex],
+    on_type_error: complex | Callable[[AnyInputType], complex],
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[complex]: ...
+@overload
+def try_complex(
+    x: Iterable[Any],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Any]: ...
+@overload
+def try_complex(
+    x: Iterable[ComplexInputType],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[complex]: ...
+@overload
+def try_complex(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[complex | StrInputType]: ...
+@overload
+def try_complex(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: RAISE_T | complex | Callable[[StrInputType], complex],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[complex]: ...
+@overload
+def try_complex(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[Any]: ...
+@overload
+def try_complex(
+    x: Iterable[AnyInputType],
+    *,
+    on_fail: RAISE_T | complex | Callable[[AnyInputType], complex],
+    on_type_error: complex | Callable[[AnyInputType], complex],
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[complex]: ...
+@overload
+def try_complex(
+    x: Iterable[Any],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[Any]: ...
+
+# Try decimal
+@overload
+def try_decimal(
+    x: DecimalInputType,
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[False] = ...,
+) -> Decimal: ...
+@overload
+def try_decimal(
+    x: StrInputType,
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[False] = ...,
+) -> Decimal | StrInputType: ...
+@overload
+def try_decimal(
+    x: StrInputType,
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: RAISE_T | Decimal | Callable[[StrInputType], Decimal],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[False] = ...,
+) -> Decimal: ...
+@overload
+def try_decimal(
+    x: StrInputType,
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[False] = ...,
+) -> Any: ...
+@overload
+def try_decimal(
+    x: AnyInputType,
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: RAISE_T | Decimal | Callable[[AnyInputType], Decimal],
+    on_type_error: Decimal | Callable[[AnyInputType], Decimal],
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[False] = ...,
+) -> Decimal: ...
+@overload
+def try_decimal(
+    x: Any,
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[False] = ...,
+) -> Any: ...
+@overload
+def try_decimal(
+    x: Iterable[DecimalInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Decimal]: ...
+@overload
+def try_decimal(
+    x: Iterable[StrInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Decimal | StrInputType]: ...
+@overload
+def try_decimal(
+    x: Iterable[StrInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: RAISE_T | Decimal | Callable[[StrInputType], Decimal],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Decimal]: ...
+@overload
+def try_decimal(
+    x: Iterable[StrInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Any]: ...
+@overload
+def try_decimal(
+    x: Iterable[AnyInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: RAISE_T | Decimal | Callable[[AnyInputType], Decimal],
+    on_type_error: Decimal | Callable[[AnyInputType], Decimal],
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Decimal]: ...
+@overload
+def try_decimal(
+    x: Iterable[Any],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Any]: ...
+@overload
+def try_decimal(
+    x: Iterable[DecimalInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[True],
+) -> Iterator[Decimal]: ...
+@overload
+def try_decimal(
+    x: Iterable[StrInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[True],
+) -> Iterator[Decimal | StrInputType]: ...
+@overload
+def try_decimal(
+    x: Iterable[StrInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: RAISE_T | Decimal | Callable[[StrInputType], Decimal],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[True],
+) -> Iterator[Decimal]: ...
+@overload
+def try_decimal(
+    x: Iterable[StrInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[True],
+) -> Iterator[Any]: ...
+@overload
+def try_decimal(
+    x: Iterable[AnyInputType],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: RAISE_T | Decimal | Callable[[AnyInputType], Decimal],
+    on_type_error: Decimal | Callable[[AnyInputType], Decimal],
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[True],
+) -> Iterator[Decimal]: ...
+@overload
+def try_decimal(
+    x: Iterable[Any],
+    *,
+    inf: Any = ...,
+    nan: Any = ...,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
+    map: Literal[True],
+) -> Iterator[Any]: ...
+
+# Try fraction
+@overload
+def try_fraction(
+    x: FractionInputType,
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Fraction: ...
+@overload
+def try_fraction(
+    x: StrInputType,
+    *,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Fraction | StrInputType: ...
+@overload
+def try_fraction(
+    x: StrInputType,
+    *,
+    on_fail: RAISE_T | Fraction | Callable[[StrInputType], Fraction],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Fraction: ...
+@overload
+def try_fraction(
+    x: StrInputType,
+    *,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Any: ...
+@overload
+def try_fraction(
+    x: AnyInputType,
+    *,
+    on_fail: RAISE_T | Fraction | Callable[[AnyInputType], Fraction],
+    on_type_error: Fraction | Callable[[AnyInputType], Fraction],
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Fraction: ...
+@overload
+def try_fraction(
+    x: Any,
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    map: Literal[False] = ...,
+) -> Any: ...
+@overload
+def try_fraction(
+    x: Iterable[FractionInputType],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Fraction]: ...
+@overload
+def try_fraction(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Fraction | StrInputType]: ...
+@overload
+def try_fraction(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: RAISE_T | Fraction | Callable[[StrInputType], Fraction],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Fraction]: ...
+@overload
+def try_fraction(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Any]: ...
+@overload
+def try_fraction(
+    x: Iterable[AnyInputType],
+    *,
+    on_fail: RAISE_T | Fraction | Callable[[AnyInputType], Fraction],
+    on_type_error: Fraction | Callable[[AnyInputType], Fraction],
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Fraction]: ...
+@overload
+def try_fraction(
+    x: Iterable[Any],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
+    map: type[list] | Literal["inplace"],
+) -> list[Any]: ...
+@overload
+def try_fraction(
+    x: Iterable[FractionInputType],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[Fraction]: ...
+@overload
+def try_fraction(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: INPUT_T = ...,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[Fraction | StrInputType]: ...
+@overload
+def try_fraction(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: RAISE_T | Fraction | Callable[[StrInputType], Fraction],
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[Fraction]: ...
+@overload
+def try_fraction(
+    x: Iterable[StrInputType],
+    *,
+    on_fail: Any,
+    on_type_error: Any = ...,
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[Any]: ...
+@overload
+def try_fraction(
+    x: Iterable[AnyInputType],
+    *,
+    on_fail: RAISE_T | Fraction | Callable[[AnyInputType], Fraction],
+    on_type_error: Fraction | Callable[[AnyInputType], Fraction],
+    allow_underscores: bool = ...,
+    map: Literal[True],
+) -> Iterator[Fraction]: ...
+@overload
+def try_fraction(
+    x: Iterable[Any],
+    *,
+    on_fail: Any = ...,
+    on_type_error: Any,
+    allow_underscores: bool = ...,
     map: Literal[True],
 ) -> Iterator[Any]: ...
 
@@ -1493,6 +2594,10 @@ def check_real(
     inf: InfNanCheckType = ...,
     nan: InfNanCheckType = ...,
     allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
 ) -> bool: ...
 def check_float(
     x: Any,
@@ -1502,6 +2607,10 @@ def check_float(
     nan: InfNanCheckType = ...,
     strict: bool = ...,
     allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
 ) -> bool: ...
 def check_int(
     x: Any,
@@ -1509,12 +2618,20 @@ def check_int(
     consider: ConsiderType = ...,
     base: IntBaseType = ...,
     allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
 ) -> bool: ...
 def check_intlike(
     x: Any,
     *,
     consider: ConsiderType = ...,
     allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
 ) -> bool: ...
 
 # Deprecated checking
@@ -1562,6 +2679,10 @@ def query_type(
     allow_nan: bool = ...,
     coerce: bool = ...,
     allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
 ) -> type[QueryInputType | pyint | pyfloat]: ...
 @overload
 def query_type(
@@ -1572,6 +2693,10 @@ def query_type(
     coerce: bool = ...,
     allowed_types: Sequence[type[Any]],
     allow_underscores: bool = ...,
+    decimal_point: str = ...,
+    thousands: str | None = ...,
+    accounting: bool = ...,
+    suffixes: SuffixesType = ...,
 ) -> type[QueryInputType | pyint | pyfloat] | None: ...
 
 # Buitin replacements
@@ -1586,3 +2711,12 @@ def real(x: pyint = ..., *, coerce: bool = ...) -> pyint: ...
 def real(x: pyfloat = ..., *, coerce: Literal[False]) -> pyfloat: ...
 @overload
 def real(x: InputType = ..., *, coerce: bool = ...) -> pyint | pyfloat: ...
+
+# Introspection
+def cpu_features() -> dict[str, str | bool]: ...
+
+# Limits
+def set_conversion_limits(
+    *, max_digits: pyint | None = ..., max_exponent: pyint | None = ...
+) -> None: ...
+def get_conversion_limits() -> dict[str, pyint]: ...
@@ -2,6 +2,14 @@ from __future__ import annotations
 
 import array
 import ctypes
+import io
+import math
+import mmap
+import pickle
+import random
+import re
+import sys
+import warnings
 from typing import TYPE_CHECKING, Any, Callable, NoReturn, TypedDict
 
 import numpy as np
@@ -19,6 +27,7 @@ from hypothesis.strategies import (
 import fastnumbers
 
 if TYPE_CHECKING:
+    import pathlib
     from collections.abc import Iterator
 
 # Map supported data types to the Python array internal format designator
@@ -140,8 +149,8 @@ def test_selectors_are_rejected_when_invalid_for_on_fail_and_friends(
 def test_invalid_input_type_gives_type_error() -> None:
     """Giving an invalid output type is rejected"""
     given = [0, 1]
-    expected = "Only numpy ndarray and array.array types for output are "
-    expected += r"supported, not <class 'list'>"
+    expected = "Only numpy ndarray, array.array, and other buffer types for output "
+    expected += r"are supported, not <class 'list'>"
     with pytest.raises(TypeError, match=expected):
         fastnumbers.try_array(given, [])  # type: ignore[call-overload]
 
@@ -179,7 +188,7 @@ def test_require_input_and_output_to_have_equal_size() -> None:
 # here that exist.
 other_dtypes = [
     getattr(np, x)
-    for x in ("float128", "complex128", "half", "bool_", "bytes_", "str_")
+    for x in ("float128", "complex256", "half", "bool_", "bytes_", "str_")
     if hasattr(np, x)
 ]
 
@@ -494,6 +503,232 @@ class TestErrors:
 class TestSuccess:
     """Test that the function does what it says on the tin"""
 
+    def test_formatted_numbers_are_parsed(self) -> None:
+        given = ["1.234,5", "(2.000)", "3", "1.23.4", "12,34,5"]
+        result = array.array("d", [0.0] * len(given))
+        fastnumbers.try_array(
+            given,
+            result,
+            decimal_point=",",
+            thousands=".",
+            accounting=True,
+            on_fail=-1.0,
+        )
+        assert list(result) == [1234.5, -2000.0, 3.0, -1.0, -1.0]
+
+        iresult = array.array("q", [0] * 3)
+        fastnumbers.try_array(
+            ["1,000", b"(12,345)", "12,34"],
+            iresult,
+            thousands=",",
+            accounting=True,
+            on_fail=-1,
+        )
+        assert list(iresult) == [1000, -12345, -1]
+
+    def test_suffixed_numbers_are_scaled(self) -> None:
+        given = ["1k", "5%", "1.5Gi", "2x"]
+        suffixes = ["si", "percent", "iec", {"x": 3}]
+        result = array.array("d", [0.0] * len(given))
+        fastnumbers.try_array(given, result, suffixes=suffixes)
+        assert list(result) == [1000.0, 0.05, 1610612736.0, 6.0]
+
+        iresult = array.array("q", [0] * len(given))
+        fastnumbers.try_array(given, iresult, suffixes=suffixes, on_fail=-1)
+        assert list(iresult) == [1000, -1, 1610612736, 6]
+
+    @pytest.mark.parametrize("data_type", ["float", "double"])
+    def test_hex_floats_are_exact(self, data_type: str) -> None:
+        given = ["0x1.8p3", "-0x1.000001p0", "0x1p-149", "0x1p1024", "0x1.8p3 lb"]
+        x = array.array(formats[data_type], [0] * len(given))
+        fastnumbers.try_array(
+            given, x, allow_hex_float=True, on_overflow=-1.0, on_fail=-2.0
+        )
+        # The float tie rounds to even directly, not via double
+        tie = -1.0 if data_type == "float" else -float.fromhex("0x1.000001p0")
+        expected = [12.0, tie, 2.0**-149, -1.0, -2.0]
+        assert list(x) == expected
+
+    @pytest.mark.parametrize("data_type", ["float", "double"])
+    def test_fractions_are_correctly_rounded(self, data_type: str) -> None:
+        given = ["3/4", "-1 1/2", "1/3", "16777217/1", "1/0", "1" + "0" * 400 + "/1"]
+        x = array.array(formats[data_type], [0] * len(given))
+        fastnumbers.try_array(
+            given, x, allow_fraction=True, on_overflow=-1.0, on_fail=-2.0
+        )
+        # The float tie rounds to even directly, not via double
+        tie = 16777216.0 if data_type == "float" else 16777217.0
+        third = array.array(formats[data_type], [1 / 3])[0]
+        assert list(x) == [0.75, -1.5, third, tie, -2.0, -1.0]
+
+    def test_large_fractions_are_not_rounded_twice_for_float(self) -> None:
+        # Too large for the fast path, and the double quotient is exactly
+        # halfway between two floats though the exact quotient is not.
+        given = ["84745172 6/27507313452997646", "-84745172 6/27507313452997646"]
+        result = fastnumbers.try_array(given, allow_fraction=True, dtype=np.float32)
+        assert result.tolist() == [84745176.0, -84745176.0]
+
+    @pytest.mark.parametrize("data_type", float_data_types)
+    @pytest.mark.parametrize("decimals", [0, 2, 7])
+    @pytest.mark.parametrize(
+        "odd", ["1e5", " 3.5", "1_0", "nan", "-", "12345678901234567.5", "9" * 400]
+    )
+    def test_homogeneous_float_column_matches_general_parser(
+        self, data_type: str, decimals: int, odd: str
+    ) -> None:
+        # The first strings share a shape so a specialized kernel is used,
+        # then an odd string must make it fall back to the general parser.
+        rng = random.Random(decimals)
+        given = [f"{rng.uniform(-1e5, 1e5):.{decimals}f}" for _ in range(40)]
+        given[30] = odd
+        given.append(str(rng.randint(0, 100)))
+        result = array.array(formats[data_type], [0.0] * len(given))
+        fastnumbers.try_array(given, result, on_fail=-1.0, on_overflow=-2.0)
+        expected = array.array(
+            formats[data_type], fastnumbers.try_float(given, on_fail=-1.0, map=list)
+        )
+        assert [str(x) for x in result] == [str(x) for x in expected]
+
+    @pytest.mark.parametrize("data_type", int_data_types)
+    def test_homogeneous_int_column_matches_general_parser(
+        self, data_type: str
+    ) -> None:
+        low, high = extremes[data_type]
+        rng = random.Random(0)
+        given = [str(rng.randint(max(low, -100), 100)) for _ in range(40)]
+        given += [str(high), str(high + 1), str(low), str(low - 1), "5.0", "7"]
+        if low < 0:
+            given.append("-0")
+        result = array.array(formats[data_type], [0] * len(given))
+        fastnumbers.try_array(given, result, on_fail=1, on_overflow=2)
+        expected = fastnumbers.try_int(given, on_fail=1, map=list)
+        expected = [2 if x < low or x > high else x for x in expected]
+        assert list(result) == expected
+
+    @pytest.mark.parametrize("data_type", data_types)
+    @pytest.mark.parametrize("first", ["1", b"1", 1, 1.0, "\u0661", bytearray(b"1")])
+    def test_types_differing_from_the_first_are_converted(
+        self, data_type: str, first: Any
+    ) -> None:
+        # The type of the first element is speculated on for later elements.
+        if isinstance(first, float) and data_type in int_data_types:
+            first = 1
+        given = [first, "2", b"3", 4, "5", "\u0666", bytearray(b"7"), True, first]
+        result = array.array(formats[data_type], [0] * len(given))
+        fastnumbers.try_array(given, result)
+        assert list(result) == [1, 2, 3, 4, 5, 6, 7, 1, 1]
+
+    @pytest.mark.parametrize("data_type", data_types)
+    def test_assume_valid_gives_same_results_for_valid_strings(
+        self, data_type: str
+    ) -> None:
+        given = ["0", "12", "-7", "+5", "99", "007"]
+        if data_type in unsigned_data_types:
+            given = [x for x in given if not x.startswith("-")]
+        expected = array.array(formats[data_type], [0] * len(given))
+        result = array.array(formats[data_type], [0] * len(given))
+        fastnumbers.try_array(given, expected)
+        fastnumbers.try_array(given, result, assume_valid=True)
+        assert result == expected
+
+    @pytest.mark.parametrize("data_type", int_data_types)
+    def test_assume_valid_still_detects_overflow(self, data_type: str) -> None:
+        low, high = extremes[data_type]
+        given = [str(low - 1), str(high + 1), "1" + "0" * 30]
+        result = array.array(formats[data_type], [0] * len(given))
+        fastnumbers.try_array(given, result, on_overflow=3, assume_valid=True)
+        assert list(result) == [3, 3, 3]
+
+    @pytest.mark.parametrize("data_type", float_data_types)
+    @pytest.mark.parametrize("style", [list, tuple, iter])
+    def test_replacement_callables_are_given_the_matching_input(
+        self, data_type: str, style: Callable[[Any], Any]
+    ) -> None:
+        # Whenever replacements are made, they must see the right input.
+        given = ["1", "nan", "-inf", "bad", "5", "inf", "bad2", "-nan"]
+        result = array.array(formats[data_type], [0.0] * len(given))
+        fastnumbers.try_array(
+            style(given),
+            result,
+            nan=lambda x: 10.0 + len(x),
+            inf=lambda x: 20.0 + len(x),
+            on_fail=lambda x: 30.0 + len(x),
+        )
+        assert list(result) == [1.0, 13.0, 24.0, 33.0, 5.0, 23.0, 34.0, 14.0]
+
+    @pytest.mark.parametrize("data_type", float_data_types)
+    def test_replacement_callables_are_given_the_input_of_a_labelled_sequence(
+        self, data_type: str
+    ) -> None:
+        # Like a pandas Series, this sequence is indexed by label, not position.
+        class Labelled:
+            def __init__(self, data: list[str]) -> None:
+                self.data = {str(i): x for i, x in enumerate(data)}
+
+            def __len__(self) -> int:
+                return len(self.data)
+
+            def __getitem__(self, key: str) -> str:
+                return self.data[key]
+
+            def __iter__(self) -> Iterator[str]:
+                return iter(self.data.values())
+
+        given = Labelled(["1", "nan", "-inf", "bad", "5"])
+        result = array.array(formats[data_type], [0.0] * 5)
+        fastnumbers.try_array(
+            given,
+            result,
+            nan=lambda x: 10.0 + len(x),
+            inf=lambda x: 20.0 + len(x),
+            on_fail=lambda x: 30.0 + len(x),
+        )
+        assert list(result) == [1.0, 13.0, 24.0, 33.0, 5.0]
+
+    @pytest.mark.parametrize("style", [list, tuple, iter])
+    def test_replacement_callables_are_called_in_element_order(
+        self, style: Callable[[Any], Any]
+    ) -> None:
+        calls = []
+
+        def record(x: str) -> float:
+            calls.append(x)
+            return 0.0
+
+        given = ["bad", "nan", "1", "inf", "bad2", "-nan"]
+        result = array.array("d", [1.0] * len(given))
+        fastnumbers.try_array(
+            style(given), result, nan=record, inf=record, on_fail=record
+        )
+        assert calls == ["bad", "nan", "inf", "bad2", "-nan"]
+
+        # The first element to raise is the one whose error is seen.
+        def fail(x: str) -> NoReturn:
+            raise ZeroDivisionError(x)
+
+        with pytest.raises(ZeroDivisionError, match="nan"):
+            fastnumbers.try_array(
+                style(["nan", "x"]), nan=fail, on_fail=fastnumbers.RAISE
+            )
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.try_array(
+                style(["x", "nan"]), nan=fail, on_fail=fastnumbers.RAISE
+            )
+
+    @pytest.mark.parametrize("data_type", float_data_types)
+    def test_nan_replacement_is_not_applied_to_other_replacements(
+        self, data_type: str
+    ) -> None:
+        given = ["nan", "bad", "inf", "bad"]
+        result = array.array(formats[data_type], [0.0] * len(given))
+        fastnumbers.try_array(
+            given, result, nan=1.0, inf=2.0, on_fail=lambda _: float("nan")
+        )
+        assert result[0] == 1.0
+        assert math.isnan(result[1])
+        assert result[2] == 2.0
+        assert math.isnan(result[3])
+
     @pytest.mark.parametrize("data_type", data_types)
     @pytest.mark.parametrize("style", [list, tuple, iter])
     def test_given_valid_values_returns_correct_results(
@@ -688,6 +923,20 @@ class TestNumpy:
         assert result.dtype == dtype
         assert np.array_equal(result, expected)
 
+    @pytest.mark.parametrize("dtype", [np.complex64, np.complex128])
+    def test_complex_dtypes(self, dtype: np.dtype[np.complex128]) -> None:
+        given = [4, 4.5, "5", "1+2j", "(-3.5J)", 6 - 7j, "junk", "nanj", "-inf"]
+        expected = np.array(
+            [4, 4.5, 5, 1 + 2j, -3.5j, 6 - 7j, 8j, 9, 10], dtype=dtype
+        )
+        result = fastnumbers.try_array(
+            given, dtype=dtype, on_fail=8j, nan=9, inf=lambda x: 10
+        )
+        assert result.dtype == dtype
+        assert np.array_equal(result, expected)
+        with pytest.raises(ValueError, match="Cannot convert 'junk' to C type"):
+            fastnumbers.try_array(given, dtype=dtype)
+
     @pytest.mark.parametrize("dtype", int_dtypes)
     def test_integer_extremes(self, dtype: np.dtype[np.int_]) -> None:
         given = [
@@ -782,6 +1031,13 @@ class TestNumpy:
         fastnumbers.try_array(given, result[::-2])
         assert np.array_equal(result, expected)
 
+    def test_replacements_with_strides(self) -> None:
+        given = ["nan", "bad", "2", "inf"]
+        result = np.zeros(8)
+        expected = np.array([0.0, 7.0, 0.0, 2.0, 0.0, 5.0, 0.0, 8.0])
+        fastnumbers.try_array(given, result[::-2], nan=8.0, inf=7.0, on_fail=5.0)
+        assert np.array_equal(result, expected)
+
     def test_slice_2d(self) -> None:
         given = [4, "5", "⑦"]
         result = np.array([[0, 0, 0], [0, 0, 0], [0, 0, 0]])
@@ -817,6 +1073,916 @@ class TestNumpy:
         assert np.array_equal(result, expected)
 
 
+class TestFile:
+    """Tests for writing the output to a file in chunks"""
+
+    @pytest.mark.parametrize("dtype", [np.int8, np.uint32, np.float64, np.complex64])
+    @pytest.mark.parametrize("style", [list, iter])
+    def test_npy_file_can_be_loaded(
+        self, tmp_path: pathlib.Path, dtype: Any, style: Callable[[Any], Any]
+    ) -> None:
+        given = [str(i % 100) for i in range(1000)]
+        path = tmp_path / "out.npy"
+        fastnumbers.try_array(style(given), path, dtype=dtype, chunk_size=64)
+        result = np.load(path, mmap_mode="r")
+        assert result.dtype == dtype
+        assert np.array_equal(result, np.array([i % 100 for i in range(1000)]))
+
+    def test_raw_file_contains_only_the_values(self, tmp_path: pathlib.Path) -> None:
+        path = tmp_path / "out.bin"
+        fastnumbers.try_array(["1.5", "-2", "3e2"], str(path), file_format="raw")
+        assert np.array_equal(np.fromfile(path), np.array([1.5, -2.0, 300.0]))
+
+    def test_file_object_is_written_at_its_position(self) -> None:
+        sink = io.BytesIO()
+        sink.write(b"prefix")
+        fastnumbers.try_array(iter(["5", "6"]), sink, dtype=np.int16)
+        assert sink.tell() == len(sink.getvalue())
+        data = io.BytesIO(sink.getvalue()[len("prefix") :])
+        assert np.array_equal(np.load(data), np.array([5, 6], dtype=np.int16))
+
+    def test_empty_input(self, tmp_path: pathlib.Path) -> None:
+        path = tmp_path / "out.npy"
+        fastnumbers.try_array(iter([]), path)
+        assert np.load(path).shape == (0,)
+
+    def test_options_are_used(self, tmp_path: pathlib.Path) -> None:
+        path = tmp_path / "out.npy"
+        given = ["1", "x", "nan", "4"] * 10
+        fastnumbers.try_array(given, path, on_fail=-1.0, nan=-2.0, chunk_size=3)
+        assert list(np.load(path)) == [1.0, -1.0, -2.0, 4.0] * 10
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.try_array(given, path)
+
+    def test_unknown_length_needs_seekable_file(self) -> None:
+        class Unseekable(io.BytesIO):
+            def seekable(self) -> bool:
+                return False
+
+        with pytest.raises(ValueError, match="must be seekable"):
+            fastnumbers.try_array(iter(["1"]), Unseekable())
+        sink = Unseekable()
+        fastnumbers.try_array(["1"], sink)
+        assert np.load(io.BytesIO(sink.getvalue())).tolist() == [1.0]
+
+    def test_buffer_with_a_write_method_is_filled_in_place(self) -> None:
+        output = mmap.mmap(-1, 4)
+        assert fastnumbers.try_array(["1", "2", "3", "4"], output) is None
+        assert list(output[:]) == [1, 2, 3, 4]
+
+    def test_input_of_the_wrong_length_raises(self) -> None:
+        class Misleading(list):  # type: ignore[type-arg]
+            def __len__(self) -> int:
+                return 5
+
+        with pytest.raises(ValueError, match="length of 5 but 3 elements"):
+            fastnumbers.try_array(Misleading(["1", "2", "3"]), io.BytesIO())
+
+    def test_invalid_options_raise(self, tmp_path: pathlib.Path) -> None:
+        path = tmp_path / "out.npy"
+        with pytest.raises(ValueError, match="file_format must be"):
+            fastnumbers.try_array(["1"], path, file_format="csv")  # type: ignore
+        with pytest.raises(ValueError, match="chunk_size must be"):
+            fastnumbers.try_array(["1"], path, chunk_size=0)
+        with pytest.raises(TypeError, match="not float16"):
+            fastnumbers.try_array(["1"], path, dtype=np.float16)  # type: ignore
+
+
+class TestConsume:
+    """Tests for releasing the input as it is converted with consume=True"""
+
+    def test_input_is_emptied(self) -> None:
+        given = ["1", "2.5", "x", "nan"]
+        result = fastnumbers.try_array(given, on_fail=-1.0, nan=-2.0, consume=True)
+        assert result.tolist() == [1.0, 2.5, -1.0, -2.0]
+        assert given == []
+
+    def test_replacement_callables_get_the_input(self) -> None:
+        given = ["1", "x", "inf", "4"]
+        output = np.empty(4)
+        fastnumbers.try_array(given, output, on_fail=len, inf=len, consume=True)
+        assert output.tolist() == [1.0, 1.0, 3.0, 4.0]
+        assert given == []
+
+    def test_elements_are_released_as_converted(self) -> None:
+        released = []
+
+        class Number:
+            def __init__(self, value: int) -> None:
+                self.value = value
+
+            def __float__(self) -> float:
+                return float(self.value)
+
+            def __del__(self) -> None:
+                released.append((self.value, len(seen)))
+
+        seen: list[int] = []
+
+        def record(x: Any) -> int:
+            seen.append(1)
+            return 0
+
+        given: list[Any] = [Number(1), "x", Number(3), "y"]
+        output = np.empty(4)
+        fastnumbers.try_array(given, output, on_fail=record, consume=True)
+        assert output.tolist() == [1.0, 0.0, 3.0, 0.0]
+        # Each number was released once converted, before the replacement of
+        # the next element was made, and not at the end.
+        assert sorted(released) == [(1, 0), (3, 1)]
+
+    def test_elements_after_an_error_are_kept(self) -> None:
+        given = ["1", "x", "3"]
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.try_array(given, consume=True)
+        assert given == [None, "x", "3"]
+
+    def test_file_output(self, tmp_path: pathlib.Path) -> None:
+        given = [str(i) for i in range(10)]
+        path = tmp_path / "out.npy"
+        fastnumbers.try_array(given, path, chunk_size=3, consume=True)
+        assert np.load(path).tolist() == list(range(10))
+        assert given == []
+
+    def test_cached_input(self, tmp_path: pathlib.Path) -> None:
+        for _ in range(2):
+            given = ["1", "2"]
+            result = fastnumbers.try_array(given, cache_dir=tmp_path, consume=True)
+            assert result.tolist() == [1.0, 2.0]
+            assert given == []
+
+    @pytest.mark.parametrize("given", [("1", "2"), iter(["1", "2"])])
+    def test_input_must_be_a_list(self, given: Any) -> None:
+        with pytest.raises(TypeError, match="requires the input to be a list"):
+            fastnumbers.try_array(given, consume=True)
+
+
+class TestObjectDtype:
+    """Tests for populating an array of dtype object"""
+
+    def test_results_are_as_try_real(self) -> None:
+        given = ["1", "2.5", 3, "1e400", "123456789012345678901234567890", "4.0"]
+        result = fastnumbers.try_array(given, dtype=object)
+        assert result.dtype == np.dtype(object)
+        expected = fastnumbers.try_real(given, map=list)
+        assert result.tolist() == expected
+        assert [type(x) for x in result] == [type(x) for x in expected]
+
+    def test_options_are_passed_on(self) -> None:
+        given = ["1", "x", "inf", None, "1_000", "3.0"]
+        result = fastnumbers.try_array(
+            given,
+            dtype=object,
+            on_fail=len,
+            inf=-1,
+            on_type_error=0,
+            allow_underscores=True,
+            coerce=False,
+        )
+        assert result.tolist() == [1, 1, -1, 0, 1000, 3.0]
+        assert type(result[5]) is float
+
+    def test_failure_raises_by_default(self) -> None:
+        with pytest.raises(ValueError, match="convert string to float: 'x'"):
+            fastnumbers.try_array(["1", "x"], dtype=object)
+
+    def test_strided_output(self) -> None:
+        output = np.full(6, None, dtype=object)
+        fastnumbers.try_array(["1", "2.5", "3"], output[::-2])
+        assert output.tolist() == [None, 3, None, 2.5, None, 1]
+
+    def test_existing_values_are_released(self) -> None:
+        marker = object()
+        output = np.array([marker, marker], dtype=object)
+        fastnumbers.try_array(["1", "2"], output)
+        assert output.tolist() == [1, 2]
+        assert sys.getrefcount(marker) == 2
+
+    def test_iterator_input(self) -> None:
+        result = fastnumbers.try_array(iter(["1", "2.5"]), dtype=object)
+        assert result.tolist() == [1, 2.5]
+
+    def test_consume(self) -> None:
+        given = ["1", "2.5"]
+        result = fastnumbers.try_array(given, dtype=object, consume=True)
+        assert result.tolist() == [1, 2.5]
+        assert given == []
+
+    def test_size_mismatch(self) -> None:
+        with pytest.raises(ValueError, match="input/output must be of equal size"):
+            fastnumbers.try_array(["1", "2"], np.empty(3, dtype=object))
+
+    def test_read_only_output(self) -> None:
+        output = np.empty(2, dtype=object)
+        output.flags.writeable = False
+        with pytest.raises(ValueError, match="output array is read-only"):
+            fastnumbers.try_array(["1", "2"], output)
+
+    def test_cache_is_bypassed(self, tmp_path: pathlib.Path) -> None:
+        result = fastnumbers.try_array(["1", "2.5"], dtype=object, cache_dir=tmp_path)
+        assert result.tolist() == [1, 2.5]
+        assert list(tmp_path.iterdir()) == []
+
+    def test_file_output_is_rejected(self) -> None:
+        with pytest.raises(TypeError, match="The only supported numpy dtypes"):
+            fastnumbers.try_array(["1"], io.BytesIO(), dtype=object)
+
+    def test_multidimensional_output_is_rejected(self) -> None:
+        with pytest.raises(TypeError, match="one-dimensional array of dtype object"):
+            fastnumbers.try_array(["1", "2"], np.empty((1, 2), dtype=object))
+
+
+class FakeCategorical:
+    """The parts of a pandas.Categorical that try_array uses"""
+
+    def __init__(self, categories: list[Any], codes: list[int]) -> None:
+        self.categories = np.array(categories, dtype=object)
+        self.codes = np.array(codes, dtype=np.int8)
+
+    def __len__(self) -> int:
+        return len(self.codes)
+
+    def __iter__(self) -> Iterator[Any]:
+        return (self.categories[i] if i >= 0 else math.nan for i in self.codes)
+
+
+class FakeArrowArray:
+    """The parts of a pyarrow.Array that try_array uses"""
+
+    def __init__(self, values: list[Any]) -> None:
+        self.values = values
+        self.null_count = values.count(None)
+
+    def to_pylist(self) -> list[Any]:
+        return list(self.values)
+
+    def fill_null(self, value: Any) -> FakeArrowArray:
+        return FakeArrowArray([value if x is None else x for x in self.values])
+
+    def to_numpy(self) -> np.ndarray[Any, Any]:
+        assert self.null_count == 0
+        return np.array(self.values, dtype=np.int32)
+
+
+class FakeDictionaryArray:
+    """The parts of a pyarrow.DictionaryArray that try_array uses"""
+
+    def __init__(self, dictionary: list[Any], indices: list[int | None]) -> None:
+        self.dictionary = FakeArrowArray(dictionary)
+        self.indices = FakeArrowArray(indices)
+
+    def __len__(self) -> int:
+        return len(self.indices.values)
+
+    def __iter__(self) -> Iterator[Any]:
+        values = self.dictionary.values
+        return (None if i is None else values[i] for i in self.indices.values)
+
+
+class FakeChunkedArray:
+    """The parts of a pyarrow.ChunkedArray that try_array uses"""
+
+    def __init__(self, chunks: list[Any]) -> None:
+        self.chunks = chunks
+
+    def __len__(self) -> int:
+        return sum(len(chunk) for chunk in self.chunks)
+
+    def __iter__(self) -> Iterator[Any]:
+        return (x for chunk in self.chunks for x in chunk)
+
+
+class TestDictionaryEncoded:
+    """Tests for converting only the distinct values of encoded inputs"""
+
+    def test_categorical(self) -> None:
+        given = FakeCategorical(["1.5", "2", "x"], [0, 1, 1, 0, 2])
+        result = fastnumbers.try_array(given, on_fail=-1.0)
+        assert result.tolist() == [1.5, 2.0, 2.0, 1.5, -1.0]
+
+    def test_dictionary_array(self) -> None:
+        given = FakeDictionaryArray(["10", "20"], [1, 1, 0])
+        result = fastnumbers.try_array(given, dtype=np.int16)
+        assert result.dtype == np.int16
+        assert result.tolist() == [20, 20, 10]
+
+    def test_chunked_array(self) -> None:
+        given = FakeChunkedArray(
+            [FakeDictionaryArray(["1", "2"], [0, 1]), FakeDictionaryArray(["3"], [0])]
+        )
+        assert fastnumbers.try_array(given).tolist() == [1.0, 2.0, 3.0]
+
+    @pytest.mark.parametrize("dtype", [np.float64, np.int64])
+    @pytest.mark.parametrize("options", [{}, {"nan": 0}, {"on_fail": -1}])
+    def test_missing_values_match_dense_iteration(
+        self, dtype: Any, options: dict[str, Any]
+    ) -> None:
+        given = FakeCategorical(["1", "2"], [1, -1, 0])
+        try:
+            expected = fastnumbers.try_array(list(given), dtype=dtype, **options)
+        except ValueError as exc:
+            with pytest.raises(type(exc), match=re.escape(str(exc))):
+                fastnumbers.try_array(given, dtype=dtype, **options)
+        else:
+            result = fastnumbers.try_array(given, dtype=dtype, **options)
+            np.testing.assert_array_equal(result, expected)
+
+    def test_missing_values_of_a_dictionary_array_are_nan(self) -> None:
+        given = FakeDictionaryArray(["1", "2"], [1, None, 0])
+        result = fastnumbers.try_array(given, nan=-1.0)
+        assert result.tolist() == [2.0, -1.0, 1.0]
+
+    def test_callables_are_called_once_per_distinct_value(self) -> None:
+        calls = []
+
+        def on_fail(x: Any) -> float:
+            calls.append(x)
+            return -1.0
+
+        given = FakeCategorical(["1", "x"], [1, 0, 1, 1])
+        result = fastnumbers.try_array(given, on_fail=on_fail)
+        assert result.tolist() == [-1.0, 1.0, -1.0, -1.0]
+        assert calls == ["x"]
+
+    def test_unused_values_cannot_cause_errors(self) -> None:
+        given = FakeCategorical(["1", "x", "3"], [2, 0, 2])
+        assert fastnumbers.try_array(given).tolist() == [3.0, 1.0, 3.0]
+
+    def test_error_names_the_first_used_value(self) -> None:
+        given = FakeCategorical(["x", "1", "y"], [1, 2, 0])
+        with pytest.raises(ValueError, match="Cannot convert 'y'"):
+            fastnumbers.try_array(given)
+
+    def test_given_outputs(self) -> None:
+        given = FakeDictionaryArray(["1", "2"], [0, 1, 1])
+        output = np.zeros(6, dtype=np.int32)
+        fastnumbers.try_array(given, output[::-2])
+        assert output.tolist() == [0, 2, 0, 2, 0, 1]
+        typed = array.array("d", [0.0] * 3)
+        fastnumbers.try_array(given, typed)
+        assert typed.tolist() == [1.0, 2.0, 2.0]
+
+    @pytest.mark.parametrize("typecode", ["q", "l", "i", "f"])
+    def test_array_outputs_match_dense_iteration(self, typecode: str) -> None:
+        given = FakeDictionaryArray(["1", "x", "3"], [2, 0, 2])
+        result = array.array(typecode, [0] * 3)
+        fastnumbers.try_array(given, result, on_fail=-1)
+        expected = array.array(typecode, [0] * 3)
+        fastnumbers.try_array(list(given), expected, on_fail=-1)
+        assert result == expected
+        assert result.tolist() == [3, 1, 3]
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.try_array(FakeDictionaryArray(["x"], [0]), result[:1])
+
+    def test_object_dtype(self) -> None:
+        given = FakeCategorical(["1", "2.5"], [1, 0])
+        result = fastnumbers.try_array(given, dtype=object)
+        assert result.tolist() == [2.5, 1]
+        assert type(result[1]) is int
+
+    def test_size_mismatch(self) -> None:
+        given = FakeCategorical(["1"], [0, 0])
+        with pytest.raises(ValueError, match="input/output must be of equal size"):
+            fastnumbers.try_array(given, np.empty(3))
+
+    def test_empty(self) -> None:
+        assert fastnumbers.try_array(FakeCategorical([], [])).tolist() == []
+
+    def test_pandas(self) -> None:
+        pd = pytest.importorskip("pandas")
+        given = pd.Series(["1", "2", None, "1"], dtype="category")
+        result = fastnumbers.try_array(given, on_type_error=0.0)
+        assert result.tolist() == [1.0, 2.0, 0.0, 1.0]
+
+    def test_pyarrow(self) -> None:
+        pa = pytest.importorskip("pyarrow")
+        given = pa.array(["1", "2", None, "1"]).dictionary_encode()
+        result = fastnumbers.try_array(given, on_type_error=0.0)
+        assert result.tolist() == [1.0, 2.0, 0.0, 1.0]
+
+
+class TestFactorizeNumeric:
+    """Tests for numbering the distinct values while converting"""
+
+    def test_first_appearance_order(self) -> None:
+        values, codes = fastnumbers.factorize_numeric(["3", "1", "3.0", 2, "1"])
+        assert values.dtype == np.float64
+        assert codes.dtype == np.intp
+        assert values.tolist() == [3.0, 1.0, 2.0]
+        assert codes.tolist() == [0, 1, 0, 2, 1]
+
+    def test_sorted_order(self) -> None:
+        values, codes = fastnumbers.factorize_numeric(
+            ["3", "1", "3", "2"], np.int16, sort=True, codes_dtype=np.int32
+        )
+        assert values.dtype == np.int16
+        assert codes.dtype == np.int32
+        assert values.tolist() == [1, 2, 3]
+        assert codes.tolist() == [2, 0, 2, 1]
+
+    def test_nan_and_signed_zero_are_one_value(self) -> None:
+        values, codes = fastnumbers.factorize_numeric(
+            ["nan", "-0.0", "0", float("nan"), "-nan"]
+        )
+        assert len(values) == 2
+        assert math.isnan(values[0])
+        assert values[1] == 0.0
+        assert codes.tolist() == [0, 1, 1, 0, 0]
+
+    def test_complex(self) -> None:
+        values, codes = fastnumbers.factorize_numeric(
+            ["1+2j", "nan", "(1+2j)", "nan+1j"], np.complex128
+        )
+        assert values[0] == 1 + 2j
+        assert codes.tolist() == [0, 1, 0, 1]
+
+    def test_replacements_are_made_before_numbering(self) -> None:
+        calls = []
+
+        def on_fail(x: Any) -> int:
+            calls.append(x)
+            return len(x)
+
+        values, codes = fastnumbers.factorize_numeric(
+            ["1", "xx", "300", "inf", None, "2"],
+            np.uint8,
+            on_fail=on_fail,
+            on_overflow=1,
+            on_type_error=0,
+        )
+        assert values.tolist() == [1, 2, 3, 0]
+        assert codes.tolist() == [0, 1, 0, 2, 3, 1]
+        assert calls == ["xx", "inf"]
+
+    def test_nan_and_inf_replacements(self) -> None:
+        values, codes = fastnumbers.factorize_numeric(
+            ["inf", "1", "nan", "-inf"], nan=1.0, inf=lambda x: -5.0
+        )
+        assert values.tolist() == [-5.0, 1.0]
+        assert codes.tolist() == [0, 1, 1, 0]
+
+    def test_errors_are_as_try_array(self) -> None:
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.factorize_numeric(["1", "x"])
+        with pytest.raises(OverflowError):
+            fastnumbers.factorize_numeric(["1", "300"], np.uint8)
+        with pytest.raises(TypeError, match="The value None has type"):
+            fastnumbers.factorize_numeric(["1", None])
+
+    def test_iterator_input(self) -> None:
+        values, codes = fastnumbers.factorize_numeric(iter(["5", "5", "6"]), int)
+        assert values.tolist() == [5, 6]
+        assert codes.tolist() == [0, 0, 1]
+
+    def test_empty(self) -> None:
+        values, codes = fastnumbers.factorize_numeric([])
+        assert values.tolist() == []
+        assert codes.tolist() == []
+
+    @pytest.mark.parametrize("distinct", [10, 5000, 100000])
+    @pytest.mark.parametrize("sort", [False, True])
+    def test_matches_numpy(self, distinct: int, sort: bool) -> None:
+        # Many distinct values make the implementation sort instead of hash.
+        rng = random.Random(distinct)
+        given = [str(rng.randrange(distinct) / 4) for _ in range(50000)]
+        values, codes = fastnumbers.factorize_numeric(given, sort=sort)
+        expected = fastnumbers.try_array(given)
+        assert np.array_equal(values[codes], expected)
+        if sort:
+            assert np.array_equal(values, np.unique(expected))
+        else:
+            assert values.tolist() == list(dict.fromkeys(expected.tolist()))
+
+    def test_invalid_dtypes(self) -> None:
+        with pytest.raises(TypeError, match="The only supported numpy dtypes"):
+            fastnumbers.factorize_numeric(["1"], np.float16)
+        with pytest.raises(TypeError, match="codes_dtype must be int32 or int64"):
+            fastnumbers.factorize_numeric(["1"], codes_dtype=np.int16)
+
+
+class TestDigitizeNumeric:
+    """Tests for locating values among bin edges while converting"""
+
+    @pytest.mark.parametrize("size", [0, 1, 3, 16, 17, 1000])
+    @pytest.mark.parametrize("right", [False, True])
+    def test_matches_numpy(self, size: int, right: bool) -> None:
+        # Few edges are compared all at once, and more are searched.
+        rng = random.Random(size)
+        edges = sorted(rng.uniform(-5, 5) for _ in range(size))
+        if size > 2:
+            edges[1] = edges[2]
+        values = [rng.uniform(-6, 6) for _ in range(2000)] + edges
+        given = [repr(x) for x in values]
+        result = fastnumbers.digitize_numeric(given, edges, right=right)
+        assert result.dtype == (np.uint8 if size < 255 else np.uint16)
+        expected = np.digitize(values, edges, right=right)
+        assert np.array_equal(result, expected)
+
+    def test_failures_and_nan_go_to_the_last_bin(self) -> None:
+        given = ["1", "x", None, "nan", "inf", "-inf"]
+        result = fastnumbers.digitize_numeric(given, [0, 2])
+        assert result.tolist() == [1, 3, 3, 3, 2, 0]
+
+    def test_replacement_options(self) -> None:
+        given = ["1", "x", None, "nan", "1_0"]
+        result = fastnumbers.digitize_numeric(
+            given,
+            [0, 2],
+            on_fail=lambda x: -1.0,
+            on_type_error=5.0,
+            nan=0.0,
+            allow_underscores=True,
+        )
+        assert result.tolist() == [1, 0, 2, 1, 2]
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.digitize_numeric(given, [0, 2], on_fail=fastnumbers.RAISE)
+
+    def test_counts(self) -> None:
+        given = iter(["1", "x", "3", "1.5", "-1", "2"])
+        result = fastnumbers.digitize_numeric(given, [0, 2], counts=True)
+        assert result.dtype == np.int64
+        assert result.tolist() == [1, 2, 2, 1]
+
+    def test_counts_of_nothing(self) -> None:
+        result = fastnumbers.digitize_numeric([], [0, 2], counts=True)
+        assert result.tolist() == [0, 0, 0, 0]
+
+    def test_no_edges(self) -> None:
+        result = fastnumbers.digitize_numeric(["1", "x"], [])
+        assert result.tolist() == [0, 1]
+
+    def test_dtype(self) -> None:
+        result = fastnumbers.digitize_numeric(["1"], [0], dtype=np.int64)
+        assert result.dtype == np.int64
+        assert fastnumbers.digitize_numeric([], range(300)).dtype == np.uint16
+        with pytest.raises(ValueError, match="cannot hold the numbers of 302 bins"):
+            fastnumbers.digitize_numeric([], range(300), dtype=np.uint8)
+        with pytest.raises(TypeError, match="dtype must be an integer type"):
+            fastnumbers.digitize_numeric([], [0], dtype=np.float64)
+
+    def test_repeated_infinite_edges(self) -> None:
+        given = ["-inf", "-1", "0", "1", "inf"]
+        edges = [-math.inf, -math.inf, 0, math.inf, math.inf]
+        with warnings.catch_warnings():
+            warnings.simplefilter("error")
+            result = fastnumbers.digitize_numeric(given, edges)
+        expected = np.digitize([-np.inf, -1, 0, 1, np.inf], edges)
+        assert result.tolist() == expected.tolist()
+
+    @pytest.mark.parametrize("edges", [[1, 0], [0, math.nan], [[0, 1]]])
+    def test_invalid_edges(self, edges: Any) -> None:
+        with pytest.raises(ValueError, match="edges must be"):
+            fastnumbers.digitize_numeric([], edges)
+
+
+class TestNumericSketch:
+    """Tests for the streaming quantile and distinct count sketch"""
+
+    @staticmethod
+    def rank_error(values: np.ndarray[Any, Any], q: float, estimate: float) -> float:
+        """The difference between the fraction of values at or below q and q."""
+        rank = np.searchsorted(np.sort(values), estimate, side="right")
+        return abs(rank / len(values) - q)
+
+    @pytest.mark.parametrize("size", [0, 1, 5, 150])
+    def test_quantiles_are_exact_for_few_values(self, size: int) -> None:
+        rng = random.Random(size)
+        values = [rng.uniform(-100, 100) for _ in range(size)]
+        sketch = fastnumbers.NumericSketch()
+        sketch.update([repr(x) for x in values])
+        fractions = [0.0, 0.1, 0.25, 0.5, 0.75, 0.99, 1.0]
+        result = sketch.quantile(fractions)
+        if size == 0:
+            assert all(math.isnan(x) for x in result)
+        else:
+            expected = np.quantile(values, fractions, method="inverted_cdf")
+            assert result == expected.tolist()
+
+    def test_quantiles_of_many_values(self) -> None:
+        rng = np.random.default_rng(0)
+        values = rng.lognormal(size=200_000)
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(values.astype(str).tolist())
+        assert sketch.count == len(values)
+        assert sketch.min == values.min()
+        assert sketch.max == values.max()
+        for q in (0.001, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999):
+            assert self.rank_error(values, q, sketch.quantile(q)) < 0.02
+
+    @pytest.mark.parametrize("distinct", [1, 10, 1000, 100_000])
+    def test_distinct(self, distinct: int) -> None:
+        rng = random.Random(distinct)
+        given = [str(rng.randrange(distinct)) for _ in range(2 * distinct)]
+        given.extend(range(distinct))
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(given)
+        assert sketch.distinct() == pytest.approx(distinct, rel=0.03)
+
+    def test_distinct_compares_values(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(["1", 1, 1.0, "1e0", "0", "-0.0", "nan"])
+        assert round(sketch.distinct()) == 2
+        assert fastnumbers.NumericSketch().distinct() == 0.0
+
+    def test_nan_and_failures_are_only_counted(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(iter(["1", "x", None, "nan", float("nan"), "inf", "-3"]))
+        assert sketch.count == 3
+        assert sketch.nan_count == 4
+        assert sketch.min == -3.0
+        assert sketch.max == math.inf
+        assert sketch.quantile(0.5) == 1.0
+
+    def test_replacement_options(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(
+            ["1", "x", None, "1_0"],
+            on_fail=lambda x: -1.0,
+            on_type_error=5.0,
+            allow_underscores=True,
+        )
+        assert sketch.quantile([0.0, 0.5, 1.0]) == [-1.0, 1.0, 10.0]
+        assert sketch.nan_count == 0
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            sketch.update(["x"], on_fail=fastnumbers.RAISE)
+
+    def test_merge_is_like_one_sketch(self) -> None:
+        rng = np.random.default_rng(1)
+        values = rng.normal(size=100_000)
+        whole = fastnumbers.NumericSketch()
+        whole.update(values.tolist())
+        merged = fastnumbers.NumericSketch()
+        for chunk in np.array_split(values, 7):
+            part = fastnumbers.NumericSketch()
+            part.update(chunk.tolist() + ["x"])
+            merged.merge(part)
+        assert merged.count == whole.count
+        assert merged.nan_count == 7
+        assert merged.min == whole.min
+        assert merged.max == whole.max
+        assert merged.distinct() == whole.distinct()
+        for q in (0.01, 0.5, 0.99):
+            assert self.rank_error(values, q, merged.quantile(q)) < 0.02
+
+    def test_merge_with_itself_doubles(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(["1", "2", "3"])
+        sketch.merge(sketch)
+        assert sketch.count == 6
+        assert sketch.quantile(0.5) == 2.0
+
+        # Large enough that the levels are reallocated as they grow.
+        sketch = fastnumbers.NumericSketch(k=8)
+        sketch.update(range(10_000))
+        copy = fastnumbers.NumericSketch.from_bytes(sketch.to_bytes())
+        expected = fastnumbers.NumericSketch.from_bytes(sketch.to_bytes())
+        expected.merge(copy)
+        sketch.merge(sketch)
+        assert sketch.to_bytes() == expected.to_bytes()
+
+    def test_merge_errors(self) -> None:
+        sketch = fastnumbers.NumericSketch(precision=14)
+        with pytest.raises(ValueError, match="different precision"):
+            sketch.merge(fastnumbers.NumericSketch(precision=12))
+        with pytest.raises(TypeError, match="must be a NumericSketch"):
+            sketch.merge([1, 2])  # type: ignore[arg-type]
+
+    def test_serialization_round_trip(self) -> None:
+        sketch = fastnumbers.NumericSketch(k=50, precision=10)
+        sketch.update([str(x) for x in range(10_000)] + ["nan"])
+        data = sketch.to_bytes()
+        for copy in (
+            fastnumbers.NumericSketch.from_bytes(data),
+            fastnumbers.NumericSketch.from_bytes(bytearray(data)),
+            pickle.loads(pickle.dumps(sketch)),
+        ):
+            assert copy.to_bytes() == data
+            assert copy.quantile([0.1, 0.5]) == sketch.quantile([0.1, 0.5])
+            assert copy.distinct() == sketch.distinct()
+            assert (copy.count, copy.nan_count) == (10_000, 1)
+
+        # A copy keeps changing the same way as the original.
+        copy = fastnumbers.NumericSketch.from_bytes(data)
+        copy.update(range(5000))
+        sketch.update(range(5000))
+        assert copy.to_bytes() == sketch.to_bytes()
+
+    @pytest.mark.parametrize(
+        "data", [b"", b"FNSK", b"junk" * 10, b"FNSK\x02" + b"\x00" * 100]
+    )
+    def test_invalid_serialization(self, data: bytes) -> None:
+        with pytest.raises(ValueError, match="not a serialized sketch"):
+            fastnumbers.NumericSketch.from_bytes(data)
+
+    def test_truncated_serialization(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(range(1000))
+        data = sketch.to_bytes()
+        for end in (10, 50, len(data) - 1):
+            with pytest.raises(ValueError, match="not a serialized sketch"):
+                fastnumbers.NumericSketch.from_bytes(data[:end])
+
+    @pytest.mark.parametrize(
+        ("kwargs", "message"),
+        [
+            ({"k": 4}, "k must be between 8 and 65535"),
+            ({"precision": 19}, "precision must be between 4 and 18"),
+        ],
+    )
+    def test_invalid_parameters(self, kwargs: dict[str, int], message: str) -> None:
+        with pytest.raises(ValueError, match=message):
+            fastnumbers.NumericSketch(**kwargs)
+
+    @pytest.mark.parametrize("q", [-0.1, 1.5, math.nan])
+    def test_invalid_quantile(self, q: float) -> None:
+        with pytest.raises(ValueError, match="quantiles must be between 0 and 1"):
+            fastnumbers.NumericSketch().quantile(q)
+
+    def test_repr(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        sketch.update(["1", "x"])
+        expected = "NumericSketch(count=1, nan_count=1, min=1.0, max=1.0)"
+        assert repr(sketch) == expected
+
+    @pytest.mark.parametrize("dtype", [np.float64, np.float32, np.int64, np.uint8])
+    def test_try_array_adds_the_converted_values(self, dtype: Any) -> None:
+        given = [str(x % 250) for x in range(5000)] + ["x", "nan"]
+        sketch = fastnumbers.NumericSketch()
+        result = fastnumbers.try_array(given, dtype=dtype, on_fail=7, sketch=sketch)
+        expected = fastnumbers.NumericSketch()
+        expected.update(result.tolist())
+        assert sketch.to_bytes() == expected.to_bytes()
+
+    def test_try_array_adds_to_a_given_output(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        output = array.array("i", [0, 0, 0])
+        fastnumbers.try_array(["3", "1", "2"], output, sketch=sketch)
+        assert (sketch.count, sketch.min, sketch.max) == (3, 1.0, 3.0)
+
+    def test_try_array_adds_each_chunk_of_a_file(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        sink = io.BytesIO()
+        given = iter([str(x) for x in range(100)])
+        fastnumbers.try_array(given, sink, chunk_size=7, sketch=sketch)
+        assert (sketch.count, sketch.min, sketch.max) == (100, 0.0, 99.0)
+
+    def test_try_array_adds_nothing_if_an_error_is_raised(self) -> None:
+        sketch = fastnumbers.NumericSketch()
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.try_array(["1", "x"], on_fail=fastnumbers.RAISE, sketch=sketch)
+        assert sketch.count == 0
+
+    @pytest.mark.parametrize("dtype", [np.complex128, np.object_])
+    def test_try_array_rejects_a_dtype_that_cannot_be_sketched(
+        self, dtype: Any
+    ) -> None:
+        with pytest.raises(TypeError, match="integral or float dtype"):
+            fastnumbers.try_array(
+                ["1"], dtype=dtype, sketch=fastnumbers.NumericSketch()
+            )
+
+    def test_try_array_rejects_a_sketch_of_another_type(self) -> None:
+        with pytest.raises(TypeError, match="sketch must be a NumericSketch"):
+            fastnumbers.try_array(["1"], sketch=[])  # type: ignore[call-overload]
+
+
+class TestConvertRecords:
+    """Tests for filling arrays from records with convert_records"""
+
+    def test_arrays_are_filled(self) -> None:
+        records = [{"p": "1.5", "q": "3"}, {"q": "x"}, {"p": "2", "q": "5"}]
+        result = fastnumbers.convert_records(
+            records,
+            {"p": "float", "q": np.int16},
+            arrays=True,
+            on_fail=-1,
+            on_type_error=-2,
+        )
+        assert result is not None
+        assert result["p"].tolist() == [1.5, -2.0, 2.0]
+        assert result["q"].dtype == np.int16
+        assert result["q"].tolist() == [3, -1, 5]
+        assert records[0] == {"p": "1.5", "q": "3"}
+
+    def test_arrays_only_collect_records_with_a_field(self) -> None:
+        records = [{"p": "1", "meta": {"v": 1}, "items": [{"p": "2"}]}]
+        result = fastnumbers.convert_records(
+            records, {"p": "int"}, arrays=True, recurse=True
+        )
+        assert result is not None
+        assert result["p"].tolist() == [1, 2]
+
+    def test_invalid_kind(self) -> None:
+        with pytest.raises(ValueError, match="kind must be a dtype or one of"):
+            fastnumbers.convert_records([{"v": "1"}], {"v": "decimal"}, arrays=True)
+
+    def test_sketches_are_fed_the_arrays(self) -> None:
+        records = [{"p": "1.5", "q": "3"}, {"p": "4"}, {"p": "2", "q": "5"}]
+        sketch = fastnumbers.NumericSketch()
+        result = fastnumbers.convert_records(
+            records,
+            {"p": "float", "q": "int"},
+            arrays=True,
+            sketches={"p": sketch},
+            on_type_error=0,
+        )
+        assert result is not None
+        assert result["p"].tolist() == [1.5, 4.0, 2.0]
+        assert (sketch.count, sketch.min, sketch.max) == (3, 1.5, 4.0)
+
+    def test_sketches_require_arrays(self) -> None:
+        sketches = {"p": fastnumbers.NumericSketch()}
+        with pytest.raises(ValueError, match="only be used if arrays is True"):
+            fastnumbers.convert_records([{"p": "1"}], {"p": "float"}, sketches=sketches)
+
+
+class TestCache:
+    """Tests for caching the result on disk with cache_dir"""
+
+    def test_cached_result_is_reused(self, tmp_path: pathlib.Path) -> None:
+        given = [str(i) for i in range(100)]
+        first = fastnumbers.try_array(given, cache_dir=tmp_path)
+        (path,) = tmp_path.iterdir()
+        assert path.suffix == ".npy"
+        # Replace the cached values to prove they are what is returned.
+        np.save(path, -first)
+        second = fastnumbers.try_array(iter(given), cache_dir=tmp_path)
+        assert isinstance(second, np.memmap)
+        assert np.array_equal(second, -first)
+
+    def test_changes_are_not_written_to_the_cache(
+        self, tmp_path: pathlib.Path
+    ) -> None:
+        fastnumbers.try_array(["1", "2"], cache_dir=tmp_path)
+        result = fastnumbers.try_array(["1", "2"], cache_dir=tmp_path)
+        result[0] = 5
+        result = fastnumbers.try_array(["1", "2"], cache_dir=tmp_path)
+        assert result.tolist() == [1.0, 2.0]
+
+    def test_input_and_options_are_part_of_the_key(
+        self, tmp_path: pathlib.Path
+    ) -> None:
+        for given in (["1"], [1], [1.0], [b"1"], [bytearray(b"1")], [True]):
+            fastnumbers.try_array(given, cache_dir=tmp_path)
+        fastnumbers.try_array(["12", "3"], cache_dir=tmp_path)
+        fastnumbers.try_array(["1", "23"], cache_dir=tmp_path)
+        fastnumbers.try_array([str(10**30)], cache_dir=tmp_path)
+        fastnumbers.try_array([10**30], cache_dir=tmp_path)
+        fastnumbers.try_array(["1"], dtype=np.float32, cache_dir=tmp_path)
+        fastnumbers.try_array(["x"], on_fail=1.0, cache_dir=tmp_path)
+        fastnumbers.try_array(["x"], on_fail=2.0, cache_dir=tmp_path)
+        assert len(list(tmp_path.iterdir())) == 13
+        result = fastnumbers.try_array(["x"], on_fail=2.0, cache_dir=tmp_path)
+        assert result.tolist() == [2.0]
+
+    def test_selectors_are_part_of_the_key(self, tmp_path: pathlib.Path) -> None:
+        fastnumbers.try_array(["inf"], inf=fastnumbers.ALLOWED, cache_dir=tmp_path)
+        fastnumbers.try_array(["inf"], inf=fastnumbers.ALLOWED, cache_dir=tmp_path)
+        fastnumbers.try_array(["inf"], inf=0.0, cache_dir=tmp_path)
+        assert len(list(tmp_path.iterdir())) == 2
+
+    def test_conversion_limits_are_part_of_the_key(
+        self, tmp_path: pathlib.Path
+    ) -> None:
+        # Fractions are converted with Python ints, so the limits apply.
+        given = ["1" * 20 + "/3"]
+        options: dict[str, Any] = {
+            "on_fail": -1.0,
+            "allow_fraction": True,
+            "cache_dir": tmp_path,
+        }
+        first = fastnumbers.try_array(given, **options)
+        try:
+            fastnumbers.set_conversion_limits(max_digits=10)
+            second = fastnumbers.try_array(given, **options)
+        finally:
+            fastnumbers.set_conversion_limits()
+        assert len(list(tmp_path.iterdir())) == 2
+        assert first.tolist() == [int("1" * 20) / 3]
+        assert second.tolist() == [-1.0]
+
+    def test_uncacheable_input_is_converted(self, tmp_path: pathlib.Path) -> None:
+        class Text(str):
+            pass
+
+        result = fastnumbers.try_array(["x"], on_fail=len, cache_dir=tmp_path)
+        assert result.tolist() == [1.0]
+        result = fastnumbers.try_array([Text("4")], cache_dir=tmp_path)
+        assert result.tolist() == [4.0]
+        result = fastnumbers.try_array([], cache_dir=tmp_path)
+        assert result.tolist() == []
+        assert list(tmp_path.iterdir()) == []
+
+    def test_errors_are_not_cached(self, tmp_path: pathlib.Path) -> None:
+        with pytest.raises(ValueError, match="Cannot convert 'x'"):
+            fastnumbers.try_array(["x"], cache_dir=tmp_path)
+        assert list(tmp_path.iterdir()) == []
+
+    def test_output_cannot_be_given(self, tmp_path: pathlib.Path) -> None:
+        with pytest.raises(ValueError, match="output is None"):
+            fastnumbers.try_array(["1"], np.empty(1), cache_dir=tmp_path)
+
+
 @hyp_given(
     lists(
         floats() | integers() | text() | binary() | lists(integers(), max_size=1),
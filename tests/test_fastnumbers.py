@@ -1,10 +1,15 @@
 from __future__ import annotations
 
+import collections.abc
 import decimal
+import gc
 import math
 import random
 import re
+import sys
 import unicodedata
+import weakref
+from fractions import Fraction
 from functools import partial
 from itertools import combinations
 from typing import (
@@ -424,6 +429,81 @@ def test_version() -> None:
     assert hasattr(fastnumbers, "__version__")
 
 
+def test_cpu_features() -> None:
+    features = fastnumbers.cpu_features()
+    variants = ("default", "x86-64-v2", "x86-64-v3", "x86-64-v4")
+    assert features["variant"] in variants
+    assert isinstance(features["multiversioned"], bool)
+    if not features["multiversioned"]:
+        assert features["variant"] == "default"
+
+
+class TestConversionLimits:
+    """Tests for bounding the size of strings converted to int"""
+
+    @pytest.fixture(autouse=True)
+    def _reset_limits(self) -> Iterator[None]:
+        yield
+        fastnumbers.set_conversion_limits()
+
+    @pytest.mark.skipif(sys.version_info < (3, 11), reason="no interpreter limit")
+    def test_defaults_follow_interpreter(self) -> None:
+        limit = sys.get_int_max_str_digits()
+        expected = {"max_digits": limit, "max_exponent": limit}
+        assert fastnumbers.get_conversion_limits() == expected
+
+    @pytest.mark.skipif(sys.version_info < (3, 11), reason="no interpreter limit")
+    def test_interpreter_changes_are_seen_by_the_next_call(self) -> None:
+        original = sys.get_int_max_str_digits()
+        try:
+            sys.set_int_max_str_digits(5000)
+            assert fastnumbers.try_int("1" * 5000) == int("1" * 5000)
+            sys.set_int_max_str_digits(4999)
+            assert fastnumbers.try_int("1" * 5000) == "1" * 5000
+        finally:
+            sys.set_int_max_str_digits(original)
+
+    def test_huge_exponent_is_rejected_immediately_with_denoise(self) -> None:
+        fastnumbers.set_conversion_limits(max_digits=1000, max_exponent=1000)
+        for x in ("1e4294967295", "1e4294967296", "1e99999999999999999999"):
+            assert fastnumbers.try_forceint(x, denoise=True) == x
+            assert fastnumbers.try_real(x, denoise=True) == x
+        with pytest.raises(ValueError, match="Exceeds the limit"):
+            fastnumbers.try_forceint("1e1001", denoise=True, on_fail=fastnumbers.RAISE)
+        assert fastnumbers.try_forceint("1e1000", denoise=True) == 10**1000
+
+    def test_too_many_digits_is_rejected(self) -> None:
+        fastnumbers.set_conversion_limits(max_digits=30)
+        assert fastnumbers.try_int("1" * 30) == int("1" * 30)
+        assert fastnumbers.try_int("1" * 31) == "1" * 31
+        assert fastnumbers.try_int("1_1" * 10, allow_underscores=True) == int("11" * 10)
+        assert fastnumbers.try_int("1_1" * 15, allow_underscores=True) == int("11" * 15)
+        too_long = "1_1" * 15 + "_1"
+        assert fastnumbers.try_int(too_long, allow_underscores=True) == too_long
+        assert fastnumbers.try_forceint("1" * 31 + ".0", denoise=True) == "1" * 31 + ".0"
+        with pytest.raises(ValueError, match="Exceeds the limit"):
+            fastnumbers.try_int("1" * 31, on_fail=fastnumbers.RAISE)
+
+    def test_zero_means_unlimited(self) -> None:
+        fastnumbers.set_conversion_limits(max_digits=0, max_exponent=0)
+        assert fastnumbers.get_conversion_limits() == {
+            "max_digits": 0,
+            "max_exponent": 0,
+        }
+        assert fastnumbers.try_forceint("1e5000", denoise=True) == 10**5000
+
+    def test_small_numbers_are_unaffected(self) -> None:
+        fastnumbers.set_conversion_limits(max_digits=1, max_exponent=1)
+        assert fastnumbers.try_int("123456789") == 123456789
+        assert fastnumbers.try_forceint("1.5e10", denoise=True) == 15000000000
+
+    def test_invalid_limits(self) -> None:
+        with pytest.raises(ValueError, match="max_digits must be >= 0"):
+            fastnumbers.set_conversion_limits(max_digits=-1)
+        with pytest.raises(TypeError, match="max_exponent must be an int or None"):
+            fastnumbers.set_conversion_limits(max_exponent=1.0)  # type: ignore
+
+
 @given(floats(allow_nan=False) | integers())
 def test_real_returns_same_as_fast_real(x: FloatOrInt) -> None:
     assert fastnumbers.real(x) == fastnumbers.try_real(x)
@@ -809,6 +889,245 @@ class TestUnderscores:
         assert fastnumbers.query_type(x, allow_underscores=False) is str
 
 
+class TestNumberFormat:
+    """Tests for locale-style decimal points, thousands separators, and negatives."""
+
+    @pytest.mark.parametrize(
+        ("x", "kwargs", "expected"),
+        [
+            ("1234,56", {"decimal_point": ","}, 1234.56),
+            ("1.234,56", {"decimal_point": ",", "thousands": "."}, 1234.56),
+            ("1,234.56", {"thousands": ","}, 1234.56),
+            ("1 234 567,5", {"decimal_point": ",", "thousands": " "}, 1234567.5),
+            ("-12,345,678.9e2", {"thousands": ","}, -1234567890.0),
+            (" +1,234.5 ", {"thousands": ","}, 1234.5),
+            ("123", {"thousands": ","}, 123.0),
+            (",5", {"decimal_point": ","}, 0.5),
+            ("(1,234.50)", {"thousands": ",", "accounting": True}, -1234.5),
+            (" (12) ", {"accounting": True}, -12.0),
+            (b"1.234,56", {"decimal_point": ",", "thousands": "."}, 1234.56),
+        ],
+    )
+    def test_try_float_accepts_formatted_numbers(
+        self, x: str | bytes, kwargs: dict[str, Any], expected: float
+    ) -> None:
+        assert fastnumbers.try_float(x, **kwargs) == expected
+
+    @pytest.mark.parametrize(
+        ("x", "kwargs"),
+        [
+            ("1234.56", {"decimal_point": ","}),
+            ("1,23,456", {"thousands": ","}),
+            ("1234,567", {"thousands": ","}),
+            ("1,2345", {"thousands": ","}),
+            (",123", {"thousands": ","}),
+            ("123,", {"thousands": ","}),
+            ("1,,234", {"thousands": ","}),
+            ("1.234,5", {"thousands": ","}),
+            ("1.234,567", {"thousands": ","}),
+            ("(1234)", {}),
+            ("(-1234)", {"accounting": True}),
+            ("(1234", {"accounting": True}),
+            ("1,234", {}),
+        ],
+    )
+    def test_try_float_rejects_malformed_numbers(
+        self, x: str, kwargs: dict[str, Any]
+    ) -> None:
+        assert fastnumbers.try_float(x, **kwargs) == x
+
+    def test_other_functions_accept_formatted_numbers(self) -> None:
+        kwargs = {"decimal_point": ",", "thousands": ".", "accounting": True}
+        assert fastnumbers.try_real("1.234,00", **kwargs) == 1234
+        assert fastnumbers.try_real("1.234,50", **kwargs) == 1234.5
+        assert fastnumbers.try_int("(1.234)", **kwargs) == -1234
+        assert fastnumbers.try_forceint("1.234,9", **kwargs) == 1234
+        assert fastnumbers.check_real("1.234,5", **kwargs)
+        assert fastnumbers.check_float("1.234,5", **kwargs)
+        assert fastnumbers.check_int("1.234", **kwargs)
+        assert fastnumbers.check_intlike("1.234,0", **kwargs)
+        assert fastnumbers.query_type("1.234,5", **kwargs) is float
+        assert fastnumbers.query_type("1.234.5", **kwargs) is str
+
+    def test_formatted_big_integers_are_converted(self) -> None:
+        x = "1" + ",000" * 30
+        assert fastnumbers.try_int(x, thousands=",") == 10**90
+        y = "1" + " 000" * 30 + ",0"
+        result = fastnumbers.try_real(
+            y, thousands=" ", decimal_point=",", denoise=True
+        )
+        assert result == 10**90
+
+    @pytest.mark.parametrize(
+        "kwargs",
+        [
+            {"decimal_point": ""},
+            {"decimal_point": ",,"},
+            {"decimal_point": "1"},
+            {"decimal_point": "-"},
+            {"decimal_point": " "},
+            {"thousands": "e"},
+            {"thousands": "("},
+            {"thousands": ","},
+            {"decimal_point": ".", "thousands": "."},
+            {"decimal_point": 44},
+            {"thousands": b","},
+        ],
+    )
+    def test_invalid_characters_raise_value_error(
+        self, kwargs: dict[str, Any]
+    ) -> None:
+        kwargs.setdefault("decimal_point", ",")
+        with pytest.raises(ValueError):
+            fastnumbers.try_float("1", **kwargs)
+
+
+class TestSuffixes:
+    """Tests for numbers followed by a unit suffix."""
+
+    @pytest.mark.parametrize(
+        ("x", "suffixes", "expected"),
+        [
+            ("10k", "si", 10000),
+            ("3.2M", "si", 3200000),
+            ("-2.5k", "si", -2500),
+            ("1.5G", "si", 1500000000),
+            ("500m", "si", 0.5),
+            ("1.5GiB", "iec", 1610612736),
+            ("1Ei", "iec", 2**60),
+            (" 7 Ki ", "iec", 7168),
+            ("45%", "percent", 0.45),
+            ("200%", "percent", 2),
+            (".5%", "percent", 0.005),
+            ("1e3k", "si", 1000000),
+            ("1.5e-3M", "si", 1500),
+            ("1.25e-3k", "si", 1.25),
+            ("12", "si", 12),
+            ("2h", {"h": 3600}, 7200),
+            ("3x", {"x": 1.5}, 4.5),
+            ("1.5k", ["si", {"k": 1024}], 1536),
+            ("1kB", ("si", "iec", {"kB": 1000}), 1000),
+        ],
+    )
+    def test_try_real_scales_by_suffix(
+        self, x: str, suffixes: Any, expected: int | float
+    ) -> None:
+        result = fastnumbers.try_real(x, suffixes=suffixes)
+        assert result == expected
+        assert type(result) is type(expected)
+
+    def test_scaling_is_exact(self) -> None:
+        x = "1.23456789012345678901234567890"
+        assert fastnumbers.try_float(x + "M", suffixes="si") == float(x + "e6")
+        assert fastnumbers.try_float(x + "Ei", suffixes="iec") == float(
+            decimal.Decimal(x) * 2**60
+        )
+        y = "1" * 40
+        assert fastnumbers.try_int(y + "Ei", suffixes="iec") == int(y) * 2**60
+        assert fastnumbers.try_float("0.1M", suffixes="si") == 100000.0
+
+    @pytest.mark.parametrize(
+        "x", ["k", "1.2.3k", "infk", "0x10k", "1k k", "1e3k", "45%", "1.5e-3M"]
+    )
+    def test_try_int_rejects_non_integers(self, x: str) -> None:
+        assert fastnumbers.try_int(x, suffixes=["si", "percent"]) == x
+
+    def test_suffixes_combine_with_number_format(self) -> None:
+        kwargs = {"thousands": ",", "accounting": True, "suffixes": "si"}
+        assert fastnumbers.try_int("(1,234.5k)", **kwargs) == -1234500
+        assert fastnumbers.try_float(b"2,000M", **kwargs) == 2e9
+
+    def test_suffixes_combine_with_underscores(self) -> None:
+        kwargs = {"suffixes": "si", "allow_underscores": True}
+        assert fastnumbers.try_float("1_000k", **kwargs) == 1e6
+        assert fastnumbers.try_int("1_000.5_5 k", **kwargs) == 1000550
+        # Underscores are still only allowed between digits, and if allowed.
+        assert fastnumbers.try_float("1_k", **kwargs) == "1_k"
+        assert fastnumbers.try_float("1__0k", **kwargs) == "1__0k"
+        assert fastnumbers.try_float("1_000k", suffixes="si") == "1_000k"
+
+    def test_suffixes_are_ignored_for_other_bases(self) -> None:
+        assert fastnumbers.try_int("1E", base=16, suffixes="si") == 30
+        assert fastnumbers.try_int("1E", suffixes="si") == 10**18
+
+    def test_checking_functions_see_scaled_value(self) -> None:
+        assert fastnumbers.check_int("1.5k", suffixes="si")
+        assert not fastnumbers.check_int("1.5", suffixes="si")
+        assert fastnumbers.check_intlike("2.5k", suffixes="si")
+        assert fastnumbers.check_float("45%", suffixes="percent")
+        assert fastnumbers.query_type("45%", suffixes="percent") is float
+        assert fastnumbers.query_type("45%") is str
+
+    def test_map_scales_each_element(self) -> None:
+        given = ["1k", "2M", "3", "x"]
+        result = fastnumbers.try_float(given, suffixes="si", map=list)
+        assert result == [1000.0, 2000000.0, 3.0, "x"]
+
+    @pytest.mark.parametrize(
+        ("suffixes", "exception"),
+        [
+            ("xx", ValueError),
+            ({"": 1}, ValueError),
+            ({"1k": 1}, ValueError),
+            ({" k": 1}, ValueError),
+            ({"-k": 1}, ValueError),
+            ({"k": 0}, ValueError),
+            ({"k": -1}, ValueError),
+            ({"k": 1234567891}, ValueError),
+            ({"k": math.inf}, ValueError),
+            ({"k": "1"}, TypeError),
+            ({"k": True}, TypeError),
+            ({3: 1}, TypeError),
+            (5, TypeError),
+            ([5], TypeError),
+        ],
+    )
+    def test_invalid_suffixes_raise(self, suffixes: Any, exception: type) -> None:
+        with pytest.raises(exception):
+            fastnumbers.try_float("1", suffixes=suffixes)
+
+
+class TestAssumeValid:
+    """Tests for assume_valid=True, which skips validation of trusted strings."""
+
+    @given(integers())
+    def test_valid_int_strings_are_converted(self, x: int) -> None:
+        for text in (str(x), f"+{x}" if x >= 0 else str(x)):
+            assert fastnumbers.try_int(text, assume_valid=True) == x
+            assert fastnumbers.try_real(text, assume_valid=True) == x
+            assert fastnumbers.try_forceint(text, assume_valid=True) == x
+
+    @given(floats())
+    def test_valid_float_strings_are_converted(self, x: float) -> None:
+        result = fastnumbers.try_float(repr(x), assume_valid=True)
+        if math.isnan(x):
+            assert math.isnan(result)
+        else:
+            assert result == x
+
+    def test_inf_and_nan_selectors_still_apply(self) -> None:
+        assert fastnumbers.try_float("-inf", inf=0.0, assume_valid=True) == 0.0
+        assert fastnumbers.try_float("nan", nan=1.0, assume_valid=True) == 1.0
+
+    def test_numbers_are_unaffected(self) -> None:
+        assert fastnumbers.try_int(5.5, assume_valid=True) == 5
+        assert fastnumbers.try_float(5, assume_valid=True) == 5.0
+
+    @given(text() | binary())
+    def test_invalid_strings_are_memory_safe(self, x: str | bytes) -> None:
+        # The results are unspecified, they must just not crash.
+        kwargs: dict[str, Any] = {"on_fail": None, "assume_valid": True}
+        fastnumbers.try_int(x, **kwargs)
+        fastnumbers.try_real(x, **kwargs)
+        fastnumbers.try_float(x, **kwargs)
+        fastnumbers.try_forceint(x, **kwargs)
+
+    @parametrize("x", ["", "-", "+", "12a", "1 2"])
+    def test_short_invalid_strings_are_memory_safe(self, x: str) -> None:
+        fastnumbers.try_int(x, on_fail=None, assume_valid=True)
+        fastnumbers.try_int(x.encode(), on_fail=None, assume_valid=True)
+
+
 class TestErrorHandlingConversionFunctionsSuccessful:
     """
     Test the successful execution of the "error handling conversion" functions, e.g.:
@@ -1290,6 +1609,95 @@ class TestTryFloat:
         assert isinstance(result, float)
         assert fastnumbers.try_float(pad(x)) == expected  # Accepts padding as well
 
+    @given(floats(allow_nan=False, allow_infinity=False).map(float.hex))
+    @example("0x1.fffffffffffff7ffp1023")
+    @example("0x1.0000000000001p-1075")
+    @example("0x1.00000000000008000000000000001p0")
+    @example("0x.8p-1073")
+    @example("0X1P3")
+    @example("0x00000.0000000000000000000000001p100")
+    def test_given_hex_float_string_returns_exact_float(self, x: str) -> None:
+        expected = float.fromhex(x)
+        result = fastnumbers.try_float(x, allow_hex_float=True)
+        assert isinstance(result, float)
+        assert repr(result) == repr(expected)
+        assert repr(fastnumbers.try_float(pad(x), allow_hex_float=True)) == repr(
+            expected
+        )
+
+    def test_hex_float_strings_require_the_option(self) -> None:
+        assert fastnumbers.try_float("0x1.8p3") == "0x1.8p3"
+        assert fastnumbers.try_float("-0x1.8p3", allow_hex_float=True) == -12.0
+        assert fastnumbers.try_float("1.5", allow_hex_float=True) == 1.5
+
+    @parametrize("x", ["0x", "0x.", "0xp1", "0x1p", "0x1p+", "0x1.2.3", "0x1g", "--0x1"])
+    def test_given_invalid_hex_float_string_fails(self, x: str) -> None:
+        with pytest.raises(ValueError):
+            float.fromhex(x)
+        assert fastnumbers.try_float(x, allow_hex_float=True) == x
+
+    def test_given_too_large_hex_float_raises_overflow_error(self) -> None:
+        x = "0x1p1024"
+        assert fastnumbers.try_float(x, allow_hex_float=True) == x
+        with pytest.raises(OverflowError, match="too large to represent"):
+            fastnumbers.try_float(x, allow_hex_float=True, on_fail=fastnumbers.RAISE)
+
+    @given(integers(0, 1 << 70), integers(1, 1 << 70), sampled_from(["", "-", "+"]))
+    @example(1, 3, "")
+    @example(1 << 70, 3, "-")
+    @example(9007199254740993, 1, "")
+    @example(0, 1, "-")
+    def test_given_fraction_string_returns_correctly_rounded_float(
+        self, numerator: int, denominator: int, sign: str
+    ) -> None:
+        x = f"{sign}{numerator}/{denominator}"
+        expected = float(Fraction(x))
+        result = fastnumbers.try_float(x, allow_fraction=True)
+        assert repr(result) == repr(expected)
+        assert repr(fastnumbers.try_float(pad(x), allow_fraction=True)) == repr(
+            expected
+        )
+
+    @given(integers(0, 1 << 60), integers(0, 1 << 60), integers(1, 1 << 60))
+    def test_given_mixed_number_string_returns_correctly_rounded_float(
+        self, whole: int, numerator: int, denominator: int
+    ) -> None:
+        x = f"{whole} {numerator}/{denominator}"
+        expected = float(whole + Fraction(numerator, denominator))
+        assert fastnumbers.try_float(x, allow_fraction=True) == expected
+        assert fastnumbers.try_float("-" + x, allow_fraction=True) == -expected
+
+    def test_negative_fraction_that_underflows_keeps_its_sign(self) -> None:
+        x = "-1/1" + "0" * 400
+        assert repr(fastnumbers.try_float(x, allow_fraction=True)) == "-0.0"
+        assert repr(float(Fraction(x))) == "-0.0"
+        assert repr(fastnumbers.try_float("-0/5", allow_fraction=True)) == "0.0"
+        assert repr(fastnumbers.try_float("-0 00/5", allow_fraction=True)) == "0.0"
+
+    def test_fraction_strings_require_the_option(self) -> None:
+        assert fastnumbers.try_float("3/4") == "3/4"
+        assert fastnumbers.try_float("3/4", allow_fraction=True) == 0.75
+        assert fastnumbers.try_real("4/2", allow_fraction=True) == 2
+        assert fastnumbers.try_real("1 1/2", allow_fraction=True) == 1.5
+        assert fastnumbers.try_real("1.5", allow_fraction=True) == 1.5
+        assert fastnumbers.try_float("1_0/4", allow_fraction=True) == "1_0/4"
+        assert (
+            fastnumbers.try_float("1_0/4", allow_fraction=True, allow_underscores=True)
+            == 2.5
+        )
+
+    @parametrize(
+        "x", ["/", "1/", "/2", "1 /2", "1/ 2", "1/2/3", "1.5/2", "1 2", "1/0", "1/-2"]
+    )
+    def test_given_invalid_fraction_string_fails(self, x: str) -> None:
+        assert fastnumbers.try_float(x, allow_fraction=True) == x
+
+    def test_given_too_large_fraction_raises_overflow_error(self) -> None:
+        x = "1" + "0" * 400 + "/3"
+        assert fastnumbers.try_float(x, allow_fraction=True) == x
+        with pytest.raises(OverflowError, match="too large for a float"):
+            fastnumbers.try_float(x, allow_fraction=True, on_fail=fastnumbers.RAISE)
+
 
 class TestTryInt:
     """
@@ -1409,6 +1817,284 @@ class TestTryForceInt:
         assert result == expected
 
 
+class TestTryComplex:
+    """
+    Tests for the try_complex function, which must match the built-in complex.
+    """
+
+    @parametrize(
+        "x",
+        [
+            "1+2j",
+            "(1+2j)",
+            " ( -1.5e3-2.5E-3J ) ",
+            "5j",
+            "-3j",
+            "+j",
+            "-j",
+            "1-j",
+            "6",
+            "-0-0j",
+            ".5j",
+            "1.j",
+            "inf",
+            "-infj",
+            "1+nanj",
+            "1e400j",
+        ],
+    )
+    def test_given_valid_complex_string_returns_complex(self, x: str) -> None:
+        result = fastnumbers.try_complex(x)
+        assert isinstance(result, complex)
+        assert repr(result) == repr(complex(x))
+        assert repr(fastnumbers.try_complex(pad(x))) == repr(complex(x))
+
+    @parametrize(
+        "x",
+        ["", "()", "(1+2j", "1 + 2j", "1+-2j", "1++j", "jj", "1e", "1+2i", "nan(1)"],
+    )
+    def test_given_invalid_complex_string_fails(self, x: str) -> None:
+        with pytest.raises(ValueError):
+            complex(x)
+        assert fastnumbers.try_complex(x) == x
+        with pytest.raises(ValueError, match="complex\\(\\) arg is a malformed string"):
+            fastnumbers.try_complex(x, on_fail=fastnumbers.RAISE)
+
+    @given(floats(), floats())
+    def test_given_complex_repr_returns_complex(self, real: float, imag: float) -> None:
+        x = complex(real, imag)
+        assert repr(fastnumbers.try_complex(repr(x))) == repr(complex(repr(x)))
+        assert repr(fastnumbers.try_complex(x)) == repr(x)
+
+    @parametrize("x", [5, 5.5, True, 1 << 100])
+    def test_given_number_returns_complex(self, x: float) -> None:
+        assert fastnumbers.try_complex(x) == complex(x)
+
+    def test_given_number_that_overflows_raises_overflow_error(self) -> None:
+        with pytest.raises(OverflowError):
+            fastnumbers.try_complex(1 << 2000, on_fail=fastnumbers.RAISE)
+
+    def test_given_invalid_type_raises_type_error(self) -> None:
+        msg = "complex\\(\\) first argument must be a string or a number, not 'list'"
+        with pytest.raises(TypeError, match=msg):
+            fastnumbers.try_complex([5])
+        assert fastnumbers.try_complex([5], on_type_error=0j) == 0j
+
+    def test_given_unicode_numeral_returns_complex(self) -> None:
+        assert fastnumbers.try_complex("\u2466") == 7 + 0j
+        assert fastnumbers.try_complex("\u0661+\u0662j") == 1 + 2j
+
+    def test_underscores(self) -> None:
+        assert fastnumbers.try_complex("1_0+2_0j") == "1_0+2_0j"
+        assert fastnumbers.try_complex("1_0+2_0j", allow_underscores=True) == 10 + 20j
+        assert fastnumbers.try_complex("1__0j", allow_underscores=True) == "1__0j"
+
+    def test_map(self) -> None:
+        result = fastnumbers.try_complex(["1", "2j", "bad"], on_fail=len, map=list)
+        assert result == [1 + 0j, 2j, 3]
+
+
+
+class TestTryFraction:
+    """
+    Tests for the try_fraction function, which must match fractions.Fraction.
+    """
+
+    @parametrize(
+        "x",
+        [
+            "3/4",
+            "-3/4",
+            "+6/8",
+            "0/5",
+            "12345678901234567890123/98765432109876543210",
+            "1.25",
+            "-.5",
+            "5.",
+            "1e-3",
+            "1.5E3",
+            "000123",
+        ],
+    )
+    def test_given_valid_string_returns_fraction(self, x: str) -> None:
+        result = fastnumbers.try_fraction(x)
+        assert isinstance(result, Fraction)
+        assert result == Fraction(x)
+        assert fastnumbers.try_fraction(pad(x)) == Fraction(x)
+
+    def test_given_mixed_number_string_returns_fraction(self) -> None:
+        assert fastnumbers.try_fraction("1 1/2") == Fraction(3, 2)
+        assert fastnumbers.try_fraction("-2 3/4") == Fraction(-11, 4)
+
+    @given(integers(), integers(1))
+    def test_given_fraction_string_returns_fraction(
+        self, numerator: int, denominator: int
+    ) -> None:
+        x = str(Fraction(numerator, denominator))
+        assert fastnumbers.try_fraction(x) == Fraction(x)
+
+    @given(floats(allow_nan=False, allow_infinity=False))
+    def test_given_float_repr_returns_fraction(self, x: float) -> None:
+        assert fastnumbers.try_fraction(repr(x)) == Fraction(repr(x))
+        assert fastnumbers.try_fraction(x) == Fraction(x)
+
+    @parametrize("x", ["", "inf", "nan", "1/2/3", "3 / 4", "1.5/2", "1e", "0x10"])
+    def test_given_invalid_string_fails(self, x: str) -> None:
+        with pytest.raises(ValueError):
+            Fraction(x)
+        assert fastnumbers.try_fraction(x) == x
+        with pytest.raises(ValueError, match="Invalid literal for Fraction"):
+            fastnumbers.try_fraction(x, on_fail=fastnumbers.RAISE)
+
+    def test_given_zero_denominator_raises_zero_division_error(self) -> None:
+        assert fastnumbers.try_fraction("1/0") == "1/0"
+        with pytest.raises(ZeroDivisionError):
+            fastnumbers.try_fraction("1/0", on_fail=fastnumbers.RAISE)
+
+    @parametrize("x", [5, 0.5, True, decimal.Decimal("1.1"), Fraction(1, 3)])
+    def test_given_number_returns_fraction(self, x: Any) -> None:
+        assert fastnumbers.try_fraction(x) == Fraction(x)
+
+    def test_given_nan_number_fails(self) -> None:
+        assert fastnumbers.try_fraction(float("nan"), on_fail=None) is None
+        with pytest.raises(ValueError):
+            fastnumbers.try_fraction(float("nan"), on_fail=fastnumbers.RAISE)
+
+    def test_given_invalid_type_raises_type_error(self) -> None:
+        msg = "argument should be a string or a Rational instance"
+        with pytest.raises(TypeError, match=msg):
+            fastnumbers.try_fraction([5])
+        assert fastnumbers.try_fraction(1j, on_type_error=None) is None
+
+    def test_given_unicode_digit_returns_fraction(self) -> None:
+        assert fastnumbers.try_fraction("\u0663") == Fraction(3)
+        assert fastnumbers.try_fraction("\u00bd") == "\u00bd"
+
+    def test_underscores(self) -> None:
+        assert fastnumbers.try_fraction("1_0/3") == "1_0/3"
+        assert fastnumbers.try_fraction("1_0/3", allow_underscores=True) == Fraction(
+            10, 3
+        )
+        assert fastnumbers.try_fraction("1_0.5", allow_underscores=True) == Fraction(
+            21, 2
+        )
+
+    def test_map(self) -> None:
+        result = fastnumbers.try_fraction(["1/3", "0.5", "bad"], on_fail=len, map=list)
+        assert result == [Fraction(1, 3), Fraction(1, 2), 3]
+
+
+class TestTryDecimal:
+    """
+    Tests for the try_decimal function, which must match decimal.Decimal.
+    """
+
+    @parametrize(
+        "x",
+        [
+            "1.10",
+            "-0.0",
+            "-0",
+            "-000",
+            "+5",
+            "000123",
+            "-12345678901234567890123456789",
+            ".5",
+            "5.",
+            "1e-3",
+            "-1.50E+300",
+            "1e99999",
+        ],
+    )
+    def test_given_valid_string_returns_decimal(self, x: str) -> None:
+        result = fastnumbers.try_decimal(x)
+        assert isinstance(result, decimal.Decimal)
+        assert repr(result) == repr(decimal.Decimal(x))
+        assert repr(fastnumbers.try_decimal(pad(x))) == repr(decimal.Decimal(x))
+
+    @given(floats(allow_nan=False, allow_infinity=False))
+    def test_given_float_repr_returns_decimal(self, x: float) -> None:
+        assert fastnumbers.try_decimal(repr(x)) == decimal.Decimal(repr(x))
+        assert fastnumbers.try_decimal(x) == decimal.Decimal(x)
+
+    @given(integers())
+    def test_given_int_string_returns_decimal(self, x: int) -> None:
+        assert fastnumbers.try_decimal(str(x)) == decimal.Decimal(x)
+        assert fastnumbers.try_decimal(x) == decimal.Decimal(x)
+
+    @parametrize("x", ["", "1e", "1.5.2", "0x10", "1/2", "1 2", "12 USD"])
+    def test_given_invalid_string_fails(self, x: str) -> None:
+        assert fastnumbers.try_decimal(x) == x
+        msg = "could not convert string to Decimal"
+        with pytest.raises(ValueError, match=msg):
+            fastnumbers.try_decimal(x, on_fail=fastnumbers.RAISE)
+
+    @parametrize("x", ["inf", "-Infinity", "nan", "-NaN", float("-inf")])
+    def test_given_inf_or_nan_returns_decimal(self, x: Any) -> None:
+        result = fastnumbers.try_decimal(x)
+        expected = decimal.Decimal(x)
+        assert isinstance(result, decimal.Decimal)
+        assert result.is_infinite() == expected.is_infinite()
+        assert result.is_nan() == expected.is_nan()
+        assert result.is_signed() == expected.is_signed()
+
+    @parametrize("x", ["sNaN", "-snan", "SNAN"])
+    def test_given_signaling_nan_returns_decimal(self, x: str) -> None:
+        result = fastnumbers.try_decimal(x)
+        assert isinstance(result, decimal.Decimal)
+        assert repr(result) == repr(decimal.Decimal(x))
+        assert fastnumbers.try_decimal(x + "1") == x + "1"
+
+    def test_inf_and_nan_selectors(self) -> None:
+        assert fastnumbers.try_decimal("inf", inf=fastnumbers.INPUT) == "inf"
+        assert fastnumbers.try_decimal("nan", nan=None) is None
+        assert fastnumbers.try_decimal(float("nan"), nan=repr) == "nan"
+        assert fastnumbers.try_decimal("-inf", inf=len) == 4
+        with pytest.raises(ValueError):
+            fastnumbers.try_decimal("inf", inf=fastnumbers.RAISE)
+        with pytest.raises(ValueError):
+            fastnumbers.try_decimal(float("nan"), nan=fastnumbers.RAISE)
+
+    @parametrize("x", [5, True, 0.1, decimal.Decimal("1.10"), Fraction(1, 4)])
+    def test_given_number_returns_decimal(self, x: Any) -> None:
+        result = fastnumbers.try_decimal(x)
+        assert isinstance(result, decimal.Decimal)
+        assert result == decimal.Decimal(float(x) if isinstance(x, Fraction) else x)
+
+    def test_given_decimal_returns_same_object(self) -> None:
+        x = decimal.Decimal("1.10")
+        assert fastnumbers.try_decimal(x) is x
+
+    def test_given_invalid_type_raises_type_error(self) -> None:
+        with pytest.raises(TypeError, match="to Decimal is not supported"):
+            fastnumbers.try_decimal([5])
+        assert fastnumbers.try_decimal(1j, on_type_error=None) is None
+
+    def test_given_unicode_digit_returns_decimal(self) -> None:
+        assert fastnumbers.try_decimal("\u0663") == decimal.Decimal(3)
+        assert fastnumbers.try_decimal("\u00bd") == "\u00bd"
+
+    def test_underscores(self) -> None:
+        assert fastnumbers.try_decimal("1_000.5") == "1_000.5"
+        result = fastnumbers.try_decimal("1_000.5", allow_underscores=True)
+        assert result == decimal.Decimal("1000.5")
+
+    def test_number_format(self) -> None:
+        result = fastnumbers.try_decimal(
+            "(1.234,50)", decimal_point=",", thousands=".", accounting=True
+        )
+        assert repr(result) == repr(decimal.Decimal("-1234.50"))
+        assert fastnumbers.try_decimal("1.5k", suffixes="si") == 1500
+
+    def test_map(self) -> None:
+        result = fastnumbers.try_decimal(["1.10", "2", "bad"], on_fail=len, map=list)
+        assert result == [decimal.Decimal("1.10"), decimal.Decimal(2), 3]
+
+    def test_sign_of_special_decimal_is_kept_by_try_float(self) -> None:
+        assert fastnumbers.try_float(decimal.Decimal("-inf")) == float("-inf")
+        assert math.copysign(1, fastnumbers.try_float(decimal.Decimal("-nan"))) == -1
+
+
 class TestCheckingFunctions:
     """
     Test the successful execution of the "checking" functions, e.g.:
@@ -1862,6 +2548,25 @@ class TestQueryType:
 class TestMappingFunctions:
     """Ensure that mapping functions operate on iterables"""
 
+    class FloatStr(str):
+        def __float__(self) -> float:
+            return 9.0
+
+    @parametrize(
+        "first", ["1.5", b"1.5", 1.5, 2, "\u0663", bytearray(b"1.5"), FloatStr("1")]
+    )
+    @parametrize(
+        "func",
+        [fastnumbers.try_real, fastnumbers.try_float, fastnumbers.try_forceint],
+    )
+    def test_mapping_handles_types_differing_from_the_first(
+        self, first: Any, func: ConversionFuncs
+    ) -> None:
+        # The type of the first element is speculated on for later elements.
+        x = [first, "2", "\u0663", b"4", 5.5, 6, True, bytearray(b"7"), "x"]
+        x += [self.FloatStr("8"), memoryview(b"9"), "10", first]
+        assert func(x, map=list) == [func(y) for y in x]
+
     @given(lists(floats() | integers() | text(max_size=50), min_size=1, max_size=50))
     @parametrize(
         "nomapper, mapper",
@@ -2100,3 +2805,248 @@ class TestMappingFunctions:
         expected = [5]
         result = list(func(style([("Fëanor",)]), on_type_error=5))
         assert result == expected
+
+
+class TestInplace:
+    """Tests for replacing the elements of a list with map='inplace'"""
+
+    @parametrize(
+        "func",
+        [
+            fastnumbers.try_real,
+            fastnumbers.try_float,
+            fastnumbers.try_int,
+            fastnumbers.try_forceint,
+            fastnumbers.try_complex,
+            fastnumbers.try_fraction,
+            fastnumbers.try_decimal,
+        ],
+    )
+    def test_same_list_is_returned_with_converted_elements(
+        self, func: Callable[..., Any]
+    ) -> None:
+        given = ["1", "x", "3", 4, None]
+        expected = func(list(given), on_type_error=0, map=list)
+        result = func(given, on_type_error=0, map="inplace")
+        assert result is given
+        assert result == expected
+
+    def test_elements_are_released_as_converted(self) -> None:
+        class Number:
+            def __float__(self) -> float:
+                return 4.5
+
+        given: list[Any] = ["1", Number(), Number()]
+        refs = [weakref.ref(x) for x in given[1:]]
+        fastnumbers.try_float(given, map="inplace")
+        assert given == [1.0, 4.5, 4.5]
+        assert [ref() for ref in refs] == [None, None]
+
+    def test_elements_before_an_error_are_converted(self) -> None:
+        given = ["1", "2", "x", "4"]
+        with pytest.raises(ValueError, match="convert string to float: 'x'"):
+            fastnumbers.try_float(given, on_fail=fastnumbers.RAISE, map="inplace")
+        assert given == [1.0, 2.0, "x", "4"]
+
+    def test_list_changed_by_callable(self) -> None:
+        given = ["x", "2", "3"]
+
+        def shrink(value: Any) -> int:
+            given.clear()
+            return 0
+
+        with pytest.raises(IndexError):
+            fastnumbers.try_int(given, on_fail=shrink, map="inplace")
+
+    @parametrize("given", [("1", "2"), iter(["1", "2"]), "12"])
+    def test_input_must_be_a_list(self, given: Any) -> None:
+        with pytest.raises(TypeError, match="requires a list"):
+            fastnumbers.try_float(given, map="inplace")
+
+
+class TestLazy:
+    """Ensure that the lazy sequence converts only what is accessed"""
+
+    @parametrize(
+        "kind, func",
+        [
+            ("real", fastnumbers.try_real),
+            ("float", fastnumbers.try_float),
+            ("int", fastnumbers.try_int),
+            ("forceint", fastnumbers.try_forceint),
+            ("complex", fastnumbers.try_complex),
+            ("fraction", fastnumbers.try_fraction),
+            ("decimal", fastnumbers.try_decimal),
+        ],
+    )
+    def test_lazy_matches_mapping(self, kind: str, func: Callable[..., Any]) -> None:
+        x = ["1", "2.5", "x", 4, 5.5, "  6 "]
+        assert list(fastnumbers.lazy(x, kind)) == func(x, map=list)
+
+    def test_elements_are_converted_only_once_when_accessed(self) -> None:
+        seen: list[Any] = []
+
+        def on_fail(x: Any) -> int:
+            seen.append(x)
+            return -1
+
+        result = fastnumbers.lazy(["a", "2", "b", "c"], "int", on_fail=on_fail)
+        assert len(result) == 4
+        assert seen == []
+        assert result[2] == -1
+        assert result[-2] == -1
+        assert seen == ["b"]
+        assert result[1] == 2
+        assert repr(result) == (
+            "<fastnumbers lazy sequence of 4 elements, 2 converted>"
+        )
+        assert list(result) == [-1, 2, -1, -1]
+        assert seen == ["b", "a", "c"]
+
+    def test_slicing_returns_a_list(self) -> None:
+        result = fastnumbers.lazy([str(i) for i in range(10)], "int")
+        assert result[2:8:3] == [2, 5]
+        assert result[::-4] == [9, 5, 1]
+        assert result[20:] == []
+
+    def test_bad_indices_raise(self) -> None:
+        result = fastnumbers.lazy(["1", "2"], "float")
+        with pytest.raises(IndexError, match="out of range"):
+            result[2]
+        with pytest.raises(IndexError, match="out of range"):
+            result[-3]
+        with pytest.raises(TypeError, match="not str"):
+            result["0"]  # type: ignore [call-overload]
+
+    def test_errors_are_raised_on_access(self) -> None:
+        result = fastnumbers.lazy(["1", "x"], "float", on_fail=fastnumbers.RAISE)
+        assert result[0] == 1.0
+        with pytest.raises(ValueError, match="could not convert"):
+            result[1]
+
+    def test_any_iterable_is_accepted(self) -> None:
+        assert list(fastnumbers.lazy(iter(["1", "2"]), "int")) == [1, 2]
+        assert list(fastnumbers.lazy(range(3), "float")) == [0.0, 1.0, 2.0]
+        with pytest.raises(TypeError, match="requires an iterable"):
+            fastnumbers.lazy(5, "int")  # type: ignore [arg-type]
+
+    def test_input_that_changes_size_raises(self) -> None:
+        x = ["1", "2", "3"]
+        result = fastnumbers.lazy(x, "int")
+        del x[1:]
+        assert result[0] == 1
+        with pytest.raises(RuntimeError, match="changed size"):
+            result[2]
+
+    def test_buffer_export(self) -> None:
+        ints = memoryview(fastnumbers.lazy(["1", "-2", "3"], "int"))
+        assert ints.format == "q"
+        assert ints.readonly
+        assert ints.tolist() == [1, -2, 3]
+        floats = memoryview(fastnumbers.lazy(["1", "2.5"], "real"))
+        assert floats.format == "d"
+        assert floats.tolist() == [1.0, 2.5]
+        with pytest.raises(BufferError, match="element 1 was converted to 'x'"):
+            memoryview(fastnumbers.lazy(["1", "x"], "float"))
+        wide = memoryview(fastnumbers.lazy(["1", str(2**70)], "int"))
+        assert wide.format == "d"
+        assert wide.tolist() == [1.0, float(2**70)]
+        with pytest.raises(OverflowError):
+            memoryview(fastnumbers.lazy(["1", "1" * 400], "int"))
+
+    def test_is_a_sequence(self) -> None:
+        result = fastnumbers.lazy(["1", "2"], "int")
+        assert isinstance(result, collections.abc.Sequence)
+
+    @parametrize("map_", ["lazy", "converter"])
+    def test_reference_cycles_through_a_callable_are_collected(self, map_: str) -> None:
+        class Fallback:
+            owner: Any = None
+
+            def __call__(self, x: Any) -> Any:
+                return x
+
+        fallback = Fallback()
+        fallback.owner = fastnumbers.try_float(["x"], on_fail=fallback, map=map_)
+        ref = weakref.ref(fallback)
+        del fallback
+        gc.collect()
+        assert ref() is None
+
+    def test_invalid_arguments_raise(self) -> None:
+        with pytest.raises(ValueError, match="kind must be one of"):
+            fastnumbers.lazy(["1"], "str")
+        with pytest.raises(TypeError, match="'map'"):
+            fastnumbers.lazy(["1"], "int", map=list)
+        with pytest.raises(ValueError, match="values for 'on_fail'"):
+            fastnumbers.lazy(["1"], "float", on_fail=fastnumbers.ALLOWED)
+
+
+class TestConvertRecords:
+    """Tests for converting the fields of records with convert_records"""
+
+    def test_fields_are_converted_in_place(self) -> None:
+        records = [
+            {"id": "a", "price": "1.50", "qty": "3"},
+            {"price": "x", "qty": "4.0"},
+            {"id": "c"},
+        ]
+        spec = {"price": "float", "qty": "forceint", "id": "int"}
+        assert fastnumbers.convert_records(records, spec) is None
+        assert records == [
+            {"id": "a", "price": 1.5, "qty": 3},
+            {"price": "x", "qty": 4},
+            {"id": "c"},
+        ]
+
+    @parametrize(
+        "kind, func",
+        [
+            ("real", fastnumbers.try_real),
+            ("float", fastnumbers.try_float),
+            ("int", fastnumbers.try_int),
+            ("forceint", fastnumbers.try_forceint),
+            ("complex", fastnumbers.try_complex),
+            ("fraction", fastnumbers.try_fraction),
+            ("decimal", fastnumbers.try_decimal),
+        ],
+    )
+    def test_kinds_match_their_functions(
+        self, kind: str, func: Callable[..., Any]
+    ) -> None:
+        given = ["1", "2.5", "1e3", "x", "inf", 7, 2.5]
+        records = [{"v": x} for x in given]
+        fastnumbers.convert_records(records, {"v": kind}, on_fail=0)
+        assert [r["v"] for r in records] == func(given, on_fail=0, map=list)
+
+    def test_nested_records_are_converted_with_recurse(self) -> None:
+        records = [{"n": "1", "items": [{"n": "2", "meta": {"n": "3"}}], "x": "4"}]
+        fastnumbers.convert_records(records, {"n": "int"}, recurse=True)
+        assert records == [{"n": 1, "items": [{"n": 2, "meta": {"n": 3}}], "x": "4"}]
+        records = [{"n": "1", "items": [{"n": "2"}]}]
+        fastnumbers.convert_records(records, {"n": "int"})
+        assert records == [{"n": 1, "items": [{"n": "2"}]}]
+
+    def test_records_may_be_any_iterable(self) -> None:
+        records = [{"v": "1"}, {"v": "2"}]
+        fastnumbers.convert_records(iter(records), {"v": "int"})
+        assert records == [{"v": 1}, {"v": 2}]
+
+    def test_errors(self) -> None:
+        with pytest.raises(TypeError, match="records must be dicts, not 'list'"):
+            fastnumbers.convert_records([[{"v": "1"}]], {"v": "int"})
+        with pytest.raises(ValueError, match="kind must be one of"):
+            fastnumbers.convert_records([{"v": "1"}], {"v": "long"})
+        with pytest.raises(TypeError, match="unexpected keyword argument 'map'"):
+            fastnumbers.convert_records([{"v": "1"}], {"v": "int"}, map=list)
+        with pytest.raises(ValueError, match="invalid literal"):
+            fastnumbers.convert_records(
+                [{"v": "x"}], {"v": "int"}, on_fail=fastnumbers.RAISE
+            )
+
+    def test_deep_nesting_raises_recursion_error(self) -> None:
+        records: list[Any] = []
+        for _ in range(100000):
+            records = [records]
+        with pytest.raises(RecursionError):
+            fastnumbers.convert_records(records, {"v": "int"}, recurse=True)